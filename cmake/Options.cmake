@@ -14,4 +14,7 @@ endif()
 option(USAN "Enable gcc undefined sanitizer" OFF)
 if (USAN)
     set (CMAKE_CXX_FLAGS "-fsanitize=undefined")
-endif()
\ No newline at end of file
+endif()
+option(BENCHMARKS "Build benchmark executables" OFF)
+option(NOVELIST_PROFILING "Enable hot-path profiling in release builds" OFF)
+
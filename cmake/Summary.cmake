@@ -10,6 +10,8 @@ function(print_config_summary)
     print_status( "  Release CXX flags :   ${CMAKE_CXX_FLAGS_RELEASE} ${CMAKE_CXX_FLAGS}")
     print_status( "  Debug CXX flags   :   ${CMAKE_CXX_FLAGS_DEBUG} ${CMAKE_CXX_FLAGS}")
     print_status( "  Build type        :   ${CMAKE_BUILD_TYPE}")
+    print_status( "  Benchmarks        :   ${BENCHMARKS}")
+    print_status( "  Profiling         :   ${NOVELIST_PROFILING}")
     print_status( "")
     print_status( "Dependencies:")
     print_status( "  Qt5               :   ${Qt5_VERSION}")
@@ -0,0 +1,181 @@
+/**********************************************************
+ * @file   TextEditorBenchmark.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QCoreApplication>
+#include <QtGui/QKeyEvent>
+#include <QtGui/QTextBlock>
+#include <QtWidgets/QApplication>
+#include <document/SpellingInsight.h>
+#include "TextEditorBenchmark.h"
+
+namespace novelist {
+    namespace {
+        QStringList const s_words = {"lorem", "ipsum", "dolor", "sit", "amet", "teh", "consectetur", "adipiscing",
+                                     "elit", "sed", "do", "eiusmod", "tempor", "incididunt"};
+
+        /**
+         * Marks every occurrence of "teh" as a spelling mistake
+         */
+        class MisspellingInspector : public Inspector {
+        public:
+            InspectionBlockResult inspect(QString const& text, Language /*lang*/) const noexcept override
+            {
+                InspectionBlockResult result;
+                for (int pos = 0; (pos = text.indexOf("teh", pos)) != -1; pos += 3) {
+                    InspectionInsight insight;
+                    insight.m_factory = std::make_shared<AutoInsightFactory<SpellingInsight>>(
+                            "Possible spelling mistake found.", QStringList{"the", "ten"});
+                    insight.m_left = pos;
+                    insight.m_right = pos + 3;
+                    result.push_back(std::move(insight));
+                }
+                return result;
+            }
+        };
+
+        template<typename C>
+        double measure(C const& functor)
+        {
+            QElapsedTimer timer;
+            timer.start();
+            functor();
+            return timer.nsecsElapsed() / 1000.0;
+        }
+    }
+
+    double LatencySamples::percentile(double p) const noexcept
+    {
+        if (m_micros.empty())
+            return 0;
+
+        std::vector<double> sorted = m_micros;
+        std::sort(sorted.begin(), sorted.end());
+        auto idx = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+        return sorted[std::min(idx, sorted.size() - 1)];
+    }
+
+    double LatencySamples::mean() const noexcept
+    {
+        if (m_micros.empty())
+            return 0;
+        return std::accumulate(m_micros.begin(), m_micros.end(), 0.0) / m_micros.size();
+    }
+
+    TextEditorBenchmark::TextEditorBenchmark(TextEditorBenchmarkConfig config)
+            :m_config(std::move(config))
+    {
+        m_inspectors.push_back(std::make_unique<MisspellingInspector>());
+
+        // Same rules as the default editor settings
+        m_charReplacementRules.push_back({"\"", "\"", "“", "”"});
+        m_charReplacementRules.push_back({"'", "'", "‘", "’", R"(^.*“(.*?‸.*?)”.*$)", -1, Qt::AltModifier});
+        m_charReplacementRules.push_back({"(", ")", "(", ")"});
+        m_charReplacementRules.push_back({"[", "]", "[", "]"});
+        m_charReplacementRules.push_back({"-", "", "–", "", R"(^.*(-)‸.*$)", 1});
+        m_charReplacementRules.push_back({"-", "", "—", "", R"(^.*(–)‸.*$)", 1});
+        m_charReplacementRules.push_back({".", "", "…", "", R"(^.*(\.\.)‸.*$)", 1});
+
+        m_editor = std::make_unique<TextEditor>(Language::en_US);
+        m_editor->resize(800, 600);
+        m_editor->useInspectors(&m_inspectors);
+        m_editor->useCharReplacement(&m_charReplacementRules);
+        setupScene();
+        m_editor->show();
+        QCoreApplication::processEvents();
+    }
+
+    TextEditorBenchmark::~TextEditorBenchmark() noexcept
+    {
+        m_editor->useInspectors(nullptr);
+    }
+
+    void TextEditorBenchmark::run()
+    {
+        for (int i = 0; i < m_config.m_keystrokes && !m_config.m_script.isEmpty(); ++i)
+            replayKey(m_config.m_script[i % m_config.m_script.size()]);
+    }
+
+    void TextEditorBenchmark::report(std::ostream& stream) const
+    {
+        stream << "Scene: " << m_config.m_paragraphs << " paragraphs, " << m_config.m_wordsPerParagraph
+               << " words each, " << m_editor->insights()->rowCount() << " insights\n";
+        stream << std::left << std::setw(26) << "Phase" << std::right << std::setw(10) << "Samples"
+               << std::setw(12) << "Mean [us]" << std::setw(12) << "p50 [us]" << std::setw(12) << "p99 [us]" << '\n';
+        for (auto const* samples : {&m_keyPress, &m_matchingChars, &m_highlightBlock, &m_repaint, &m_events}) {
+            stream << std::left << std::setw(26) << samples->m_name.toStdString() << std::right
+                   << std::setw(10) << samples->m_micros.size() << std::fixed << std::setprecision(1)
+                   << std::setw(12) << samples->mean()
+                   << std::setw(12) << samples->percentile(0.5)
+                   << std::setw(12) << samples->percentile(0.99) << '\n';
+        }
+        stream << std::flush;
+    }
+
+    void TextEditorBenchmark::setupScene()
+    {
+        QStringList paragraphs;
+        paragraphs.reserve(m_config.m_paragraphs);
+        for (int p = 0; p < m_config.m_paragraphs; ++p) {
+            QStringList words;
+            for (int w = 0; w < m_config.m_wordsPerParagraph; ++w)
+                words.push_back(s_words[(p * 7 + w * 3) % s_words.size()]);
+            paragraphs.push_back(words.join(' '));
+        }
+
+        auto* doc = new SceneDocument(paragraphs.join('\n'), Language::en_US, m_editor.get());
+        m_editor->setDocument(doc);
+
+        AutoInsightFactory<SpellingInsight> factory("Possible spelling mistake found.", QStringList{"foo", "bar"});
+        for (auto block = doc->begin(); block != doc->end(); block = block.next()) {
+            int left = 0;
+            for (int i = 0; i < m_config.m_insightsPerParagraph; ++i) {
+                int right = block.text().indexOf(' ', left);
+                if (right < 0)
+                    break;
+                m_editor->insights()->insert(factory.create(doc, block.position() + left, block.position() + right));
+                left = right + 1;
+            }
+        }
+
+        // Start typing in the middle of the scene
+        QTextCursor cursor(doc->findBlockByNumber(m_config.m_paragraphs / 2));
+        cursor.movePosition(QTextCursor::EndOfBlock);
+        m_editor->setTextCursor(cursor);
+        m_editor->ensureCursorVisible();
+    }
+
+    void TextEditorBenchmark::replayKey(QChar c)
+    {
+        int const key = c == '\n' ? Qt::Key_Return : c.toUpper().unicode();
+        QString const text = c == '\n' ? QString("\r") : QString(c);
+        QKeyEvent press(QEvent::KeyPress, key, Qt::NoModifier, text);
+        QKeyEvent release(QEvent::KeyRelease, key, Qt::NoModifier, text);
+
+        m_keyPress.m_micros.push_back(measure([this, &press] { QApplication::sendEvent(m_editor.get(), &press); }));
+        QApplication::sendEvent(m_editor.get(), &release);
+
+        m_matchingChars.m_micros.push_back(measure([this] {
+            QMetaObject::invokeMethod(m_editor.get(), "highlightMatchingChars", Qt::DirectConnection);
+        }));
+
+        auto* highlighter = m_editor->document()->findChild<SceneDocumentInsightManager*>();
+        if (highlighter) {
+            auto block = m_editor->textCursor().block();
+            m_highlightBlock.m_micros.push_back(measure([highlighter, &block] {
+                highlighter->rehighlightBlock(block);
+            }));
+        }
+
+        m_repaint.m_micros.push_back(measure([this] { m_editor->viewport()->repaint(); }));
+        m_events.m_micros.push_back(measure([] { QCoreApplication::processEvents(); }));
+    }
+}
@@ -0,0 +1,87 @@
+/**********************************************************
+ * @file   TextEditorBenchmark.h
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#ifndef NOVELIST_TEXTEDITORBENCHMARK_H
+#define NOVELIST_TEXTEDITORBENCHMARK_H
+
+#include <ostream>
+#include <vector>
+#include <memory>
+#include <QtCore/QString>
+#include <widgets/texteditor/TextEditor.h>
+
+namespace novelist {
+    /**
+     * Parameters of a typing latency benchmark run
+     */
+    struct TextEditorBenchmarkConfig {
+        int m_paragraphs = 2000; //!< Amount of paragraphs in the generated scene
+        int m_wordsPerParagraph = 80; //!< Amount of words per generated paragraph
+        int m_insightsPerParagraph = 2; //!< Amount of insights initially placed on each paragraph
+        int m_keystrokes = 1000; //!< Amount of keystrokes to replay
+        QString m_script = R"(Then she said "hello (and goodbye)" -- and left... )"; //!< Replayed in a loop
+    };
+
+    /**
+     * Latency samples of a single phase of keystroke processing
+     */
+    struct LatencySamples {
+        QString m_name; //!< Phase name
+        std::vector<double> m_micros; //!< Samples in microseconds
+
+        /**
+         * @param p Percentile in [0, 1]
+         * @return Sample at the requested percentile or 0 if there are no samples
+         */
+        double percentile(double p) const noexcept;
+
+        /**
+         * @return Arithmetic mean of all samples or 0 if there are no samples
+         */
+        double mean() const noexcept;
+    };
+
+    /**
+     * Headless benchmark that replays scripted keystrokes on a TextEditor with inspectors, character replacement rules
+     * and insights enabled, and measures how long the individual processing phases take.
+     */
+    class TextEditorBenchmark {
+    public:
+        explicit TextEditorBenchmark(TextEditorBenchmarkConfig config);
+
+        ~TextEditorBenchmark() noexcept;
+
+        /**
+         * Replays the configured keystrokes and collects latency samples
+         */
+        void run();
+
+        /**
+         * Print p50/p99 latencies of all phases
+         * @param stream Stream to write to
+         */
+        void report(std::ostream& stream) const;
+
+    private:
+        TextEditorBenchmarkConfig m_config;
+        std::vector<std::unique_ptr<Inspector>> m_inspectors;
+        std::vector<CharacterReplacementRule> m_charReplacementRules;
+        std::unique_ptr<TextEditor> m_editor;
+        LatencySamples m_keyPress{"keyPressEvent"};
+        LatencySamples m_matchingChars{"highlightMatchingChars"};
+        LatencySamples m_highlightBlock{"highlightBlock"};
+        LatencySamples m_repaint{"repaint"};
+        LatencySamples m_events{"event processing"};
+
+        void setupScene();
+
+        void replayKey(QChar c);
+    };
+}
+
+#endif //NOVELIST_TEXTEDITORBENCHMARK_H
@@ -0,0 +1,52 @@
+/**********************************************************
+ * @file   main.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+
+#include <iostream>
+#include <QtCore/QCommandLineParser>
+#include <test/TestApplication.h>
+#include "TextEditorBenchmark.h"
+
+using namespace novelist;
+
+int main(int argc, char** argv)
+{
+    // Run headless unless explicitly told otherwise
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    TestApplication app(argc, argv);
+
+    TextEditorBenchmarkConfig config;
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measures keystroke latency of the scene text editor.");
+    parser.addHelpOption();
+    QCommandLineOption paragraphsOption("paragraphs", "Amount of paragraphs in the scene.", "count",
+            QString::number(config.m_paragraphs));
+    QCommandLineOption wordsOption("words", "Amount of words per paragraph.", "count",
+            QString::number(config.m_wordsPerParagraph));
+    QCommandLineOption insightsOption("insights", "Amount of insights per paragraph.", "count",
+            QString::number(config.m_insightsPerParagraph));
+    QCommandLineOption keystrokesOption("keystrokes", "Amount of keystrokes to replay.", "count",
+            QString::number(config.m_keystrokes));
+    QCommandLineOption scriptOption("script", "Text to type, replayed in a loop.", "text", config.m_script);
+    parser.addOptions({paragraphsOption, wordsOption, insightsOption, keystrokesOption, scriptOption});
+    parser.process(app);
+
+    config.m_paragraphs = parser.value(paragraphsOption).toInt();
+    config.m_wordsPerParagraph = parser.value(wordsOption).toInt();
+    config.m_insightsPerParagraph = parser.value(insightsOption).toInt();
+    config.m_keystrokes = parser.value(keystrokesOption).toInt();
+    config.m_script = parser.value(scriptOption);
+
+    TextEditorBenchmark benchmark(config);
+    benchmark.run();
+    benchmark.report(std::cout);
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+/**********************************************************
+ * @file   Dawg.h
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#ifndef NOVELIST_DAWG_H
+#define NOVELIST_DAWG_H
+
+#include <optional>
+#include <utility>
+#include <vector>
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <novelist_core_export.h>
+
+namespace novelist {
+
+    /**
+     * Minimized directed acyclic word graph, i.e. a trie whose common suffixes are shared as well as its common
+     * prefixes. Large word lists shrink to a fraction of their plain size, lookup takes time linear in the length of
+     * the word, and the whole graph is a single flat block of memory that can be written to disk and memory-mapped
+     * again without any parsing.
+     */
+    class NOVELIST_CORE_EXPORT Dawg {
+    public:
+        /**
+         * Constructs an empty graph
+         */
+        Dawg();
+
+        /**
+         * Builds a minimized graph from a list of words
+         * @param words Words to add, in any order and possibly with duplicates. Empty words are ignored.
+         * @return The graph
+         */
+        static Dawg build(std::vector<QString> words);
+
+        /**
+         * Wraps serialized graph data. The data is validated but not copied, so it may be backed by a memory-mapped
+         * file via QByteArray::fromRawData(), in which case the mapping must outlive the graph.
+         * @param data Data as returned by data()
+         * @return The graph, or nothing if the data is invalid
+         */
+        static std::optional<Dawg> fromData(QByteArray data);
+
+        /**
+         * @return Serialized graph
+         */
+        QByteArray const& data() const noexcept;
+
+        /**
+         * @param word Word to check
+         * @return true if the word is part of the graph, otherwise false
+         */
+        bool contains(QString const& word) const noexcept;
+
+        /**
+         * Finds the words closest to a word. Distance is the amount of inserted, removed, replaced or swapped
+         * adjacent characters. Only the parts of the graph within the maximum distance are visited.
+         * @param word Word to find neighbours of
+         * @param maxDistance Maximum distance
+         * @param maxCount Maximum amount of results
+         * @return Words and their distance, closest first
+         */
+        std::vector<std::pair<QString, int>> suggest(QString const& word, int maxDistance, size_t maxCount) const;
+
+        /**
+         * @return Amount of words
+         */
+        size_t wordCount() const noexcept;
+
+        /**
+         * @return Amount of edges
+         */
+        size_t edgeCount() const noexcept;
+
+    private:
+        class Builder;
+        class Search;
+
+        /**
+         * All edges leaving a node are stored next to each other, sorted by label. The last of them is flagged.
+         */
+        struct Edge {
+            quint32 m_target; // Index of the first edge of the target node, or s_noEdges
+            quint16 m_label;
+            quint16 m_flags;
+        };
+
+        struct Header {
+            quint32 m_magic;
+            quint32 m_version;
+            quint32 m_wordCount;
+            quint32 m_edgeCount;
+            quint32 m_root;
+            quint32 m_reserved;
+        };
+
+        static constexpr quint32 s_noEdges = 0xFFFFFFFF;
+        static constexpr quint16 s_finalFlag = 1; // Edge ends a word
+        static constexpr quint16 s_lastFlag = 2; // Last edge of its node
+
+        QByteArray m_data;
+
+        explicit Dawg(QByteArray data) noexcept;
+
+        Header const& header() const noexcept;
+
+        Edge const* edges() const noexcept;
+
+        Edge const* findEdge(quint32 node, QChar c) const noexcept;
+    };
+}
+
+#endif //NOVELIST_DAWG_H
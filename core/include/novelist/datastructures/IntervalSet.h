@@ -0,0 +1,204 @@
+/**********************************************************
+ * @file   IntervalSet.h
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#ifndef NOVELIST_INTERVALSET_H
+#define NOVELIST_INTERVALSET_H
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <type_traits>
+#include <vector>
+
+namespace novelist {
+
+    /**
+     * A set of integral values, stored as disjoint half-open intervals. Consecutive values take up constant space, so
+     * this is well suited to track e.g. ranges of paragraph numbers.
+     * @tparam T Integral value type
+     */
+    template<typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+    class IntervalSet {
+    public:
+        using value_type = T;
+        using const_iterator = typename std::map<T, T>::const_iterator;
+
+        /**
+         * Add all values in [first, last)
+         * @param first First value
+         * @param last One past the last value
+         */
+        void insert(T first, T last)
+        {
+            if (first >= last)
+                return;
+
+            // Merge with all intervals that overlap or touch the new one
+            auto iter = m_intervals.upper_bound(first);
+            if (iter != m_intervals.begin() && std::prev(iter)->second >= first)
+                --iter;
+            while (iter != m_intervals.end() && iter->first <= last) {
+                first = std::min(first, iter->first);
+                last = std::max(last, iter->second);
+                m_size -= iter->second - iter->first;
+                iter = m_intervals.erase(iter);
+            }
+            m_intervals.emplace_hint(iter, first, last);
+            m_size += last - first;
+        }
+
+        /**
+         * Add a single value
+         * @param value Value to add
+         */
+        void insert(T value)
+        {
+            insert(value, value + 1);
+        }
+
+        /**
+         * Remove all values in [first, last)
+         * @param first First value
+         * @param last One past the last value
+         */
+        void erase(T first, T last)
+        {
+            if (first >= last)
+                return;
+
+            auto iter = m_intervals.upper_bound(first);
+            if (iter != m_intervals.begin() && std::prev(iter)->second > first)
+                --iter;
+            while (iter != m_intervals.end() && iter->first < last) {
+                T const l = iter->first;
+                T const r = iter->second;
+                m_size -= r - l;
+                iter = m_intervals.erase(iter);
+                if (l < first) {
+                    m_intervals.emplace_hint(iter, l, first);
+                    m_size += first - l;
+                }
+                if (r > last) {
+                    iter = m_intervals.emplace_hint(iter, last, r);
+                    m_size += r - last;
+                    break;
+                }
+            }
+        }
+
+        /**
+         * Remove a single value
+         * @param value Value to remove
+         */
+        void erase(T value)
+        {
+            erase(value, value + 1);
+        }
+
+        /**
+         * Moves values to account for values inserted or removed at some position. A positive \p delta opens a gap
+         * of that size at \p pos. A negative \p delta removes all values in [pos, pos - delta) and closes the gap.
+         * @param pos Position of the change
+         * @param delta Amount of inserted (positive) or removed (negative) values
+         */
+        void shift(T pos, T delta)
+        {
+            if (delta == 0)
+                return;
+            if (delta < 0)
+                erase(pos, pos - delta);
+
+            // Split the interval containing pos, then move everything behind it
+            auto iter = m_intervals.lower_bound(pos);
+            if (iter != m_intervals.begin() && std::prev(iter)->second > pos) {
+                auto prev = std::prev(iter);
+                T const r = prev->second;
+                prev->second = pos;
+                iter = m_intervals.emplace_hint(iter, pos, r);
+            }
+            std::vector<std::pair<T, T>> moved(iter, m_intervals.end());
+            m_intervals.erase(iter, m_intervals.end());
+            for (auto const& [l, r] : moved)
+                m_intervals.emplace_hint(m_intervals.end(), l + delta, r + delta);
+
+            // Removal can make intervals touch
+            if (delta < 0) {
+                auto hit = m_intervals.find(pos);
+                if (hit != m_intervals.end() && hit != m_intervals.begin() && std::prev(hit)->second == pos) {
+                    std::prev(hit)->second = hit->second;
+                    m_intervals.erase(hit);
+                }
+            }
+        }
+
+        /**
+         * @param value Value to check
+         * @return true if \p value is part of the set, otherwise false
+         */
+        bool contains(T value) const
+        {
+            auto iter = m_intervals.upper_bound(value);
+            return iter != m_intervals.begin() && std::prev(iter)->second > value;
+        }
+
+        /**
+         * Remove all values
+         */
+        void clear() noexcept
+        {
+            m_intervals.clear();
+            m_size = 0;
+        }
+
+        /**
+         * @return Amount of values in the set
+         */
+        size_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        /**
+         * @return true if the set contains no values, otherwise false
+         */
+        bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        /**
+         * @return Amount of disjoint intervals
+         */
+        size_t intervalCount() const noexcept
+        {
+            return m_intervals.size();
+        }
+
+        /**
+         * @return Iterator to the first interval. Intervals are pairs of first value and one past the last value.
+         */
+        const_iterator begin() const noexcept
+        {
+            return m_intervals.begin();
+        }
+
+        /**
+         * @return Iterator past the last interval
+         */
+        const_iterator end() const noexcept
+        {
+            return m_intervals.end();
+        }
+
+    private:
+        std::map<T, T> m_intervals; // First value -> one past the last value
+        size_t m_size = 0;
+    };
+}
+
+#endif //NOVELIST_INTERVALSET_H
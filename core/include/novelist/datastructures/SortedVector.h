@@ -9,6 +9,7 @@
 #ifndef NOVELIST_SORTEDVECTOR_H
 #define NOVELIST_SORTEDVECTOR_H
 
+#include <algorithm>
 #include <functional>
 
 namespace novelist {
@@ -374,6 +375,28 @@ namespace novelist {
             insert(iList.begin(), iList.end());
         }
 
+        /**
+         * Insert many elements at once. The new elements are sorted and merged with the existing ones in a single
+         * pass, which is a lot cheaper than inserting them one by one. New elements are placed behind existing ones
+         * that compare equal.
+         * @tparam InputIt Input iterator type
+         * @param first First element
+         * @param last Last element
+         */
+        template<
+                typename InputIt,
+                typename = std::enable_if<std::is_base_of_v<
+                        typename std::iterator_traits<InputIt>::iterator_category, std::input_iterator_tag>>>
+        void merge(InputIt first, InputIt last)
+        {
+            auto const oldSize = size();
+            vector_t::insert(vector_t::end(), first, last);
+            auto middle = vector_t::begin() + oldSize;
+            Pred comp;
+            std::stable_sort(middle, vector_t::end(), comp);
+            std::inplace_merge(vector_t::begin(), middle, vector_t::end(), comp);
+        }
+
         /**
          * Modify a range of elements. If the sort criterion is affected, the class invariant is restored automatically.
          * @tparam C Function type
@@ -0,0 +1,49 @@
+/**********************************************************
+ * @file   StringPool.h
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#ifndef NOVELIST_STRINGPOOL_H
+#define NOVELIST_STRINGPOOL_H
+
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <novelist_core_export.h>
+
+namespace novelist {
+
+    /**
+     * Interns strings, so that equal strings share their data. QString is implicitly shared, so an interned string
+     * costs no more than a pointer for every additional user. Strings that aren't used anywhere else anymore are
+     * dropped from the pool automatically every now and then.
+     */
+    class NOVELIST_CORE_EXPORT StringPool {
+    public:
+        /**
+         * @param str Some string
+         * @return A string equal to \p str that shares its data with all other equal strings from this pool
+         */
+        QString intern(QString const& str);
+
+        /**
+         * Drops all strings that are only referenced by the pool itself
+         */
+        void prune();
+
+        /**
+         * @return Amount of distinct strings in the pool
+         */
+        size_t size() const noexcept;
+
+    private:
+        QSet<QString> m_strings;
+        int m_pruneThreshold = s_minPruneThreshold;
+
+        static constexpr int s_minPruneThreshold = 64;
+    };
+}
+
+#endif //NOVELIST_STRINGPOOL_H
@@ -9,16 +9,26 @@
 #ifndef NOVELIST_AUTOINSIGHT_H
 #define NOVELIST_AUTOINSIGHT_H
 
+#include <functional>
+#include <memory>
 #include "BaseInsight.h"
 
 namespace novelist {
     /**
      * Common base class for insights that are not user-generated, but rather by tools such as spellcheckers
+     * @details There can be thousands of these at a time, but only a few of them are ever looked at. Therefore the
+     *          suggestion menu is only built once it is first requested, and so is the message if it was passed as a
+     *          MessageBuilder.
      */
     class NOVELIST_CORE_EXPORT AutoInsight : public BaseInsight {
     Q_OBJECT
 
     public:
+        /**
+         * Produces the message of an insight when it is first requested
+         */
+        using MessageBuilder = std::function<QString()>;
+
         /**
          * Construct insight on a document
          * @param doc Document
@@ -30,6 +40,19 @@ namespace novelist {
         AutoInsight(gsl::not_null<SceneDocument*> doc, int left, int right, QString msg,
                 QStringList suggestions = QStringList());
 
+        /**
+         * Construct insight on a document with a message that is built on first use
+         * @param doc Document
+         * @param left Left position
+         * @param right Right position
+         * @param msgBuilder Builds the message
+         * @param suggestions A (possibly empty) list of suggestions to present to the user
+         */
+        AutoInsight(gsl::not_null<SceneDocument*> doc, int left, int right, MessageBuilder msgBuilder,
+                QStringList suggestions = QStringList());
+
+        QString const& message() const noexcept override;
+
         bool isPersistent() const noexcept override;
 
         QMenu const& menu() const noexcept override;
@@ -37,8 +60,11 @@ namespace novelist {
         void retranslate() noexcept override;
 
     private:
-        QMenu m_menu;
+        mutable std::unique_ptr<QMenu> m_menu;
+        mutable MessageBuilder m_msgBuilder;
         QStringList m_suggestions;
+
+        std::unique_ptr<QMenu> createMenu();
     };
 }
 
@@ -12,6 +12,7 @@
 #include <QtGui/QTextCursor>
 #include <gsl/gsl>
 #include "Insight.h"
+#include "PositionTracker.h"
 #include "InsightFactory.h"
 #include "SceneDocument.h"
 #include <novelist_core_export.h>
@@ -20,12 +21,16 @@ namespace novelist {
 
     /**
      * Implements some common functionality for insight specializations
+     * @details Documents can carry tens of thousands of insights, so they are kept lean: The range is tracked by the
+     *          document's insight manager, and message and category are interned in the document's string pool.
      */
     class NOVELIST_CORE_EXPORT BaseInsight : public QObject, public Insight {
     Q_OBJECT
     Q_INTERFACES(novelist::Insight)
 
     public:
+        ~BaseInsight() noexcept override;
+
         /**
          * @return Underlying document
          */
@@ -63,7 +68,9 @@ namespace novelist {
         void postRemoveEvent() noexcept;
 
     private:
-        QTextCursor m_cursor;
+        SceneDocument* m_document;
+        PositionTracker* m_positions;
+        PositionTracker::Handle m_handle = 0;
         QString m_message;
         QString m_category;
 
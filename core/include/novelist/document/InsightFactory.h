@@ -9,16 +9,40 @@
 #ifndef NOVELIST_INSIGHTFACTORY_H
 #define NOVELIST_INSIGHTFACTORY_H
 
+#include <functional>
 #include <memory>
 #include <type_traits>
+#include <vector>
 #include <gsl/gsl>
+#include <QtCore/QStringList>
 #include "Insight.h"
+#include <novelist_core_export.h>
 
 namespace novelist {
     class BaseInsight;
     class AutoInsight;
     class SceneDocument;
 
+    /**
+     * @param left Left position
+     * @param right Right position
+     * @param textLength Length of the document text
+     * @return true if an insight may be created on [\p left, \p right] of a document with \p textLength characters
+     */
+    inline bool isValidInsightRange(int left, int right, int textLength) noexcept
+    {
+        return left >= 0 && right >= 0 && left <= textLength && right <= textLength;
+    }
+
+    /**
+     * Plain description of the insights a factory produces, used to persist inspection results
+     */
+    struct InsightFactoryDescription {
+        QString m_type; //!< Class name of the produced insights, empty if the factory can't be described
+        QString m_message; //!< Insight message
+        QStringList m_suggestions; //!< Suggestions, if any
+    };
+
     /**
      * Produces an insight
      */
@@ -26,6 +50,27 @@ namespace novelist {
     public:
         virtual ~InsightFactory() noexcept = default;
 
+        /**
+         * @return Description of this factory. The default description has an empty type, i.e. it can't be restored.
+         */
+        virtual InsightFactoryDescription describe() const noexcept
+        {
+            return {};
+        }
+
+        /**
+         * @return Rough estimate in bytes of the memory held by this factory. The default implementation measures
+         *         the description.
+         */
+        virtual size_t memoryUsage() const noexcept
+        {
+            auto const description = describe();
+            size_t size = 64 + description.m_message.size() * sizeof(QChar);
+            for (auto const& s : description.m_suggestions)
+                size += sizeof(QString) + s.size() * sizeof(QChar);
+            return size;
+        }
+
         /**
          * Create an insight on the specified document
          * @param doc Document to create insight for
@@ -36,6 +81,34 @@ namespace novelist {
         virtual std::unique_ptr<Insight> create(gsl::not_null<SceneDocument*> doc, int left, int right) noexcept = 0;
     };
 
+    /**
+     * Describes a single insight of a batch
+     */
+    struct InsightBatchEntry {
+        InsightFactory* m_factory; //!< Factory to create the insight with
+        int m_left; //!< Left position
+        int m_right; //!< Right position
+    };
+
+    /**
+     * Create many insights on the same document at once. All ranges are validated against a single snapshot of the
+     * document length, and entries with invalid ranges are skipped up front.
+     * @param doc Document to create insights for
+     * @param batch Insights to create
+     * @return All insights that could be created, in order of \p batch
+     */
+    NOVELIST_CORE_EXPORT std::vector<std::unique_ptr<Insight>> createInsights(gsl::not_null<SceneDocument*> doc,
+            std::vector<InsightBatchEntry> const& batch) noexcept;
+
+    /**
+     * Restores a factory from its description. Only the insight types produced by inspectors are supported, i.e.
+     * spelling, grammar and typography insights.
+     * @param description Factory description
+     * @return The factory or nullptr if the described type is unknown
+     */
+    NOVELIST_CORE_EXPORT std::shared_ptr<InsightFactory> makeInsightFactory(
+            InsightFactoryDescription const& description) noexcept;
+
     /**
      * A general insight factory for all insight types that are fully described by a message.
      * @tparam T Insight type
@@ -51,6 +124,11 @@ namespace novelist {
             return doCreate(doc, left, right, m_msg);
         }
 
+        InsightFactoryDescription describe() const noexcept override
+        {
+            return {T::staticMetaObject.className(), m_msg, {}};
+        }
+
     protected:
         template <typename... Ts>
         std::unique_ptr<Insight> doCreate(Ts... vars) noexcept {
@@ -77,16 +155,54 @@ namespace novelist {
     template<typename T, typename = std::enable_if<std::is_convertible_v<T*, AutoInsight*>>>
     class AutoInsightFactory : public BaseInsightFactory<T> {
     public:
+        /**
+         * Produces the message of an insight when it is first requested
+         */
+        using MessageBuilder = std::function<QString()>;
+
         explicit AutoInsightFactory(QString msg, QStringList suggestions)
                 :BaseInsightFactory<T>(std::move(msg)),
                 m_suggestions(std::move(suggestions)) { }
 
+        /**
+         * The message is only built once it is requested from a created insight or from describe()
+         * @param msgBuilder Builds the message
+         * @param suggestions A (possibly empty) list of suggestions
+         */
+        explicit AutoInsightFactory(MessageBuilder msgBuilder, QStringList suggestions)
+                :BaseInsightFactory<T>(QString()),
+                m_msgBuilder(std::move(msgBuilder)),
+                m_suggestions(std::move(suggestions)) { }
+
         std::unique_ptr<Insight> create(gsl::not_null<SceneDocument*> doc, int left, int right) noexcept override
         {
+            if (m_msgBuilder)
+                return BaseInsightFactory<T>::doCreate(doc, left, right, m_msgBuilder, m_suggestions);
             return BaseInsightFactory<T>::doCreate(doc, left, right, BaseInsightFactory<T>::message(), m_suggestions);
         }
 
+        InsightFactoryDescription describe() const noexcept override
+        {
+            return {T::staticMetaObject.className(), m_msgBuilder ? m_msgBuilder() : BaseInsightFactory<T>::message(),
+                    m_suggestions};
+        }
+
+        size_t memoryUsage() const noexcept override
+        {
+            if (!m_msgBuilder)
+                return InsightFactory::memoryUsage();
+
+            // Measuring the message would mean to build it
+            size_t size = 64 + sizeof(MessageBuilder) + s_builtMessageEstimate * sizeof(QChar);
+            for (auto const& s : m_suggestions)
+                size += sizeof(QString) + s.size() * sizeof(QChar);
+            return size;
+        }
+
     private:
+        static constexpr size_t s_builtMessageEstimate = 128;
+
+        MessageBuilder m_msgBuilder;
         QStringList m_suggestions;
     };
 }
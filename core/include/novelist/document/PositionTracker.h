@@ -0,0 +1,76 @@
+/**********************************************************
+ * @file   PositionTracker.h
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#ifndef NOVELIST_POSITIONTRACKER_H
+#define NOVELIST_POSITIONTRACKER_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <novelist_core_export.h>
+
+namespace novelist {
+
+    /**
+     * Keeps track of many ranges on a document while it is edited, the way QTextCursors with a selection would.
+     * Unlike cursors, ranges don't need to be registered with the document one by one; they are stored in a single
+     * flat array and updated in one pass per change.
+     */
+    class NOVELIST_CORE_EXPORT PositionTracker {
+    public:
+        using Handle = uint32_t;
+
+        /**
+         * Start tracking a range
+         * @param left Left position
+         * @param right Right position, not smaller than \p left
+         * @return Handle to the range
+         */
+        Handle add(int left, int right);
+
+        /**
+         * Moves a range
+         * @param handle Handle to the range
+         * @param left New left position
+         * @param right New right position, not smaller than \p left
+         */
+        void setRange(Handle handle, int left, int right) noexcept;
+
+        /**
+         * Stop tracking a range. The handle may be reused afterwards.
+         * @param handle Handle to the range
+         */
+        void remove(Handle handle) noexcept;
+
+        /**
+         * @param handle Handle to a range
+         * @return The current range
+         */
+        std::pair<int, int> range(Handle handle) const noexcept;
+
+        /**
+         * Updates all ranges after a change of the document. Positions within replaced text move behind the inserted
+         * text, just like cursors do. Changes that only altered formatting must not be passed here.
+         * @param position Position of the change
+         * @param charsRemoved Amount of characters removed at \p position
+         * @param charsAdded Amount of characters inserted at \p position
+         */
+        void update(int position, int charsRemoved, int charsAdded) noexcept;
+
+        /**
+         * @return Amount of ranges tracked
+         */
+        size_t size() const noexcept;
+
+    private:
+        std::vector<std::pair<int, int>> m_ranges;
+        std::vector<Handle> m_free;
+    };
+}
+
+#endif //NOVELIST_POSITIONTRACKER_H
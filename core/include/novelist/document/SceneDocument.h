@@ -16,6 +16,7 @@
 #include <QXmlStreamWriter>
 #include <memory>
 #include "SceneDocumentInsightManager.h"
+#include "datastructures/StringPool.h"
 #include "model/Language.h"
 
 namespace novelist {
@@ -23,6 +24,7 @@ namespace novelist {
     class TextEditor;
     class InsightModel;
     class BaseInsight;
+    class InspectionCache;
 
     /**
      * Formatted text for scenes
@@ -84,6 +86,26 @@ namespace novelist {
          */
         void setLanguage(Language lang) noexcept;
 
+        /**
+         * @return Cache of inspection results for this document, might be nullptr
+         */
+        std::shared_ptr<InspectionCache> const& inspectionCache() const noexcept;
+
+        /**
+         * @param cache Cache of inspection results to use, or nullptr to disable caching
+         */
+        void setInspectionCache(std::shared_ptr<InspectionCache> cache) noexcept;
+
+        /**
+         * @return Pool to intern strings of this document's insights in
+         */
+        std::shared_ptr<StringPool> const& stringPool() const noexcept;
+
+        /**
+         * @param pool Pool to intern strings in. Documents of the same project should share their pool.
+         */
+        void setStringPool(std::shared_ptr<StringPool> pool) noexcept;
+
         /**
          * Compares two documents for content-equality
          * @details This only considers text. Formatting is not considered.
@@ -101,8 +123,10 @@ namespace novelist {
         bool operator!=(SceneDocument const& other) const;
 
     private:
+        std::shared_ptr<StringPool> m_stringPool = std::make_shared<StringPool>();
         SceneDocumentInsightManager m_insightMgr;
         Language m_lang;
+        std::shared_ptr<InspectionCache> m_inspectionCache;
 
         bool readInternal(QXmlStreamReader& xml);
 
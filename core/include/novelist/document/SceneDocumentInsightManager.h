@@ -10,10 +10,15 @@
 #define NOVELIST_SCENEDOCUMENTINSIGHTMANAGER_H
 
 #include <memory>
+#include <unordered_set>
+#include <vector>
 #include <QtCore/QEvent>
 #include <QtGui/QSyntaxHighlighter>
+#include <QtGui/QTextBlockUserData>
+#include "datastructures/IntervalSet.h"
 #include "datastructures/SortedVector.h"
 #include "Insight.h"
+#include "PositionTracker.h"
 #include <novelist_core_export.h>
 
 namespace novelist {
@@ -34,6 +39,24 @@ namespace novelist {
             Insight const* m_insight;
             static inline QEvent::Type const s_eventId = static_cast<QEvent::Type>(QEvent::registerEventType());
         };
+
+        /**
+         * Posted once to remove all insights that collapsed to zero length since the last removal
+         */
+        class RemoveCollapsedInsightsEvent : public QEvent {
+        public:
+            RemoveCollapsedInsightsEvent();
+            static inline QEvent::Type const s_eventId = static_cast<QEvent::Type>(QEvent::registerEventType());
+        };
+
+        /**
+         * Attached to every block of a managed document
+         */
+        class InsightBlockData : public QTextBlockUserData {
+        public:
+            uint m_textHash = 0; // Hash of the block's text as of the last change
+            bool m_deferred = false; // Highlighting was skipped because the block was outside of the visible area
+        };
     }
 
     /**
@@ -45,7 +68,21 @@ namespace novelist {
 
     public:
         using SVector = SortedVector<std::unique_ptr<Insight>, internal::InsightPtrOrderCompare>;
-        using QSyntaxHighlighter::QSyntaxHighlighter;
+
+        /**
+         * Default amount of blocks above which a document is considered large
+         */
+        static constexpr int s_defaultLargeDocumentThreshold = 5000;
+
+        /**
+         * Amount of blocks above and below the visible area that are still highlighted in large documents
+         */
+        static constexpr int s_visibleMargin = 100;
+
+        /**
+         * @param parent Document to highlight
+         */
+        explicit SceneDocumentInsightManager(QTextDocument* parent);
 
         /**
          * Insert a new insight
@@ -62,6 +99,24 @@ namespace novelist {
          */
         int insert(std::unique_ptr<Insight> insight, SVector::const_iterator hint);
 
+        /**
+         * Insert many insights at once. They are merged into the sorted store in a single pass and all blocks they
+         * touch are rehighlighted once.
+         * @param insights Insights to insert, in any order
+         */
+        void insert(std::vector<std::unique_ptr<Insight>> insights);
+
+        /**
+         * Starts a batch of modifications. Rehighlighting is postponed until the matching endBatch() and then done
+         * once for all blocks touched in between. Batches may be nested.
+         */
+        void beginBatch() noexcept;
+
+        /**
+         * Ends a batch of modifications started by beginBatch()
+         */
+        void endBatch();
+
         /**
          * @return Iterator to first element
          */
@@ -79,6 +134,24 @@ namespace novelist {
          */
         SVector::const_iterator erase(SVector::const_iterator iter) noexcept;
 
+        /**
+         * Erases a range of insights from this manager. The touched blocks are rehighlighted once.
+         * @param first First element to erase
+         * @param last Element after the last element to erase
+         * @return Iterator to the element after the erased range
+         */
+        SVector::const_iterator erase(SVector::const_iterator first, SVector::const_iterator last) noexcept;
+
+        /**
+         * Finds the insights that overlap a range of characters. Insights are sorted by their start, so this is a
+         * binary search for insights that start within the range, extended by the insights in front of it that reach
+         * into it. Insights in between that end before the range are part of the result as well.
+         * @param start First character of the range
+         * @param end One past the last character of the range
+         * @return Index range [first, last) of insights that might overlap [start, end)
+         */
+        std::pair<int, int> findOverlapping(int start, int end) const noexcept;
+
         /**
          * @return Amount of insights managed
          */
@@ -89,29 +162,96 @@ namespace novelist {
          */
         void clear() noexcept;
 
+        /**
+         * @return Ranges of all insights on the document. They are updated before anything else reacts to a change of
+         *         the document.
+         */
+        PositionTracker& positions() noexcept;
+
+        /**
+         * Documents with more blocks than the threshold are considered large. In large documents only blocks in the
+         * visible area plus a margin are highlighted, all other blocks are deferred until they become visible.
+         * @param blockCount Block count threshold. Values <= 0 disable large-document mode.
+         */
+        void setLargeDocumentThreshold(int blockCount) noexcept;
+
+        /**
+         * @return Block count threshold above which a document is considered large
+         */
+        int largeDocumentThreshold() const noexcept;
+
+        /**
+         * @return true if the document is currently in large-document mode
+         */
+        bool isLargeDocument() const noexcept;
+
+        /**
+         * Notifies about the blocks that are currently visible. Deferred blocks that come into view are highlighted.
+         * @param first Number of the first visible block
+         * @param last Number of the last visible block
+         */
+        void setVisibleBlocks(int first, int last) noexcept;
+
         bool event(QEvent* event) override;
 
     signals:
         /**
-         * Fired when the insight at position \p index is about to be auto-removed due to collapsing to zero-length
-         * @param index Index of the insight to be removed
+         * Fired when the insights at positions \p first to \p last are about to be auto-removed, e.g. due to collapsing
+         * to zero-length
+         * @param first Index of the first insight to be removed
+         * @param last Index of the last insight to be removed
          */
-        void aboutToAutoRemove(int index);
+        void aboutToAutoRemove(int first, int last);
 
         /**
-         * Fired right after the insight at position \p index was auto-removed due to collapsing to zero-length
-         * @param index Index of the insight that was removed. Note that this index is not valid anymore.
+         * Fired right after the insights at positions \p first to \p last were auto-removed
+         * @param first Index of the first insight that was removed
+         * @param last Index of the last insight that was removed. Note that these indices are not valid anymore.
          */
-        void autoRemoved(int index);
+        void autoRemoved(int first, int last);
 
     protected:
         void highlightBlock(const QString& /*text*/) override;
 
     private:
+        PositionTracker m_positions; // Must outlive the insights
         SVector m_insights{};
+        int m_largeDocThreshold = s_defaultLargeDocumentThreshold;
+        bool m_wasLargeDoc = false;
+        int m_firstVisibleBlock = 0;
+        int m_lastVisibleBlock = 0;
+        int m_batchDepth = 0;
+        IntervalSet<int> m_batchBlocks; // Blocks to rehighlight once the current batch ends
+        std::unordered_set<Insight const*> m_collapsed; // Insights that collapsed to zero length, not yet removed
+        mutable std::vector<int> m_maxEnds; // Largest end of all insights up to each index
+        mutable bool m_maxEndsValid = false;
+
+        void updateLargeDocumentMode();
+
+        bool isInHighlightWindow(int blockNum) const noexcept;
+
+        void markDeferred(QTextBlock block) const;
+
+        int firstRelevantInsight(int blockNum, int blockPos) const noexcept;
+
+        int firstEndingAfter(int pos) const noexcept;
+
+        void invalidateMaxEnds() noexcept;
 
         void findAndAutoRemove(Insight const* insight);
 
+        SVector::const_iterator firstStartingAt(int pos) const noexcept;
+
+        bool updateTextHashes(int position, int count);
+
+        void onContentsChange(int position, int charsRemoved, int charsAdded);
+
+        void scheduleRemoval(Insight const* insight);
+
+        void removeCollapsed();
+
+        void forgetCollapsed(SVector::const_iterator first, SVector::const_iterator last) noexcept;
+
         friend typename SceneDocumentInsightManager::SVector::const_iterator findInsertIdx(SceneDocumentInsightManager const& mgr,
                 std::unique_ptr<Insight> const& element);
 
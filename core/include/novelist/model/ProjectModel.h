@@ -29,6 +29,7 @@
 
 namespace novelist {
 
+    class InspectionCache;
     class InsertRowCommand;
     class RemoveRowCommand;
     class MoveRowCommand;
@@ -407,6 +408,12 @@ namespace novelist {
          */
         QUndoStack& undoStack() noexcept;
 
+        /**
+         * @details The cache is shared by all scenes of the project, and is saved and loaded along with the project.
+         * @return Cache of inspection results
+         */
+        std::shared_ptr<InspectionCache> const& inspectionCache() const noexcept;
+
         /**
          * Checks for content-equality
          *
@@ -462,6 +469,9 @@ namespace novelist {
         QDir m_saveDir;
         bool m_neverSaved = true;
         QString const m_contentDirName = "content";
+        QString const m_inspectionCacheName = "inspections.cache";
+        std::shared_ptr<InspectionCache> m_inspectionCache;
+        std::shared_ptr<StringPool> m_stringPool = std::make_shared<StringPool>();
         QUndoStack m_undoStack;
 
         void createRootNodes(ProjectProperties const& properties);
@@ -0,0 +1,195 @@
+/**********************************************************
+ * @file   ProjectTextIndex.h
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#ifndef NOVELIST_PROJECTTEXTINDEX_H
+#define NOVELIST_PROJECTTEXTINDEX_H
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <QtCore/QFuture>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QTimer>
+#include "ProjectModel.h"
+#include "util/ConnectionWrapper.h"
+#include <novelist_core_export.h>
+
+namespace novelist {
+    namespace internal {
+        /**
+         * Case-folded word -> scene id -> offsets of the word within the scene's raw text
+         */
+        using TextIndexTerms = std::map<QString, std::unordered_map<int, std::vector<int>>>;
+
+        /**
+         * Index of several scenes, built in the background
+         */
+        struct TextIndexBuild {
+            TextIndexTerms m_terms;
+            std::unordered_map<int, std::vector<QString>> m_sceneTerms; //!< Distinct terms of each scene
+        };
+    }
+
+    /**
+     * Inverted index over the content of all scenes of a project, mapping each word to the scenes and offsets it
+     * occurs at. The index is built in the background when a project is opened. Afterwards, scenes are indexed again
+     * one by one as they change, shortly after the author stops typing or at the latest when the index is queried.
+     * @details Words are runs of letters, numbers and marks, compared case-insensitively. Offsets are positions within
+     *          the scene's raw text, i.e. as returned by QTextDocument::toRawText(). Only the content of scenes is
+     *          indexed, not their names.
+     */
+    class NOVELIST_CORE_EXPORT ProjectTextIndex : public QObject {
+    Q_OBJECT
+
+    public:
+        /**
+         * Time in milliseconds after the last change before changed scenes are indexed again
+         */
+        static constexpr int s_updateDelay = 500;
+
+        /**
+         * A text found in a scene
+         */
+        struct Occurrence {
+            int m_sceneId; //!< Scene id
+            int m_offset; //!< Position within the scene's raw text
+            int m_length; //!< Length of the text
+
+            bool operator==(Occurrence const& other) const noexcept;
+        };
+
+        explicit ProjectTextIndex(QObject* parent = nullptr);
+
+        ~ProjectTextIndex() noexcept override;
+
+        /**
+         * Changes the indexed project and starts building the index in the background
+         * @param model Non-owning pointer to the project, may be nullptr. Must stay valid until it is replaced.
+         */
+        void setProject(ProjectModel* model);
+
+        /**
+         * @return The indexed project, might be nullptr
+         */
+        ProjectModel* project() const noexcept;
+
+        /**
+         * @return true while the index is built in the background
+         */
+        bool isBuilding() const noexcept;
+
+        /**
+         * Brings the index up to date with the project right away. Waits for the background build if it is still
+         * running. All queries do this implicitly.
+         */
+        void update();
+
+        /**
+         * @param word A single word
+         * @return All occurrences of the word as a whole word, ordered by scene and offset
+         */
+        std::vector<Occurrence> findWord(QString const& word);
+
+        /**
+         * @param prefix Start of a word
+         * @return All occurrences of words starting with the prefix, ordered by scene and offset. Each occurrence
+         *         covers the whole word.
+         */
+        std::vector<Occurrence> findPrefix(QString const& prefix);
+
+        /**
+         * @param part Part of a single word
+         * @return All occurrences of the part within words, ordered by scene and offset. Each occurrence covers just
+         *         the part. Occurrences don't overlap.
+         */
+        std::vector<Occurrence> findPart(QString const& part);
+
+        /**
+         * Determines which scenes might contain a match for a phrase
+         * @param phrase Phrase to look for, any text contained in a match of it
+         * @param regex Whether the phrase is a regular expression
+         * @return Ids of all scenes that might contain a match. If the index can't tell, nothing is returned and all
+         *         scenes might contain a match.
+         */
+        std::optional<std::unordered_set<int>> candidateScenes(QString const& phrase, bool regex);
+
+        /**
+         * @param model Project
+         * @param index Index of a node
+         * @return Id of the scene at the index, or -1 if the node isn't a scene
+         */
+        static int sceneId(ProjectModel const& model, QModelIndex const& index);
+
+        /**
+         * @param c Character
+         * @return true if the character belongs to a word
+         */
+        static bool isWordCharacter(QChar c) noexcept;
+
+        /**
+         * @param text Some text
+         * @return true if the text is a single word
+         */
+        static bool isWord(QString const& text) noexcept;
+
+        /**
+         * Finds the parts of a phrase that every match of it has to contain
+         * @param phrase Phrase to look for
+         * @param regex Whether the phrase is a regular expression
+         * @return Parts of words that every match contains. Might be empty, e.g. if the phrase consists of
+         *         punctuation only or uses alternatives.
+         */
+        static QStringList requiredParts(QString const& phrase, bool regex);
+
+    signals:
+        /**
+         * Emitted when the index was built in the background
+         */
+        void built();
+
+    private:
+        struct Scene {
+            QPointer<SceneDocument> m_doc;
+            ConnectionWrapper m_contentsConnection;
+            std::vector<QString> m_terms; // Distinct terms of the scene as they are in the index
+            bool m_dirty = true;
+        };
+
+        ProjectModel* m_model = nullptr;
+        std::vector<ConnectionWrapper> m_modelConnections;
+        internal::TextIndexTerms m_terms;
+        std::unordered_map<int, Scene> m_scenes;
+        QTimer m_updateTimer;
+        QFuture<std::shared_ptr<internal::TextIndexBuild>> m_build;
+        QFutureWatcher<std::shared_ptr<internal::TextIndexBuild>> m_buildWatcher;
+        bool m_buildPending = false;
+
+        void rebuild();
+
+        void finishBuild();
+
+        void onStructureChanged();
+
+        void onContentsChanged(int sceneId);
+
+        void syncStructure();
+
+        void indexScene(int sceneId, Scene& scene);
+
+        void removeScene(int sceneId, Scene& scene);
+    };
+}
+
+#endif //NOVELIST_PROJECTTEXTINDEX_H
@@ -0,0 +1,90 @@
+/**********************************************************
+ * @file   SettingsPage_Diagnostics.h
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#ifndef NOVELIST_SETTINGSPAGE_DIAGNOSTICS_H
+#define NOVELIST_SETTINGSPAGE_DIAGNOSTICS_H
+
+#include <QtWidgets/QWidget>
+#include <QtCore/QTimer>
+#include <memory>
+#include "SettingsPage.h"
+
+namespace Ui {
+    class SettingsPage_Diagnostics;
+}
+
+namespace novelist {
+    class SettingsPage_Diagnostics_Creator;
+
+    /**
+     * Shows the current inspection metrics
+     */
+    class NOVELIST_CORE_EXPORT SettingsPage_Diagnostics : public QWidget {
+    Q_OBJECT
+
+    public:
+        /**
+         * @param parent Parent widget
+         * @param f Window flags
+         */
+        explicit SettingsPage_Diagnostics(QWidget* parent = nullptr, Qt::WindowFlags f = Qt::WindowFlags{});
+
+        ~SettingsPage_Diagnostics() noexcept override;
+
+        /**
+         * Translate UI to new language
+         */
+        void retranslateUi();
+
+    public slots:
+
+        /**
+         * Shows the current state of all metrics
+         */
+        void refresh();
+
+    protected:
+        void changeEvent(QEvent* event) override;
+
+    private:
+        std::unique_ptr<Ui::SettingsPage_Diagnostics> m_ui;
+
+        friend SettingsPage_Diagnostics_Creator;
+    };
+
+    class NOVELIST_CORE_EXPORT SettingsPage_Diagnostics_Creator : public SettingsPage {
+    Q_OBJECT
+
+    public:
+        /**
+         * Default interval in seconds between two dumps of the metrics to the log, if enabled
+         */
+        static constexpr int s_defaultDumpInterval = 300;
+
+        SettingsPage_Diagnostics_Creator() noexcept;
+
+        QString name() noexcept override;
+
+        QString uid() noexcept override;
+
+        void initialize(QWidget* widget, QSettings const& settings) noexcept override;
+
+        void apply(QWidget const* widget, QSettings& settings) noexcept override;
+
+        void initiateUpdate(QSettings const& settings) noexcept override;
+
+        void restoreDefaults(QWidget const* widget) noexcept override;
+
+        QWidget* createWidget() noexcept override;
+
+    private:
+        QTimer m_dumpTimer;
+    };
+}
+
+#endif //NOVELIST_SETTINGSPAGE_DIAGNOSTICS_H
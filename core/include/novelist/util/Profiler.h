@@ -0,0 +1,187 @@
+/**********************************************************
+ * @file   Profiler.h
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#ifndef NOVELIST_PROFILER_H
+#define NOVELIST_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include <QtCore/QString>
+#include <novelist_core_export.h>
+
+#if defined(NOVELIST_PROFILING) || defined(DEBUG_BUILD)
+#define NOVELIST_PROFILING_ENABLED
+#endif
+
+namespace novelist::profiling {
+    /**
+     * Log-linear bucketing of nanosecond durations. Each power of two is split into four sub-buckets, so a bucket's
+     * bounds are at most 25% apart.
+     */
+    class NOVELIST_CORE_EXPORT Buckets {
+    public:
+        static constexpr size_t s_subBuckets = 4;
+        static constexpr size_t s_count = 64 * s_subBuckets;
+
+        /**
+         * @param nanos Duration in nanoseconds
+         * @return Index of the bucket that \p nanos falls into
+         */
+        static size_t indexOf(uint64_t nanos) noexcept;
+
+        /**
+         * @param index Bucket index
+         * @return Smallest duration in nanoseconds that falls into the bucket
+         */
+        static uint64_t lowerBound(size_t index) noexcept;
+    };
+
+    /**
+     * Plain copy of a histogram's state that can be merged and evaluated
+     */
+    struct NOVELIST_CORE_EXPORT HistogramSnapshot {
+        std::array<uint64_t, Buckets::s_count> m_buckets{}; //!< Amount of samples per bucket
+        uint64_t m_count = 0; //!< Total amount of samples
+        uint64_t m_sum = 0; //!< Sum of all samples in nanoseconds
+        uint64_t m_max = 0; //!< Largest sample in nanoseconds
+
+        /**
+         * Adds all samples of another snapshot to this one
+         * @param other Other snapshot
+         */
+        void merge(HistogramSnapshot const& other) noexcept;
+
+        /**
+         * @param p Percentile in [0, 1]
+         * @return Approximate duration in nanoseconds at the requested percentile, 0 if there are no samples
+         */
+        uint64_t percentile(double p) const noexcept;
+
+        /**
+         * @return Mean duration in nanoseconds, 0 if there are no samples
+         */
+        uint64_t mean() const noexcept;
+    };
+
+    /**
+     * Histogram of durations. Recording is lock-free; it is meant to have a single writer, but may be read from any
+     * thread at any time.
+     */
+    class NOVELIST_CORE_EXPORT Histogram {
+    public:
+        /**
+         * Add a sample
+         * @param nanos Duration in nanoseconds
+         */
+        void record(uint64_t nanos) noexcept;
+
+        /**
+         * @return Copy of the current state
+         */
+        HistogramSnapshot snapshot() const noexcept;
+
+    private:
+        std::array<std::atomic<uint64_t>, Buckets::s_count> m_buckets{};
+        std::atomic<uint64_t> m_sum{0};
+        std::atomic<uint64_t> m_max{0};
+    };
+
+    /**
+     * A named measuring point. Probes are supposed to have static storage duration, see NOVELIST_PROFILE_SCOPE.
+     */
+    class NOVELIST_CORE_EXPORT Probe {
+    public:
+        /**
+         * Maximum amount of probes in the application. Probes beyond that are silently ignored.
+         */
+        static constexpr size_t s_maxProbes = 64;
+
+        /**
+         * @param name Probe name. Must stay valid during object lifetime.
+         */
+        explicit Probe(char const* name) noexcept;
+
+        /**
+         * Record a sample in the calling thread's histogram of this probe
+         * @param nanos Duration in nanoseconds
+         */
+        void record(uint64_t nanos) const noexcept;
+
+    private:
+        size_t m_id;
+    };
+
+    /**
+     * Measures the time from construction to destruction and records it with a probe
+     */
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(Probe const& probe) noexcept
+                :m_probe(probe),
+                 m_start(std::chrono::steady_clock::now())
+        {
+        }
+
+        ~ScopedTimer() noexcept
+        {
+            auto const elapsed = std::chrono::steady_clock::now() - m_start;
+            m_probe.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+
+        ScopedTimer(ScopedTimer const&) = delete;
+
+        ScopedTimer& operator=(ScopedTimer const&) = delete;
+
+    private:
+        Probe const& m_probe;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    /**
+     * Results of a single probe, combined over all threads
+     */
+    struct NOVELIST_CORE_EXPORT ProbeResult {
+        char const* m_name; //!< Probe name
+        HistogramSnapshot m_histogram; //!< Combined histogram
+    };
+
+    /**
+     * @return Results of all probes that recorded at least one sample
+     */
+    NOVELIST_CORE_EXPORT std::vector<ProbeResult> collect() noexcept;
+
+    /**
+     * @return Human-readable table of count, mean and percentiles of all probes
+     */
+    NOVELIST_CORE_EXPORT QString report() noexcept;
+
+    /**
+     * Writes the report to the log
+     */
+    NOVELIST_CORE_EXPORT void dumpToLog() noexcept;
+}
+
+#define NOVELIST_PROFILE_CONCAT_IMPL(a, b) a##b
+#define NOVELIST_PROFILE_CONCAT(a, b) NOVELIST_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef NOVELIST_PROFILING_ENABLED
+/**
+ * Measures the time until the end of the current scope. Compiles to nothing unless profiling is enabled.
+ */
+#define NOVELIST_PROFILE_SCOPE(name) \
+    static ::novelist::profiling::Probe const NOVELIST_PROFILE_CONCAT(novelistProbe_, __LINE__){name}; \
+    ::novelist::profiling::ScopedTimer const NOVELIST_PROFILE_CONCAT(novelistTimer_, __LINE__){ \
+        NOVELIST_PROFILE_CONCAT(novelistProbe_, __LINE__)}
+#else
+#define NOVELIST_PROFILE_SCOPE(name) do { } while (false)
+#endif
+
+#endif //NOVELIST_PROFILER_H
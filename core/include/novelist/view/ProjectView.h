@@ -16,13 +16,18 @@
 #include <QtWidgets/QMenu>
 #include <QtWidgets/QAction>
 #include <QtWidgets/QDialog>
+#include <QtWidgets/QStyledItemDelegate>
 #include "model/ProjectModel.h"
+#include "util/ConnectionWrapper.h"
 #include <novelist_core_export.h>
 
 namespace novelist {
 
+    class ProjectInspectionService;
+
     namespace internal {
         class ProjectTreeView;
+        class ProjectItemDelegate;
     }
 
     /**
@@ -85,6 +90,13 @@ namespace novelist {
          */
         void scrollTo(QModelIndex const& index, QTreeView::ScrollHint hint = QTreeView::EnsureVisible);
 
+        /**
+         * Shows the amount of insights found by a background inspection next to each scene and chapter. The selected
+         * scene is inspected first.
+         * @param service Non-owning pointer to the service, may be nullptr
+         */
+        void useInspectionService(ProjectInspectionService* service);
+
     signals:
         /**
          * Fires when the user requests to open a scene, e.g. via double click
@@ -167,6 +179,9 @@ namespace novelist {
         QVBoxLayout* m_topLayout;
         QHBoxLayout* m_nestedLayout;
         internal::ProjectTreeView* m_treeView;
+        internal::ProjectItemDelegate* m_itemDelegate;
+        ProjectInspectionService* m_inspectionService = nullptr;
+        ConnectionWrapper m_insightCountConnection;
         QToolButton* m_newSceneButton;
         QToolButton* m_newChapterButton;
         QToolButton* m_deleteButton;
@@ -209,6 +224,24 @@ namespace novelist {
 
             void focusOutEvent(QFocusEvent* event) override;
         };
+
+        class ProjectItemDelegate : public QStyledItemDelegate {
+        Q_OBJECT
+
+        public:
+            explicit ProjectItemDelegate(QObject* parent) noexcept;
+
+            /**
+             * @param service Service that provides the amount of insights per node, may be nullptr
+             */
+            void useInspectionService(ProjectInspectionService const* service) noexcept;
+
+        protected:
+            void initStyleOption(QStyleOptionViewItem* option, QModelIndex const& index) const override;
+
+        private:
+            ProjectInspectionService const* m_inspectionService = nullptr;
+        };
     }
 }
 
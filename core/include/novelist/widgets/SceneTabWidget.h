@@ -11,6 +11,7 @@
 
 #include <QtWidgets/QTabWidget>
 #include <QtCore/QFile>
+#include <QtCore/QReadWriteLock>
 #include <QTabBar>
 #include <QtWidgets/QAbstractItemView>
 #include <QSettings>
@@ -34,6 +35,7 @@ namespace novelist {
 
             ProjectModel* m_model;
             QPersistentModelIndex m_modelIndex;
+            int m_sceneId;
         };
 
         class InternalTabBar : public QTabBar {
@@ -46,6 +48,9 @@ namespace novelist {
             void focusInEvent(QFocusEvent* event) override;
 
             void focusOutEvent(QFocusEvent* event) override;
+
+        private:
+            SceneTabWidget* m_tabWidget;
         };
     }
 
@@ -120,6 +125,16 @@ namespace novelist {
          */
         void registerInspector(std::unique_ptr<Inspector> inspector);
 
+        /**
+         * @return All registered inspectors
+         */
+        std::vector<std::unique_ptr<Inspector>> const* inspectors() const noexcept;
+
+        /**
+         * @return Lock that has to be held for reading while the registered inspectors are used
+         */
+        QReadWriteLock* inspectorsLock() const noexcept;
+
         /**
          * Provides an action that undoes changes in the currently open document, if any
          * @note Ownership remains with the tab widget
@@ -223,8 +238,12 @@ namespace novelist {
         QAbstractItemView* m_insightView = nullptr;
         std::vector<std::unique_ptr<internal::InternalTextEditor>> m_editors;
         std::vector<std::unique_ptr<Inspector>> m_inspectors;
+        mutable QReadWriteLock m_inspectorsLock;
         std::vector<CharacterReplacementRule> m_charReplacementRules;
         std::map<ProjectModel*, ConnectionWrapper> m_modelDataChangedConnections;
+        std::map<std::pair<ProjectModel const*, int>, internal::InternalTextEditor*> m_editorsByScene;
+
+        internal::InternalTextEditor* editorAt(int index) const noexcept;
 
         void applySettingsToEditor(QSettings const& settings, TextEditor* editor) const;
     };
@@ -55,6 +55,13 @@ namespace novelist {
          */
         QModelIndex insert(std::unique_ptr<Insight> insight);
 
+        /**
+         * Insert many insights at once. Views are notified once per run of rows that ends up contiguous, which is a
+         * single notification unless existing insights sort in between the new ones. Highlighting is updated once.
+         * @param insights New insights, in any order
+         */
+        void insert(std::vector<std::unique_ptr<Insight>> insights);
+
         /**
          * Remove element at \p index
          * @param index Index of element to remove
@@ -63,7 +70,8 @@ namespace novelist {
         bool remove(QModelIndex const& index);
 
         /**
-         * Remove all non-persistent elements in a certain range
+         * Remove all non-persistent elements in a certain range. Views are notified once per contiguous run of removed
+         * rows and highlighting is updated once.
          * @param start Start of the range
          * @param end End of the range
          * @return True in case elements have been erased, otherwise false
@@ -94,8 +102,8 @@ namespace novelist {
 
         SceneDocumentInsightManager* insightManager();
         SceneDocumentInsightManager const* insightManager() const;
-        void onAboutToAutoRemove(int idx);
-        void onAutoRemoved(int idx);
+        void onAboutToAutoRemove(int first, int last);
+        void onAutoRemoved(int first, int last);
     };
 }
 
@@ -0,0 +1,117 @@
+/**********************************************************
+ * @file   InspectionCache.h
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#ifndef NOVELIST_INSPECTIONCACHE_H
+#define NOVELIST_INSPECTIONCACHE_H
+
+#include <list>
+#include <optional>
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QIODevice>
+#include <QtCore/QMutex>
+#include "model/Language.h"
+#include "TextEditorInsightManager.h"
+#include <novelist_core_export.h>
+
+namespace novelist {
+    /**
+     * Content-addressed cache of inspection results. Entries are keyed by a hash of block text, language and the
+     * inspector's cache key, so a changed text or changed inspector settings never hit stale results. The cache is
+     * bounded by an approximate memory budget and evicts least recently used entries first. All methods are
+     * thread-safe.
+     */
+    class NOVELIST_CORE_EXPORT InspectionCache {
+    public:
+        /**
+         * Default memory budget in bytes
+         */
+        static constexpr size_t s_defaultBudget = 8 * 1024 * 1024;
+
+        /**
+         * @param budget Approximate maximum memory usage in bytes
+         */
+        explicit InspectionCache(size_t budget = s_defaultBudget) noexcept;
+
+        /**
+         * Computes the key of a cache entry
+         * @param text Block text
+         * @param lang Text language
+         * @param inspectorKey Cache key of the inspector, see Inspector::cacheKey()
+         * @return The key
+         */
+        static QByteArray makeKey(QString const& text, Language lang, QByteArray const& inspectorKey);
+
+        /**
+         * Looks up a result and marks it as recently used
+         * @param key Entry key
+         * @return The cached result, if any
+         */
+        std::optional<InspectionBlockResult> find(QByteArray const& key);
+
+        /**
+         * Adds a result, replacing any previous result with the same key
+         * @param key Entry key
+         * @param result Inspection result
+         */
+        void insert(QByteArray const& key, InspectionBlockResult result);
+
+        /**
+         * Removes all entries
+         */
+        void clear() noexcept;
+
+        /**
+         * @return Amount of entries
+         */
+        size_t size() const noexcept;
+
+        /**
+         * @return Approximate memory usage in bytes
+         */
+        size_t memoryUsage() const noexcept;
+
+        /**
+         * Writes all entries whose insights can be described to a device. Entries with insights that can't be
+         * restored are skipped.
+         * @param device Device to write to
+         * @return true in case of success, otherwise false
+         */
+        bool save(QIODevice& device) const;
+
+        /**
+         * Adds all entries stored on a device. Incompatible or corrupt data is rejected as a whole.
+         * @param device Device to read from
+         * @return true in case of success, otherwise false
+         */
+        bool load(QIODevice& device);
+
+    private:
+        struct Entry {
+            QByteArray m_key;
+            InspectionBlockResult m_result;
+            size_t m_size;
+        };
+
+        using EntryList = std::list<Entry>;
+
+        mutable QMutex m_mutex;
+        size_t m_budget;
+        size_t m_usage = 0;
+        EntryList m_entries; // Most recently used first
+        QHash<QByteArray, EntryList::iterator> m_index;
+
+        static size_t estimateSize(QByteArray const& key, InspectionBlockResult const& result) noexcept;
+
+        void insertLocked(QByteArray const& key, InspectionBlockResult result);
+
+        void evictLocked() noexcept;
+    };
+}
+
+#endif //NOVELIST_INSPECTIONCACHE_H
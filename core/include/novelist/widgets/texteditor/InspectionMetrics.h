@@ -0,0 +1,152 @@
+/**********************************************************
+ * @file   InspectionMetrics.h
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#ifndef NOVELIST_INSPECTIONMETRICS_H
+#define NOVELIST_INSPECTIONMETRICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include "util/Profiler.h"
+#include <novelist_core_export.h>
+
+namespace novelist {
+    /**
+     * Counters of a single inspector, copied at one point in time
+     */
+    struct NOVELIST_CORE_EXPORT InspectorMetricsSnapshot {
+        QString m_name; //!< Inspector name
+        uint64_t m_calls = 0; //!< Calls to the inspector
+        uint64_t m_blocks = 0; //!< Blocks passed to the inspector
+        uint64_t m_cacheHits = 0; //!< Blocks whose result was taken from the cache instead
+        uint64_t m_bytesSent = 0; //!< Bytes sent to an external service
+        uint64_t m_errors = 0; //!< Failed calls or requests
+        profiling::HistogramSnapshot m_queueTime; //!< Per call, time from the start of the refresh until the call
+        profiling::HistogramSnapshot m_latency; //!< Per call, time until its results were available
+    };
+
+    /**
+     * Live counters of a single inspector. All methods are thread-safe and lock-free.
+     */
+    class NOVELIST_CORE_EXPORT InspectorMetrics {
+    public:
+        /**
+         * @param name Inspector name
+         */
+        explicit InspectorMetrics(QString name) noexcept;
+
+        /**
+         * @return Inspector name
+         */
+        QString const& name() const noexcept;
+
+        /**
+         * Records a finished call
+         * @param blocks Amount of blocks passed to the call
+         * @param queueNanos Time in nanoseconds the blocks waited for the call
+         * @param latencyNanos Time in nanoseconds until the results were available
+         */
+        void recordCall(size_t blocks, uint64_t queueNanos, uint64_t latencyNanos) noexcept;
+
+        /**
+         * @param blocks Amount of blocks whose result was taken from the cache
+         */
+        void recordCacheHits(size_t blocks) noexcept;
+
+        /**
+         * @param bytes Amount of bytes sent to an external service
+         */
+        void recordBytesSent(size_t bytes) noexcept;
+
+        /**
+         * Records a failed call or request
+         */
+        void recordError() noexcept;
+
+        /**
+         * @return Copy of the current state
+         */
+        InspectorMetricsSnapshot snapshot() const;
+
+    private:
+        QString const m_name;
+        std::atomic<uint64_t> m_calls{0};
+        std::atomic<uint64_t> m_blocks{0};
+        std::atomic<uint64_t> m_cacheHits{0};
+        std::atomic<uint64_t> m_bytesSent{0};
+        std::atomic<uint64_t> m_errors{0};
+        profiling::Histogram m_queueTime;
+        profiling::Histogram m_latency;
+    };
+
+    /**
+     * Application-wide metrics of the inspection pipeline, always enabled. Inspectors are identified by name, see
+     * Inspector::name(). Besides the per-inspector counters, the time the user interface spends on applying results
+     * is tracked.
+     */
+    class NOVELIST_CORE_EXPORT InspectionMetrics {
+    public:
+        /**
+         * @return The global instance
+         */
+        static InspectionMetrics& instance() noexcept;
+
+        /**
+         * Thread-safe.
+         * @param name Inspector name
+         * @return Counters of the inspector, created on first use. The reference stays valid forever.
+         */
+        InspectorMetrics& inspector(QString const& name);
+
+        /**
+         * @param nanos Time in nanoseconds spent to finish a refresh
+         */
+        void recordFinishRefresh(uint64_t nanos) noexcept;
+
+        /**
+         * @param nanos Time in nanoseconds spent to apply the result of a block to its document
+         */
+        void recordApplyResult(uint64_t nanos) noexcept;
+
+        /**
+         * @return Current state of all inspectors, in order of first use
+         */
+        std::vector<InspectorMetricsSnapshot> inspectors() const;
+
+        /**
+         * @return Time spent to finish refreshes
+         */
+        profiling::HistogramSnapshot finishRefresh() const noexcept;
+
+        /**
+         * @return Time spent to apply block results
+         */
+        profiling::HistogramSnapshot applyResult() const noexcept;
+
+        /**
+         * @return Human-readable tables of all counters
+         */
+        QString report() const;
+
+        /**
+         * Writes the report to the log
+         */
+        void dumpToLog() const;
+
+    private:
+        mutable QMutex m_mutex;
+        std::deque<InspectorMetrics> m_inspectors; // Never shrinks, so references stay valid
+        profiling::Histogram m_finishRefresh;
+        profiling::Histogram m_applyResult;
+    };
+}
+
+#endif //NOVELIST_INSPECTIONMETRICS_H
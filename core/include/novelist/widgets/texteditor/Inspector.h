@@ -9,11 +9,30 @@
 #ifndef NOVELIST_INSPECTOR_H
 #define NOVELIST_INSPECTOR_H
 
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <typeinfo>
+#include <vector>
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
 #include "model/Language.h"
 #include "TextEditorInsightManager.h"
 #include <novelist_core_export.h>
 
 namespace novelist {
+    /**
+     * Set once the result of an inspection is no longer needed
+     */
+    using InspectionCancelToken = std::shared_ptr<std::atomic_bool const>;
+
+    /**
+     * Receives the results of an asynchronous inspection, one entry per text. Texts that couldn't be inspected, e.g.
+     * because a request failed, have no result.
+     */
+    using InspectionCallback = std::function<void(std::vector<std::optional<InspectionBlockResult>>)>;
+
     /**
      * Interface class for inspectors to implement
      */
@@ -28,6 +47,100 @@ namespace novelist {
          * @return Resulting insights
          */
         virtual InspectionBlockResult inspect(QString const& text, Language lang) const noexcept = 0;
+
+        /**
+         * Inspects many text blocks at once. Inspectors with a high overhead per call, e.g. because every call is a
+         * request to a server, can override this together with batchSize().
+         * @param texts Texts to inspect
+         * @param lang Text language
+         * @return Resulting insights, one entry per text
+         */
+        virtual std::vector<InspectionBlockResult> inspectBatch(std::vector<QString> const& texts,
+                Language lang) const noexcept
+        {
+            std::vector<InspectionBlockResult> results;
+            results.reserve(texts.size());
+            for (auto const& text : texts)
+                results.push_back(inspect(text, lang));
+            return results;
+        }
+
+        /**
+         * Asynchronous variant of inspectBatch(). By default this calls inspectBatch() right away on the calling
+         * thread, so synchronous inspectors work unchanged. Inspectors that mostly wait for I/O override this
+         * together with isAsync() to return before the results are available.
+         * @param texts Texts to inspect
+         * @param lang Text language
+         * @param cancelled Cancellation token per text. Texts whose token is set may be skipped, their results are
+         *                  discarded. Texts without a token, i.e. past the end of this vector, are never cancelled.
+         * @param done Called exactly once with one entry per text, possibly from another thread. Texts that failed
+         *             or were skipped have no result.
+         */
+        virtual void inspectAsync(std::vector<QString> texts, Language lang,
+                std::vector<InspectionCancelToken> cancelled, InspectionCallback done) const noexcept
+        {
+            std::vector<size_t> indices;
+            std::vector<QString> remaining;
+            for (size_t i = 0; i < texts.size(); ++i) {
+                if (i >= cancelled.size() || !cancelled[i]->load()) {
+                    indices.push_back(i);
+                    remaining.push_back(std::move(texts[i]));
+                }
+            }
+            auto results = inspectBatch(remaining, lang);
+            std::vector<std::optional<InspectionBlockResult>> all(texts.size());
+            for (size_t r = 0; r < indices.size() && r < results.size(); ++r)
+                all[indices[r]] = std::move(results[r]);
+            done(std::move(all));
+        }
+
+        /**
+         * @return true if inspectAsync() returns without waiting for the results. Such inspectors don't occupy an
+         *         inspection thread while their results are pending.
+         */
+        virtual bool isAsync() const noexcept
+        {
+            return false;
+        }
+
+        /**
+         * @return Maximum amount of blocks passed to a single call of inspectBatch(). With 1, inspect() is called
+         *         for every block.
+         */
+        virtual int batchSize() const noexcept
+        {
+            return 1;
+        }
+
+        /**
+         * Blocks are inspected in parallel, so inspect() may be called from multiple threads at once. Inspectors that
+         * are backed by a rate-limited service can bound the amount of concurrent calls. For asynchronous inspectors
+         * this bounds the amount of calls to inspectAsync() whose results are still pending.
+         * @return Maximum amount of concurrent calls to inspect() during a single refresh, or 0 for no limit
+         */
+        virtual int maxConcurrency() const noexcept
+        {
+            return 0;
+        }
+
+        /**
+         * Results are cached by block text, language and this key. The key must change whenever the inspector would
+         * produce different results for the same text, e.g. after a settings change. If the key changes while blocks
+         * are being inspected, those results are not cached. Blocks that couldn't be inspected are never cached.
+         * @return Identifier of inspector, version and settings, or an empty key if results must not be cached
+         */
+        virtual QByteArray cacheKey() const noexcept
+        {
+            return {};
+        }
+
+        /**
+         * @return Name that identifies the inspector in diagnostics, see InspectionMetrics
+         */
+        virtual QString name() const noexcept
+        {
+            return QString::fromLatin1(typeid(*this).name());
+        }
     };
 }
 
@@ -0,0 +1,178 @@
+/**********************************************************
+ * @file   ProjectInspectionService.h
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#ifndef NOVELIST_PROJECTINSPECTIONSERVICE_H
+#define NOVELIST_PROJECTINSPECTIONSERVICE_H
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include <QtCore/QByteArray>
+#include <QtCore/QFuture>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QIODevice>
+#include <QtCore/QObject>
+#include <QtCore/QPersistentModelIndex>
+#include <QtCore/QReadWriteLock>
+#include <QtCore/QThreadPool>
+#include <QtCore/QTimer>
+#include "model/ProjectModel.h"
+#include "util/ConnectionWrapper.h"
+#include "TextEditorInsightManager.h"
+#include <novelist_core_export.h>
+
+namespace novelist {
+    class Inspector;
+
+    /**
+     * Inspects all scenes of a project in the background while the author is idle. Scenes are inspected one at a time
+     * with the same inspectors as the text editors, leaving one core to the editors. Results go into the project's
+     * inspection cache, so opening a scene shows its insights right away. The amount of insights per scene is kept
+     * along with a hash of the scene's content and stored next to the project, so unchanged scenes aren't inspected
+     * again.
+     */
+    class NOVELIST_CORE_EXPORT ProjectInspectionService : public QObject {
+    Q_OBJECT
+
+    public:
+        /**
+         * Default time in milliseconds without user input before the service starts inspecting
+         */
+        static constexpr int s_defaultIdleDelay = 3000;
+
+        explicit ProjectInspectionService(QObject* parent = nullptr);
+
+        ~ProjectInspectionService() noexcept override;
+
+        /**
+         * Changes the project to inspect. Stored results of the project are loaded if there are any.
+         * @param model Non-owning pointer to the project, may be nullptr. Must stay valid until it is replaced.
+         */
+        void setProject(ProjectModel* model);
+
+        /**
+         * @return The inspected project, might be nullptr
+         */
+        ProjectModel* project() const noexcept;
+
+        /**
+         * @param inspectors Non-owning pointer to the inspectors to use, may be nullptr
+         * @param lock Non-owning pointer to the lock that guards the inspectors, shared with everyone else using
+         *             them. May be nullptr if the inspectors never change.
+         */
+        void useInspectors(std::vector<std::unique_ptr<Inspector>> const* inspectors,
+                QReadWriteLock* lock = nullptr) noexcept;
+
+        /**
+         * Moves a scene to the front of the queue, e.g. because the author is about to open it
+         * @param index Scene index
+         */
+        void prioritize(QModelIndex const& index);
+
+        /**
+         * @param msec Time in milliseconds without user input before the service starts inspecting
+         */
+        void setIdleDelay(int msec) noexcept;
+
+        /**
+         * @return Time in milliseconds without user input before the service starts inspecting
+         */
+        int idleDelay() const noexcept;
+
+        /**
+         * @param index Scene or chapter index
+         * @return Amount of insights found in a scene, or in all scenes below a chapter. Empty if none of them were
+         *         inspected yet. Scenes that changed since they were last inspected report their previous amount.
+         */
+        std::optional<int> insightCount(QModelIndex const& index) const;
+
+        /**
+         * @return true while a scene is being inspected, otherwise false
+         */
+        bool isRunning() const noexcept;
+
+        /**
+         * Writes the per-scene results to a device
+         * @param device Device to write to
+         * @return true in case of success, otherwise false
+         */
+        bool save(QIODevice& device) const;
+
+        /**
+         * Replaces the per-scene results with the ones stored on a device. Incompatible or corrupt data is rejected.
+         * @param device Device to read from
+         * @return true in case of success, otherwise false
+         */
+        bool load(QIODevice& device);
+
+        bool event(QEvent* event) override;
+
+        bool eventFilter(QObject* watched, QEvent* event) override;
+
+    signals:
+        /**
+         * Emitted when the amount of insights in a scene changed
+         * @param index Scene index
+         */
+        void insightCountChanged(QModelIndex const& index);
+
+    private:
+        /**
+         * Result of the last complete inspection of a scene
+         */
+        struct SceneSummary {
+            QByteArray m_hash; //!< Hash of the inspected content
+            int m_insightCount = 0; //!< Amount of insights found
+        };
+
+        /**
+         * The scene that is currently being inspected
+         */
+        struct Job {
+            QPersistentModelIndex m_index;
+            int m_sceneId = 0;
+            QByteArray m_hash;
+            std::vector<std::shared_ptr<std::atomic_bool>> m_cancelled;
+            size_t m_doneBlocks = 0;
+            int m_insightCount = 0;
+            bool m_failed = false; // Some blocks couldn't be inspected
+        };
+
+        QString const m_fileName = "inspections.summary";
+        ProjectModel* m_model = nullptr;
+        std::vector<std::unique_ptr<Inspector>> const* m_inspectors = nullptr;
+        QReadWriteLock* m_inspectorsLock = nullptr;
+        std::unordered_map<int, SceneSummary> m_summaries; // By scene ID
+        std::deque<QPersistentModelIndex> m_queue;
+        std::optional<Job> m_job;
+        uint64_t m_batch = 0;
+        bool m_upToDate = false;
+        QThreadPool m_runnerPool;
+        QFuture<void> m_running;
+        QFutureWatcher<void> m_runningWatcher;
+        QTimer m_idleTimer;
+        int m_idleDelay = s_defaultIdleDelay;
+        std::vector<ConnectionWrapper> m_modelConnections;
+
+        void onActivity();
+        void cancel() noexcept;
+        void fillQueue();
+        void inspectNext();
+        void finishScene();
+        void applyBlockResult(uint64_t batch, size_t index, InspectionBlockResult const& result, bool complete);
+        QByteArray contentHash(std::vector<QString> const& blocks, Language lang) const;
+        void loadSummaries();
+        void saveSummaries() const;
+        int sceneId(QModelIndex const& index) const;
+    };
+}
+
+#endif //NOVELIST_PROJECTINSPECTIONSERVICE_H
@@ -74,6 +74,18 @@ namespace novelist {
          */
         bool isShowParagraphNumberArea() const noexcept;
 
+        /**
+         * Documents with more paragraphs than the threshold only get insights highlighted in the visible area
+         * @param blockCount Paragraph count threshold. Values <= 0 disable large-document mode.
+         */
+        void setLargeDocumentThreshold(int blockCount) noexcept;
+
+        /**
+         * Changed paragraphs are inspected once the author pauses typing for this long
+         * @param msec Quiet period in milliseconds
+         */
+        void setInspectionDelay(int msec) noexcept;
+
         /**
          * @return Underlying document
          */
@@ -104,8 +116,11 @@ namespace novelist {
          * Makes the editor use the passed inspectors
          * @param inspectors Non-owning pointer to a vector of inspectors. The pointer must stay valid during object
          *                   lifetime or until this is called with another (possibly null) pointer.
+         * @param lock Non-owning pointer to the lock that guards the inspectors, shared with everyone else using
+         *             them. May be nullptr if the inspectors never change.
          */
-        void useInspectors(std::vector<std::unique_ptr<Inspector>> const* inspectors) noexcept;
+        void useInspectors(std::vector<std::unique_ptr<Inspector>> const* inspectors,
+                QReadWriteLock* lock = nullptr) noexcept;
 
         /**
          * Makes the editor use the passed character replacement rules
@@ -209,6 +224,11 @@ namespace novelist {
          */
         QTextBlock firstVisibleBlock() const;
 
+        /**
+         * @return The last block that is currently visible on the screen
+         */
+        QTextBlock lastVisibleBlock() const;
+
         void mouseMoveEvent(QMouseEvent* e) override;
 
         void insertFromMimeData(const QMimeData* source) override;
@@ -246,6 +266,8 @@ namespace novelist {
 
         void updateParagraphNumberArea(QRect const& rect, int dy);
 
+        void updateVisibleBlocks();
+
         void setDefaultBlockFormat();
 
         std::pair<int, int> lookForMatchingChar(std::pair<QChar, QChar> const& matchingChars, int pos,
@@ -255,9 +277,12 @@ namespace novelist {
         std::unique_ptr<internal::ParagraphNumberArea> m_paragraphNumberArea;
         int m_lastVerticalSliderPos = 0;
         int m_lastBlockCount = 0;
+        int m_largeDocThreshold = SceneDocumentInsightManager::s_defaultLargeDocumentThreshold;
+        SceneDocument* m_document = nullptr; // Typed copy of QTextEdit::document(), avoids casts on hot paths
+        ConnectionWrapper m_documentDestroyedConnection;
         InsightModel m_insights;
-        QReadWriteLock m_inspectorsLock;
         std::vector<std::unique_ptr<Inspector>> const* m_inspectors = nullptr;
+        QReadWriteLock* m_inspectorsLock = nullptr;
         TextEditorInsightManager m_insightMgr{this};
         std::vector<CharacterReplacementRule> const* m_charReplacementRules = nullptr;
         ExtraSelectionsManager m_extraSelectionsManager{this};
@@ -9,13 +9,18 @@
 #ifndef NOVELIST_TEXTEDITORINSIGHTMANAGER_H
 #define NOVELIST_TEXTEDITORINSIGHTMANAGER_H
 
+#include <atomic>
 #include <QtCore/QObject>
+#include <QtCore/QEvent>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QPoint>
 #include <QtCore/QFuture>
+#include <QtCore/QFutureWatcher>
 #include <QtCore/QReadWriteLock>
 #include <QtCore/QTimer>
 #include <QTextBlock>
 #include <gsl/gsl>
+#include "datastructures/IntervalSet.h"
 #include "model/Language.h"
 #include "document/InsightFactory.h"
 #include "util/ConnectionWrapper.h"
@@ -24,6 +29,7 @@
 namespace novelist {
     class TextEditor;
     class Inspector;
+    class InspectionCache;
 
     /**
      * A single result as returned from an auto inspection tool
@@ -44,6 +50,52 @@ namespace novelist {
      */
     using InspectionResult = std::vector<InspectionBlockResult>;
 
+    namespace internal {
+        /**
+         * Blocks to inspect during a single refresh, in order of priority
+         */
+        struct InspectionRequest {
+            std::vector<QString> m_blocks; //!< Block texts
+            std::vector<std::shared_ptr<std::atomic_bool>> m_cancelled; //!< Per block, set to skip the block
+            Language m_lang; //!< Text language
+            std::shared_ptr<InspectionCache> m_cache; //!< Result cache, might be nullptr
+            QObject* m_receiver; //!< Receives an event with the result of each block as soon as it is done
+            uint64_t m_batch; //!< Identifies the refresh
+            int m_maxLanes; //!< Maximum amount of concurrent calls per inspector, or 0 for no limit
+        };
+
+        /**
+         * Carries the result of a single block of an InspectionRequest back to its receiver
+         */
+        class InspectionResultEvent : public QEvent {
+        public:
+            InspectionResultEvent(uint64_t batch, size_t index, InspectionBlockResult result, bool complete)
+                    :QEvent(s_eventId),
+                     m_batch(batch),
+                     m_index(index),
+                     m_result(std::move(result)),
+                     m_complete(complete)
+            {
+            }
+
+            uint64_t m_batch;
+            size_t m_index;
+            InspectionBlockResult m_result;
+            bool m_complete; //!< false if an inspector failed on the block, so the result might be missing insights
+            static inline QEvent::Type const s_eventId = static_cast<QEvent::Type>(QEvent::registerEventType());
+        };
+
+        /**
+         * Inspects all blocks of a request with all inspectors. Cached results are used where possible, new results
+         * are added to the cache unless an inspector failed on them. Blocks until all blocks are done or cancelled.
+         * @param request Blocks to inspect
+         * @param inspectors Inspectors to run, may be nullptr
+         * @param rwlock Lock protecting the inspectors
+         */
+        NOVELIST_CORE_EXPORT void runInspection(InspectionRequest request,
+                std::vector<std::unique_ptr<Inspector>> const* inspectors, QReadWriteLock* rwlock);
+    }
+
     /**
      * Manages insights of a TextEditor, such as displaying their tool tips on hover and running auto-inspections
      */
@@ -51,6 +103,16 @@ namespace novelist {
     Q_OBJECT
 
     public:
+        /**
+         * Default time in milliseconds without changes before changed blocks are inspected
+         */
+        static constexpr int s_defaultQuietPeriod = 500;
+
+        /**
+         * While changes keep coming in, the quiet period grows up to this multiple of its configured value
+         */
+        static constexpr int s_maxBackoffFactor = 2;
+
         /**
          * Construct new manager
          * @param editor Non-owning pointer to the editor to manage. Pointer must stay valid during object lifetime.
@@ -64,6 +126,18 @@ namespace novelist {
          */
         void reinspect() noexcept;
 
+        /**
+         * @param msec Time in milliseconds without changes before changed blocks are inspected
+         */
+        void setQuietPeriod(int msec) noexcept;
+
+        /**
+         * @return Time in milliseconds without changes before changed blocks are inspected
+         */
+        int quietPeriod() const noexcept;
+
+        bool event(QEvent* event) override;
+
     public slots:
 
         /**
@@ -78,23 +152,43 @@ namespace novelist {
         void onDocumentChanged();
 
     private:
+        /**
+         * A block that is part of the running refresh
+         */
+        struct InspectionJob {
+            QTextBlock m_block;
+            std::shared_ptr<std::atomic_bool> m_cancelled;
+            bool m_done = false;
+        };
+
         gsl::not_null<TextEditor*> m_editor;
         ConnectionWrapper m_contentsChangeConnection;
-        QFuture<InspectionResult> m_updateResults;
-        std::vector<QTextBlock> m_needUpdateBlocks;
-        std::vector<QTextBlock> m_updatingBlocks;
+        QFuture<void> m_updateResults;
+        QFutureWatcher<void> m_updateWatcher;
+        IntervalSet<int> m_needUpdateBlocks; // Block numbers
+        std::vector<InspectionJob> m_updatingBlocks;
+        int m_blockCount = 0;
+        uint64_t m_batch = 0;
         QTimer m_updateTimer;
-
+        int m_quietPeriod = s_defaultQuietPeriod;
+        int m_currentDelay = s_defaultQuietPeriod;
+        QElapsedTimer m_lastChange;
+        int m_lastCursorBlock = -1;
+
+        void markDirty(int firstBlock, int lastBlock);
+        void scheduleUpdate();
+        void cancelAutoInsightRefresh() noexcept;
         void startAutoInsightRefresh();
         void finishAutoInsightRefresh();
-        static InspectionResult runAutoInsightRefresh(std::vector<QString> blocks,
-                std::vector<std::unique_ptr<Inspector>> const* inspectors, QReadWriteLock* rwlock, Language lang);
+        void applyBlockResult(uint64_t batch, size_t index, InspectionBlockResult const& result);
 
     private slots:
 
         void onContentsChange(int pos, int removed, int added);
 
         void onUpdate();
+
+        void onCursorPositionChanged();
     };
 }
 
@@ -15,6 +15,7 @@
 #include "util/ConnectionWrapper.h"
 #include "model/ProjectModel.h"
 #include "widgets/SceneTabWidget.h"
+#include "widgets/texteditor/ProjectInspectionService.h"
 #include "view/ProjectView.h"
 #include "novelist_core_export.h"
 
@@ -95,6 +96,7 @@ namespace novelist {
     private:
         std::unique_ptr<Ui::MainWindow> m_ui;
         std::unique_ptr<ProjectModel> m_model;
+        ProjectInspectionService m_inspectionService;
         DelegateAction m_undoAction{"Undo"};
         DelegateAction m_redoAction{"Redo"};
 
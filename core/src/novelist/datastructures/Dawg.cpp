@@ -0,0 +1,342 @@
+/**********************************************************
+ * @file   Dawg.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <tuple>
+#include "datastructures/Dawg.h"
+
+namespace novelist {
+    namespace {
+        constexpr quint32 s_magic = 0x4E445731; // "NDW1"
+        constexpr quint32 s_version = 1;
+    }
+
+    /**
+     * Builds a minimized graph from sorted words, following Daciuk et al., "Incremental Construction of Minimal
+     * Acyclic Finite-State Automata". Nodes that can't change anymore are merged with equivalent nodes right away,
+     * so memory usage stays close to the size of the final graph.
+     */
+    class Dawg::Builder {
+    public:
+        struct Node {
+            bool m_final = false;
+            std::vector<std::pair<char16_t, size_t>> m_edges; // Label and target node, sorted by label
+
+            bool operator<(Node const& other) const noexcept
+            {
+                return std::tie(m_final, m_edges) < std::tie(other.m_final, other.m_edges);
+            }
+        };
+
+        Builder()
+                :m_nodes(1)
+        {
+        }
+
+        /**
+         * @param word Word to add, must be greater than the previously added word
+         */
+        void insert(QString const& word)
+        {
+            int prefix = 0;
+            while (prefix < word.size() && prefix < m_previous.size() && word.at(prefix) == m_previous.at(prefix))
+                ++prefix;
+            minimize(static_cast<size_t>(prefix));
+
+            size_t node = m_unchecked.empty() ? 0 : m_unchecked.back().second;
+            for (int i = prefix; i < word.size(); ++i) {
+                size_t const child = makeNode();
+                m_nodes[node].m_edges.emplace_back(word.at(i).unicode(), child);
+                m_unchecked.emplace_back(node, child);
+                node = child;
+            }
+            m_nodes[node].m_final = true;
+            m_previous = word;
+            ++m_wordCount;
+        }
+
+        /**
+         * @return Serialized graph of all added words
+         */
+        QByteArray finish()
+        {
+            minimize(0);
+
+            // Every node's edges form one contiguous block. Offsets are assigned first, so edges can point to
+            // blocks that are written later.
+            std::vector<quint32> offsets(m_nodes.size(), s_unassigned);
+            quint32 edgeCount = 0;
+            assignOffsets(0, offsets, edgeCount);
+
+            Header header{s_magic, s_version, m_wordCount, edgeCount, offsets[0], 0};
+            QByteArray data(static_cast<int>(sizeof(Header) + edgeCount * sizeof(Edge)), Qt::Uninitialized);
+            std::memcpy(data.data(), &header, sizeof(Header));
+            auto* edges = reinterpret_cast<Edge*>(data.data() + sizeof(Header));
+            std::vector<char> written(m_nodes.size(), false);
+            writeEdges(0, offsets, written, edges);
+            return data;
+        }
+
+    private:
+        static constexpr quint32 s_unassigned = 0xFFFFFFFE;
+
+        std::vector<Node> m_nodes;
+        std::vector<size_t> m_freeNodes;
+        std::map<Node, size_t> m_register;
+        std::vector<std::pair<size_t, size_t>> m_unchecked; // Parent and child along the previous word
+        QString m_previous;
+        quint32 m_wordCount = 0;
+
+        size_t makeNode()
+        {
+            if (m_freeNodes.empty()) {
+                m_nodes.emplace_back();
+                return m_nodes.size() - 1;
+            }
+            size_t const node = m_freeNodes.back();
+            m_freeNodes.pop_back();
+            return node;
+        }
+
+        void minimize(size_t downTo)
+        {
+            while (m_unchecked.size() > downTo) {
+                auto const [parent, child] = m_unchecked.back();
+                m_unchecked.pop_back();
+                auto iter = m_register.find(m_nodes[child]);
+                if (iter != m_register.end()) {
+                    // Nothing else points to the child yet, so it can be reused
+                    m_nodes[parent].m_edges.back().second = iter->second;
+                    m_nodes[child] = Node();
+                    m_freeNodes.push_back(child);
+                }
+                else
+                    m_register.emplace(m_nodes[child], child);
+            }
+        }
+
+        void assignOffsets(size_t node, std::vector<quint32>& offsets, quint32& edgeCount) const
+        {
+            if (offsets[node] != s_unassigned)
+                return;
+            auto const& edges = m_nodes[node].m_edges;
+            if (edges.empty()) {
+                offsets[node] = s_noEdges;
+                return;
+            }
+            offsets[node] = edgeCount;
+            edgeCount += static_cast<quint32>(edges.size());
+            for (auto const& e : edges)
+                assignOffsets(e.second, offsets, edgeCount);
+        }
+
+        void writeEdges(size_t node, std::vector<quint32> const& offsets, std::vector<char>& written,
+                Edge* out) const
+        {
+            if (written[node])
+                return;
+            written[node] = true;
+            auto const& edges = m_nodes[node].m_edges;
+            for (size_t i = 0; i < edges.size(); ++i) {
+                auto const target = edges[i].second;
+                quint16 flags = 0;
+                if (m_nodes[target].m_final)
+                    flags |= s_finalFlag;
+                if (i + 1 == edges.size())
+                    flags |= s_lastFlag;
+                out[offsets[node] + i] = {offsets[target], edges[i].first, flags};
+                writeEdges(target, offsets, written, out);
+            }
+        }
+    };
+
+    /**
+     * Walks the graph depth-first while computing the edit distance to a word row by row, one row per prefix.
+     * Branches whose row exceeds the maximum distance everywhere can't lead to a match and are skipped.
+     */
+    class Dawg::Search {
+    public:
+        Search(Edge const* edges, QString const& word, int maxDistance)
+                :m_edges(edges),
+                 m_word(word),
+                 m_maxDistance(maxDistance)
+        {
+            std::vector<int> first(static_cast<size_t>(word.size()) + 1);
+            for (size_t j = 0; j < first.size(); ++j)
+                first[j] = static_cast<int>(j);
+            m_rows.push_back(std::move(first));
+        }
+
+        void visit(quint32 node)
+        {
+            if (node == s_noEdges)
+                return;
+
+            size_t const depth = m_path.size();
+            size_t const n = static_cast<size_t>(m_word.size());
+            if (m_rows.size() <= depth + 1)
+                m_rows.emplace_back(n + 1);
+
+            for (quint32 i = node;; ++i) {
+                auto const& edge = m_edges[i];
+                auto const& prev = m_rows[depth];
+                auto& row = m_rows[depth + 1];
+                row[0] = static_cast<int>(depth) + 1;
+                int rowMin = row[0];
+                for (size_t j = 1; j <= n; ++j) {
+                    int const cost = m_word[static_cast<int>(j) - 1].unicode() == edge.m_label ? 0 : 1;
+                    row[j] = std::min({prev[j] + 1, row[j - 1] + 1, prev[j - 1] + cost});
+                    if (depth > 0 && j > 1 && m_word[static_cast<int>(j) - 2].unicode() == edge.m_label
+                            && m_word[static_cast<int>(j) - 1].unicode() == m_path.back())
+                        row[j] = std::min(row[j], m_rows[depth - 1][j - 2] + 1);
+                    rowMin = std::min(rowMin, row[j]);
+                }
+
+                m_path.push_back(edge.m_label);
+                if ((edge.m_flags & s_finalFlag) && row[n] <= m_maxDistance)
+                    m_results.emplace_back(QString(reinterpret_cast<QChar const*>(m_path.data()),
+                            static_cast<int>(m_path.size())), row[n]);
+                if (rowMin <= m_maxDistance)
+                    visit(edge.m_target);
+                m_path.pop_back();
+
+                if (edge.m_flags & s_lastFlag)
+                    break;
+            }
+        }
+
+        std::vector<std::pair<QString, int>> m_results;
+
+    private:
+        Edge const* m_edges;
+        QString const& m_word;
+        int m_maxDistance;
+        std::vector<std::vector<int>> m_rows; // Edit distance rows, one per prefix length
+        std::vector<char16_t> m_path;
+    };
+
+    Dawg::Dawg()
+            :Dawg(Builder().finish())
+    {
+    }
+
+    Dawg::Dawg(QByteArray data) noexcept
+            :m_data(std::move(data))
+    {
+    }
+
+    Dawg Dawg::build(std::vector<QString> words)
+    {
+        std::sort(words.begin(), words.end());
+        words.erase(std::unique(words.begin(), words.end()), words.end());
+
+        Builder builder;
+        for (auto const& w : words) {
+            if (!w.isEmpty())
+                builder.insert(w);
+        }
+        return Dawg(builder.finish());
+    }
+
+    std::optional<Dawg> Dawg::fromData(QByteArray data)
+    {
+        if (static_cast<size_t>(data.size()) < sizeof(Header)
+                || reinterpret_cast<quintptr>(data.constData()) % alignof(Header) != 0)
+            return std::nullopt;
+
+        Header header{};
+        std::memcpy(&header, data.constData(), sizeof(Header));
+        if (header.m_magic != s_magic || header.m_version != s_version
+                || static_cast<size_t>(data.size()) != sizeof(Header) + header.m_edgeCount * sizeof(Edge))
+            return std::nullopt;
+        if (header.m_root != s_noEdges && header.m_root >= header.m_edgeCount)
+            return std::nullopt;
+
+        // Make sure no lookup can leave the data, no matter what the file contains
+        auto const* edges = reinterpret_cast<Edge const*>(data.constData() + sizeof(Header));
+        for (quint32 i = 0; i < header.m_edgeCount; ++i) {
+            if (edges[i].m_target != s_noEdges && edges[i].m_target >= header.m_edgeCount)
+                return std::nullopt;
+        }
+        if (header.m_edgeCount > 0 && !(edges[header.m_edgeCount - 1].m_flags & s_lastFlag))
+            return std::nullopt;
+
+        return Dawg(std::move(data));
+    }
+
+    QByteArray const& Dawg::data() const noexcept
+    {
+        return m_data;
+    }
+
+    bool Dawg::contains(QString const& word) const noexcept
+    {
+        if (word.isEmpty())
+            return false;
+
+        quint32 node = header().m_root;
+        Edge const* edge = nullptr;
+        for (QChar c : word) {
+            edge = findEdge(node, c);
+            if (edge == nullptr)
+                return false;
+            node = edge->m_target;
+        }
+        return (edge->m_flags & s_finalFlag) != 0;
+    }
+
+    std::vector<std::pair<QString, int>> Dawg::suggest(QString const& word, int maxDistance, size_t maxCount) const
+    {
+        Search search(edges(), word, maxDistance);
+        search.visit(header().m_root);
+
+        auto& results = search.m_results;
+        std::sort(results.begin(), results.end(), [](auto const& a, auto const& b) {
+            return std::tie(a.second, a.first) < std::tie(b.second, b.first);
+        });
+        if (results.size() > maxCount)
+            results.resize(maxCount);
+        return std::move(results);
+    }
+
+    size_t Dawg::wordCount() const noexcept
+    {
+        return header().m_wordCount;
+    }
+
+    size_t Dawg::edgeCount() const noexcept
+    {
+        return header().m_edgeCount;
+    }
+
+    Dawg::Header const& Dawg::header() const noexcept
+    {
+        return *reinterpret_cast<Header const*>(m_data.constData());
+    }
+
+    Dawg::Edge const* Dawg::edges() const noexcept
+    {
+        return reinterpret_cast<Edge const*>(m_data.constData() + sizeof(Header));
+    }
+
+    Dawg::Edge const* Dawg::findEdge(quint32 node, QChar c) const noexcept
+    {
+        if (node == s_noEdges)
+            return nullptr;
+
+        // Edges are sorted by label
+        for (Edge const* edge = edges() + node;; ++edge) {
+            if (edge->m_label == c.unicode())
+                return edge;
+            if (edge->m_label > c.unicode() || (edge->m_flags & s_lastFlag))
+                return nullptr;
+        }
+    }
+}
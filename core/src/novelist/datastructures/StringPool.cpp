@@ -0,0 +1,43 @@
+/**********************************************************
+ * @file   StringPool.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#include <algorithm>
+#include "datastructures/StringPool.h"
+
+namespace novelist {
+    QString StringPool::intern(QString const& str)
+    {
+        if (str.isEmpty())
+            return QString();
+
+        if (auto iter = m_strings.constFind(str); iter != m_strings.constEnd())
+            return *iter;
+
+        // Pruning whenever the pool doubled keeps the amortized cost per call constant
+        if (m_strings.size() >= m_pruneThreshold) {
+            prune();
+            m_pruneThreshold = std::max(s_minPruneThreshold, 2 * m_strings.size());
+        }
+        return *m_strings.insert(str);
+    }
+
+    void StringPool::prune()
+    {
+        for (auto iter = m_strings.begin(); iter != m_strings.end();) {
+            if (iter->isDetached())
+                iter = m_strings.erase(iter);
+            else
+                ++iter;
+        }
+    }
+
+    size_t StringPool::size() const noexcept
+    {
+        return static_cast<size_t>(m_strings.size());
+    }
+}
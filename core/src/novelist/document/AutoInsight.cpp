@@ -15,13 +15,25 @@ namespace novelist {
              m_suggestions(std::move(suggestions))
     {
         retranslate();
-        for (QString const& s : m_suggestions) {
-            auto* act = new QAction(s, &m_menu);
-            connect(act, &QAction::triggered, [this, s] {
-                replaceMarkedText(s);
-            });
-            m_menu.addAction(act);
+    }
+
+    AutoInsight::AutoInsight(gsl::not_null<SceneDocument*> doc, int left, int right, MessageBuilder msgBuilder,
+            QStringList suggestions)
+            :BaseInsight(doc, left, right, QString()),
+             m_msgBuilder(std::move(msgBuilder)),
+             m_suggestions(std::move(suggestions))
+    {
+        retranslate();
+    }
+
+    QString const& AutoInsight::message() const noexcept
+    {
+        if (m_msgBuilder) {
+            auto builder = std::move(m_msgBuilder);
+            m_msgBuilder = nullptr;
+            const_cast<AutoInsight*>(this)->setMessage(builder());
         }
+        return BaseInsight::message();
     }
 
     bool AutoInsight::isPersistent() const noexcept
@@ -31,11 +43,33 @@ namespace novelist {
 
     QMenu const& AutoInsight::menu() const noexcept
     {
-        return m_menu;
+        if (!m_menu)
+            m_menu = const_cast<AutoInsight*>(this)->createMenu();
+        return *m_menu;
     }
 
     void AutoInsight::retranslate() noexcept
     {
-        m_menu.setTitle(tr("Suggestions"));
+        if (m_menu)
+            m_menu->setTitle(tr("Suggestions"));
+    }
+
+    std::unique_ptr<QMenu> AutoInsight::createMenu()
+    {
+        auto menu = std::make_unique<QMenu>(tr("Suggestions"));
+        for (QString const& s : m_suggestions) {
+            // Suggestions that only remove text or change whitespace would otherwise show up as blank entries
+            QString label = s;
+            if (s.isEmpty())
+                label = tr("Remove");
+            else if (s.startsWith(' ') || s.endsWith(' '))
+                label.replace(' ', QChar(0x2423));
+            auto* act = new QAction(label, menu.get());
+            connect(act, &QAction::triggered, [this, s] {
+                replaceMarkedText(s);
+            });
+            menu->addAction(act);
+        }
+        return menu;
     }
 }
\ No newline at end of file
@@ -11,29 +11,34 @@
 
 namespace novelist {
     BaseInsight::BaseInsight(gsl::not_null<SceneDocument*> doc, int left, int right, QString msg)
-            :m_cursor(doc),
-             m_message(std::move(msg))
+            :m_document(doc),
+             m_positions(&doc->insightManager().positions()),
+             m_message(doc->stringPool()->intern(msg))
     {
-        int const textLength = document()->toRawText().length();
-        if (left < 0 || right < 0 || left > textLength || right > textLength)
+        int const textLength = document()->characterCount() - 1; // Excludes the final paragraph separator
+        if (!isValidInsightRange(left, right, textLength))
             throw std::out_of_range("The range [" + std::to_string(left) + ", " + std::to_string(right) +
                     "] is not in the allowed range of the document [0, " + std::to_string(textLength) + "].");
 
         if (left > right)
             std::swap(left, right);
 
-        m_cursor.setPosition(left);
-        m_cursor.setPosition(right, QTextCursor::MoveMode::KeepAnchor);
+        m_handle = m_positions->add(left, right);
+    }
+
+    BaseInsight::~BaseInsight() noexcept
+    {
+        m_positions->remove(m_handle);
     }
 
     SceneDocument* BaseInsight::document() const noexcept
     {
-        return dynamic_cast<SceneDocument*>(m_cursor.document());
+        return m_document;
     }
 
     std::pair<int, int> BaseInsight::range() const noexcept
     {
-        return std::make_pair(m_cursor.selectionStart(), m_cursor.selectionEnd());
+        return m_positions->range(m_handle);
     }
 
     QString const& BaseInsight::message() const noexcept
@@ -43,7 +48,7 @@ namespace novelist {
 
     void BaseInsight::setMessage(QString const& msg) noexcept
     {
-        m_message = msg;
+        m_message = m_document->stringPool()->intern(msg);
     }
 
     QString const& BaseInsight::category() const noexcept
@@ -53,12 +58,19 @@ namespace novelist {
 
     void BaseInsight::setCategory(QString const& category) noexcept
     {
-        m_category = category;
+        m_category = m_document->stringPool()->intern(category);
     }
 
     void BaseInsight::replaceMarkedText(QString const& text) noexcept
     {
-        m_cursor.insertText(text);
+        auto const [left, right] = range();
+        QTextCursor cursor(m_document);
+        cursor.setPosition(left);
+        cursor.setPosition(right, QTextCursor::MoveMode::KeepAnchor);
+
+        // The insight collapses on the replaced text and is removed, even if the replacement has the same length
+        m_positions->setRange(m_handle, left, left);
+        cursor.insertText(text);
     }
 
     void BaseInsight::postRemoveEvent() noexcept
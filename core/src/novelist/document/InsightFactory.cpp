@@ -0,0 +1,46 @@
+/**********************************************************
+ * @file   InsightFactory.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#include "document/InsightFactory.h"
+#include "document/SceneDocument.h"
+#include "document/SpellingInsight.h"
+#include "document/GrammarInsight.h"
+#include "document/TypographyInsight.h"
+
+namespace novelist {
+    std::vector<std::unique_ptr<Insight>> createInsights(gsl::not_null<SceneDocument*> doc,
+            std::vector<InsightBatchEntry> const& batch) noexcept
+    {
+        int const textLength = doc->characterCount() - 1;
+
+        std::vector<std::unique_ptr<Insight>> insights;
+        insights.reserve(batch.size());
+        for (auto const& entry : batch) {
+            if (entry.m_factory == nullptr || !isValidInsightRange(entry.m_left, entry.m_right, textLength))
+                continue;
+            if (auto insight = entry.m_factory->create(doc, entry.m_left, entry.m_right))
+                insights.push_back(std::move(insight));
+        }
+        return insights;
+    }
+
+    std::shared_ptr<InsightFactory> makeInsightFactory(InsightFactoryDescription const& description) noexcept
+    {
+        auto const& type = description.m_type;
+        if (type == SpellingInsight::staticMetaObject.className())
+            return std::make_shared<AutoInsightFactory<SpellingInsight>>(description.m_message,
+                    description.m_suggestions);
+        if (type == GrammarInsight::staticMetaObject.className())
+            return std::make_shared<AutoInsightFactory<GrammarInsight>>(description.m_message,
+                    description.m_suggestions);
+        if (type == TypographyInsight::staticMetaObject.className())
+            return std::make_shared<AutoInsightFactory<TypographyInsight>>(description.m_message,
+                    description.m_suggestions);
+        return nullptr;
+    }
+}
@@ -0,0 +1,63 @@
+/**********************************************************
+ * @file   PositionTracker.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#include <gsl/gsl>
+#include "document/PositionTracker.h"
+
+namespace novelist {
+    auto PositionTracker::add(int left, int right) -> Handle
+    {
+        Expects(left <= right);
+
+        if (!m_free.empty()) {
+            Handle handle = m_free.back();
+            m_free.pop_back();
+            m_ranges[handle] = {left, right};
+            return handle;
+        }
+        m_ranges.emplace_back(left, right);
+        return gsl::narrow<Handle>(m_ranges.size() - 1);
+    }
+
+    void PositionTracker::remove(Handle handle) noexcept
+    {
+        m_free.push_back(handle);
+    }
+
+    void PositionTracker::setRange(Handle handle, int left, int right) noexcept
+    {
+        m_ranges[handle] = {left, right};
+    }
+
+    std::pair<int, int> PositionTracker::range(Handle handle) const noexcept
+    {
+        return m_ranges[handle];
+    }
+
+    void PositionTracker::update(int position, int charsRemoved, int charsAdded) noexcept
+    {
+        int const removedEnd = position + charsRemoved;
+        int const delta = charsAdded - charsRemoved;
+        auto move = [position, removedEnd, charsAdded, delta](int& pos) {
+            if (pos >= removedEnd)
+                pos += delta;
+            else if (pos >= position)
+                pos = position + charsAdded;
+        };
+        // Free slots are moved as well, that's cheaper than telling them apart
+        for (auto& [left, right] : m_ranges) {
+            move(left);
+            move(right);
+        }
+    }
+
+    size_t PositionTracker::size() const noexcept
+    {
+        return m_ranges.size() - m_free.size();
+    }
+}
@@ -127,6 +127,27 @@ namespace novelist {
         m_lang = lang;
     }
 
+    std::shared_ptr<InspectionCache> const& SceneDocument::inspectionCache() const noexcept
+    {
+        return m_inspectionCache;
+    }
+
+    void SceneDocument::setInspectionCache(std::shared_ptr<InspectionCache> cache) noexcept
+    {
+        m_inspectionCache = std::move(cache);
+    }
+
+    std::shared_ptr<StringPool> const& SceneDocument::stringPool() const noexcept
+    {
+        return m_stringPool;
+    }
+
+    void SceneDocument::setStringPool(std::shared_ptr<StringPool> pool) noexcept
+    {
+        Expects(pool != nullptr);
+        m_stringPool = std::move(pool);
+    }
+
     bool SceneDocument::operator==(SceneDocument const& other) const
     {
         if (blockCount() != other.blockCount())
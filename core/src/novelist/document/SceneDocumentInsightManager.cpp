@@ -6,10 +6,14 @@
  * @brief
  * @details
  **********************************************************/
+#include <algorithm>
+#include <limits>
 #include <gsl/gsl>
 #include <QtCore/QCoreApplication>
+#include <QtCore/QHash>
 #include "document/SceneDocumentInsightManager.h"
 #include "document/SceneDocument.h"
+#include "util/Profiler.h"
 
 namespace novelist {
     namespace internal {
@@ -18,22 +22,80 @@ namespace novelist {
                  m_insight(insight)
         {
         }
+
+        RemoveCollapsedInsightsEvent::RemoveCollapsedInsightsEvent()
+                :QEvent(s_eventId)
+        {
+        }
+    }
+
+    SceneDocumentInsightManager::SceneDocumentInsightManager(QTextDocument* parent)
+            :QSyntaxHighlighter(static_cast<QObject*>(parent))
+    {
+        // Insight ranges have to be up to date before the base class rehighlights changed blocks, so the document is
+        // only set after connecting
+        connect(parent, &QTextDocument::blockCountChanged, this, &SceneDocumentInsightManager::updateLargeDocumentMode);
+        connect(parent, &QTextDocument::contentsChange, this, &SceneDocumentInsightManager::onContentsChange);
+        setDocument(parent);
+        updateTextHashes(0, parent->characterCount());
     }
 
     int SceneDocumentInsightManager::insert(std::unique_ptr<Insight> insight)
     {
+        NOVELIST_PROFILE_SCOPE("SceneDocumentInsightManager::insert");
+
+        invalidateMaxEnds();
         auto iter = m_insights.insert(std::move(insight));
         rehighlight(iter->get());
+        if (empty(**iter))
+            scheduleRemoval(iter->get());
         return gsl::narrow_cast<int>(std::distance(m_insights.begin(), iter));
     }
 
     int SceneDocumentInsightManager::insert(std::unique_ptr<Insight> insight, SVector::const_iterator hint)
     {
+        NOVELIST_PROFILE_SCOPE("SceneDocumentInsightManager::insert");
+
+        invalidateMaxEnds();
         auto iter = m_insights.insert(std::move(insight), hint);
         rehighlight(iter->get());
+        if (empty(**iter))
+            scheduleRemoval(iter->get());
         return gsl::narrow_cast<int>(std::distance(m_insights.begin(), iter));
     }
 
+    void SceneDocumentInsightManager::insert(std::vector<std::unique_ptr<Insight>> insights)
+    {
+        NOVELIST_PROFILE_SCOPE("SceneDocumentInsightManager::insert");
+
+        beginBatch();
+        for (auto const& insight : insights) {
+            rehighlight(insight.get());
+            if (empty(*insight))
+                scheduleRemoval(insight.get());
+        }
+        invalidateMaxEnds();
+        m_insights.merge(std::make_move_iterator(insights.begin()), std::make_move_iterator(insights.end()));
+        endBatch();
+    }
+
+    void SceneDocumentInsightManager::beginBatch() noexcept
+    {
+        ++m_batchDepth;
+    }
+
+    void SceneDocumentInsightManager::endBatch()
+    {
+        Expects(m_batchDepth > 0);
+
+        if (--m_batchDepth > 0)
+            return;
+
+        for (auto const& [first, last] : m_batchBlocks)
+            rehighlight(std::make_pair(first, last - 1));
+        m_batchBlocks.clear();
+    }
+
     auto SceneDocumentInsightManager::begin() const noexcept -> SVector::const_iterator
     {
         return m_insights.begin();
@@ -47,11 +109,32 @@ namespace novelist {
     auto SceneDocumentInsightManager::erase(SVector::const_iterator iter) noexcept -> SVector::const_iterator
     {
         auto parRange = novelist::parRange(**iter);
+        forgetCollapsed(iter, iter + 1);
+        invalidateMaxEnds();
         auto afterIter = m_insights.erase(iter);
         rehighlight(parRange);
         return afterIter;
     }
 
+    auto SceneDocumentInsightManager::erase(SVector::const_iterator first, SVector::const_iterator last) noexcept
+    -> SVector::const_iterator
+    {
+        beginBatch();
+        for (auto iter = first; iter != last; ++iter)
+            rehighlight(iter->get());
+        forgetCollapsed(first, last);
+        invalidateMaxEnds();
+        auto afterIter = m_insights.erase(first, last);
+        endBatch();
+        return afterIter;
+    }
+
+    std::pair<int, int> SceneDocumentInsightManager::findOverlapping(int start, int end) const noexcept
+    {
+        int const last = gsl::narrow_cast<int>(std::distance(m_insights.begin(), firstStartingAt(end)));
+        return {std::min(firstEndingAfter(start), last), last};
+    }
+
     size_t SceneDocumentInsightManager::size() const noexcept
     {
         return m_insights.size();
@@ -59,50 +142,107 @@ namespace novelist {
 
     void SceneDocumentInsightManager::clear() noexcept
     {
+        m_collapsed.clear();
+        invalidateMaxEnds();
         m_insights.clear();
     }
 
+    PositionTracker& SceneDocumentInsightManager::positions() noexcept
+    {
+        return m_positions;
+    }
+
+    void SceneDocumentInsightManager::setLargeDocumentThreshold(int blockCount) noexcept
+    {
+        m_largeDocThreshold = blockCount;
+        updateLargeDocumentMode();
+    }
+
+    int SceneDocumentInsightManager::largeDocumentThreshold() const noexcept
+    {
+        return m_largeDocThreshold;
+    }
+
+    bool SceneDocumentInsightManager::isLargeDocument() const noexcept
+    {
+        return m_largeDocThreshold > 0 && document() != nullptr && document()->blockCount() > m_largeDocThreshold;
+    }
+
+    void SceneDocumentInsightManager::setVisibleBlocks(int first, int last) noexcept
+    {
+        m_firstVisibleBlock = first;
+        m_lastVisibleBlock = last;
+
+        if (!isLargeDocument())
+            return;
+
+        int blockNum = std::max(0, first - s_visibleMargin);
+        for (auto block = document()->findBlockByNumber(blockNum);
+             block.isValid() && blockNum <= last + s_visibleMargin;
+             block = block.next(), ++blockNum) {
+            auto const* data = static_cast<internal::InsightBlockData const*>(block.userData());
+            if (data != nullptr && data->m_deferred)
+                rehighlightBlock(block);
+        }
+    }
+
     bool SceneDocumentInsightManager::event(QEvent* event)
     {
-        auto* removeTextMarkerEvent = dynamic_cast<internal::RemoveInsightEvent*>(event);
-        if (removeTextMarkerEvent) {
+        if (event->type() == internal::RemoveInsightEvent::s_eventId) {
+            auto* removeTextMarkerEvent = static_cast<internal::RemoveInsightEvent*>(event);
             findAndAutoRemove(removeTextMarkerEvent->m_insight);
             removeTextMarkerEvent->accept();
         }
+        else if (event->type() == internal::RemoveCollapsedInsightsEvent::s_eventId) {
+            removeCollapsed();
+            event->accept();
+        }
         return QObject::event(event);
     }
 
     void SceneDocumentInsightManager::highlightBlock(QString const&)
     {
+        NOVELIST_PROFILE_SCOPE("SceneDocumentInsightManager::highlightBlock");
+
         // Block state stores an index into the insights vector, indicating the first insight that might be relevant
         // for the next block. This information is updated every time a block is highlighted.
-        auto thisBlockState = previousBlockState() >= 0 ? previousBlockState() : 0;
-        bool blockStateChanged = false;
-        bool foundValidInsight = false;
+        // In large documents, blocks outside of the visible area are only marked and highlighted once they become
+        // visible. The block state is left untouched there, which keeps QSyntaxHighlighter from cascading through all
+        // following blocks; since states may therefore be stale, the first relevant insight is looked up instead.
         int blockNum = currentBlock().blockNumber();
         int blockPos = currentBlock().position();
+        bool const largeDoc = isLargeDocument();
+        if (largeDoc && !isInHighlightWindow(blockNum)) {
+            markDeferred(currentBlock());
+            return;
+        }
+        if (auto* data = static_cast<internal::InsightBlockData*>(currentBlockUserData()))
+            data->m_deferred = false;
+
+        auto thisBlockState = largeDoc ? firstRelevantInsight(blockNum, blockPos)
+                                       : (previousBlockState() >= 0 ? previousBlockState() : 0);
+        bool blockStateChanged = false;
         auto coversCurBlock = [this, blockNum](int i) {
             return parRange(*m_insights[i]).first <= blockNum && parRange(*m_insights[i]).second >= blockNum;
         };
+        // Insights that don't cover this block may sit between ones that do, e.g. a short insight in an earlier block
+        // behind a note that spans several blocks, so only insights starting after this block end the search
+        int const blockEnd = blockPos + currentBlock().length();
         for (int i = thisBlockState;
-             i < gsl::narrow_cast<int>(m_insights.size()) && (!foundValidInsight || coversCurBlock(i));
+             i < gsl::narrow_cast<int>(m_insights.size()) && m_insights[i]->range().first < blockEnd;
              ++i) {
 
             auto const& m = m_insights[i];
             auto const& range = m->range();
             auto const& parRange = novelist::parRange(*m);
 
-            // If insight has zero length, mark it for removal and continue
-            if (empty(*m)) {
-                QCoreApplication::postEvent(this, new internal::RemoveInsightEvent(m.get()));
+            // Insights with zero length are about to be removed, see onContentsChange()
+            if (empty(*m))
                 continue;
-            }
 
             // Skip if marker doesn't cover this block
             if (!coversCurBlock(i))
                 continue;
-            else
-                foundValidInsight = true;
 
             // Save the first item that spans into this paragraph
             if (parRange.second > blockNum && !blockStateChanged) {
@@ -123,7 +263,65 @@ namespace novelist {
             }();
             setFormat(start, end - start, m->format());
         }
-        setCurrentBlockState(thisBlockState);
+        if (!largeDoc)
+            setCurrentBlockState(thisBlockState);
+    }
+
+    void SceneDocumentInsightManager::updateLargeDocumentMode()
+    {
+        bool const largeDoc = isLargeDocument();
+        if (largeDoc == m_wasLargeDoc)
+            return;
+        m_wasLargeDoc = largeDoc;
+
+        // Block states are stale after large-document mode, so everything has to be highlighted once
+        if (!largeDoc)
+            QSyntaxHighlighter::rehighlight();
+    }
+
+    bool SceneDocumentInsightManager::isInHighlightWindow(int blockNum) const noexcept
+    {
+        return blockNum >= m_firstVisibleBlock - s_visibleMargin && blockNum <= m_lastVisibleBlock + s_visibleMargin;
+    }
+
+    void SceneDocumentInsightManager::markDeferred(QTextBlock block) const
+    {
+        auto* data = static_cast<internal::InsightBlockData*>(block.userData());
+        if (data == nullptr) {
+            data = new internal::InsightBlockData;
+            data->m_textHash = qHash(block.text());
+            block.setUserData(data);
+        }
+        data->m_deferred = true;
+    }
+
+    int SceneDocumentInsightManager::firstRelevantInsight(int /*blockNum*/, int blockPos) const noexcept
+    {
+        // Every insight in front of the first one that reaches this block ends before it
+        return firstEndingAfter(blockPos - 1);
+    }
+
+    int SceneDocumentInsightManager::firstEndingAfter(int pos) const noexcept
+    {
+        // Insights are sorted by their start, not their end, so a long insight might reach further than any of the
+        // insights behind it. The running maximum of their ends is sorted though.
+        if (!m_maxEndsValid) {
+            m_maxEnds.clear();
+            m_maxEnds.reserve(m_insights.size());
+            int maxEnd = std::numeric_limits<int>::min();
+            for (auto const& m : m_insights) {
+                maxEnd = std::max(maxEnd, m->range().second);
+                m_maxEnds.push_back(maxEnd);
+            }
+            m_maxEndsValid = true;
+        }
+        return gsl::narrow_cast<int>(std::distance(m_maxEnds.begin(),
+                std::upper_bound(m_maxEnds.begin(), m_maxEnds.end(), pos)));
+    }
+
+    void SceneDocumentInsightManager::invalidateMaxEnds() noexcept
+    {
+        m_maxEndsValid = false;
     }
 
     void SceneDocumentInsightManager::findAndAutoRemove(Insight const* insight)
@@ -134,12 +332,115 @@ namespace novelist {
                 });
         if (iter != m_insights.end()) {
             auto index = gsl::narrow_cast<int>(std::distance(m_insights.begin(), iter));
-            emit aboutToAutoRemove(index);
+            emit aboutToAutoRemove(index, index);
             erase(iter);
-            emit autoRemoved(index);
+            emit autoRemoved(index, index);
+        }
+    }
+
+    auto SceneDocumentInsightManager::firstStartingAt(int pos) const noexcept -> SVector::const_iterator
+    {
+        // Only compare the start, insights with equal starts aren't necessarily in order anymore after text removal
+        return std::partition_point(m_insights.begin(), m_insights.end(),
+                [pos](std::unique_ptr<Insight> const& m) {
+                    return m->range().first < pos;
+                });
+    }
+
+    bool SceneDocumentInsightManager::updateTextHashes(int position, int count)
+    {
+        // Blocks without data haven't been seen yet, so their text counts as changed
+        bool changed = false;
+        for (auto block = document()->findBlock(position);
+             block.isValid() && block.position() <= position + count;
+             block = block.next()) {
+            uint const hash = qHash(block.text());
+            auto* data = static_cast<internal::InsightBlockData*>(block.userData());
+            if (data == nullptr) {
+                data = new internal::InsightBlockData;
+                block.setUserData(data);
+                changed = true;
+            }
+            else if (data->m_textHash != hash)
+                changed = true;
+            data->m_textHash = hash;
+        }
+        return changed;
+    }
+
+    void SceneDocumentInsightManager::onContentsChange(int position, int charsRemoved, int charsAdded)
+    {
+        // Formatting changes, e.g. by highlighting, are reported as replacing text with the same amount of characters.
+        // Only an actual change of the text moves insights. Only the blocks covered by the change are compared.
+        if (!updateTextHashes(position, charsAdded) && charsRemoved == charsAdded)
+            return;
+
+        m_positions.update(position, charsRemoved, charsAdded);
+        invalidateMaxEnds();
+
+        if (charsRemoved <= 0)
+            return;
+
+        // Insights within removed text collapse onto the position of the change. If text was inserted at the same
+        // time, they might have been pushed behind it.
+        for (auto iter = firstStartingAt(position);
+             iter != m_insights.end() && (*iter)->range().first <= position + charsAdded;
+             ++iter) {
+            if (empty(**iter))
+                scheduleRemoval(iter->get());
         }
     }
 
+    void SceneDocumentInsightManager::scheduleRemoval(Insight const* insight)
+    {
+        // A single event removes everything that collapsed until it is processed
+        if (m_collapsed.empty())
+            QCoreApplication::postEvent(this, new internal::RemoveCollapsedInsightsEvent);
+        m_collapsed.insert(insight);
+    }
+
+    void SceneDocumentInsightManager::removeCollapsed()
+    {
+        NOVELIST_PROFILE_SCOPE("SceneDocumentInsightManager::removeCollapsed");
+
+        std::vector<int> indices;
+        indices.reserve(m_collapsed.size());
+        for (auto const* insight : m_collapsed) {
+            int const pos = insight->range().first;
+            auto iter = firstStartingAt(pos);
+            while (iter != m_insights.end() && iter->get() != insight && (*iter)->range().first == pos)
+                ++iter;
+            if (iter != m_insights.end() && iter->get() == insight && empty(*insight))
+                indices.push_back(gsl::narrow_cast<int>(std::distance(m_insights.begin(), iter)));
+        }
+        m_collapsed.clear();
+        if (indices.empty())
+            return;
+
+        // Remove contiguous runs back to front, so indices of the remaining runs stay valid
+        std::sort(indices.begin(), indices.end());
+        beginBatch();
+        for (auto last = indices.rbegin(); last != indices.rend();) {
+            auto first = last;
+            while (std::next(first) != indices.rend() && *std::next(first) == *first - 1)
+                ++first;
+            emit aboutToAutoRemove(*first, *last);
+            erase(m_insights.begin() + *first, m_insights.begin() + *last + 1);
+            emit autoRemoved(*first, *last);
+            last = std::next(first);
+        }
+        endBatch();
+    }
+
+    void SceneDocumentInsightManager::forgetCollapsed(SVector::const_iterator first,
+            SVector::const_iterator last) noexcept
+    {
+        if (m_collapsed.empty())
+            return;
+        for (auto iter = first; iter != last; ++iter)
+            m_collapsed.erase(iter->get());
+    }
+
     typename SceneDocumentInsightManager::SVector::const_iterator
     findInsertIdx(SceneDocumentInsightManager const& mgr, std::unique_ptr<Insight> const& element)
     {
@@ -154,10 +455,19 @@ namespace novelist {
 
     void SceneDocumentInsightManager::rehighlight(std::pair<int, int> const& parRange)
     {
+        if (m_batchDepth > 0) {
+            m_batchBlocks.insert(parRange.first, parRange.second + 1);
+            return;
+        }
+
+        bool const largeDoc = isLargeDocument();
         for (auto block = document()->findBlockByNumber(parRange.first);
              block.isValid() && (block.blockNumber() <= parRange.second);
              block = block.next()) {
-            rehighlightBlock(block);
+            if (largeDoc && !isInHighlightWindow(block.blockNumber()))
+                markDeferred(block);
+            else
+                rehighlightBlock(block);
         }
     }
 }
\ No newline at end of file
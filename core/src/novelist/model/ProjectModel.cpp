@@ -15,6 +15,7 @@
 #include <stack>
 #include "util/Overloaded.h"
 #include "model/ProjectModel.h"
+#include "widgets/texteditor/InspectionCache.h"
 
 namespace novelist {
     ProjectModel::ProjectModel() noexcept
@@ -37,7 +38,8 @@ namespace novelist {
     }
 
     ProjectModel::ProjectModel(ProjectProperties const& properties, QObject* parent) noexcept
-            :QAbstractItemModel(parent)
+            :QAbstractItemModel(parent),
+             m_inspectionCache(std::make_shared<InspectionCache>())
     {
         createRootNodes(properties);
     }
@@ -438,6 +440,8 @@ namespace novelist {
         auto& scene = std::get<SceneData>(*static_cast<Node*>(index.internalPointer())->m_data);
         QString filename = QString::fromStdString(scene.m_id.toString() + ".xml");
         scene.m_doc = std::make_unique<SceneDocument>(properties().m_lang);
+        scene.m_doc->setInspectionCache(m_inspectionCache);
+        scene.m_doc->setStringPool(m_stringPool);
         if (auto d = contentDir(); d.exists(filename)) {
             QFile file {d.path() + QString{"/"} + filename};
             scene.m_doc->read(file);
@@ -610,6 +614,12 @@ namespace novelist {
         QFile file{dir.path() + "/project.xml"};
         bool success = read(file);
         if (success) {
+            // The cache only speeds up inspections, so failing to read it is not an error
+            m_inspectionCache->clear();
+            QFile cacheFile{dir.path() + QDir::separator() + m_inspectionCacheName};
+            if (cacheFile.open(QIODevice::ReadOnly))
+                m_inspectionCache->load(cacheFile);
+
             m_undoStack.clear();
             m_neverSaved = false;
             emit projectOpened(dir);
@@ -652,6 +662,10 @@ namespace novelist {
         });
 
         if (success) {
+            QFile cacheFile{m_saveDir.path() + QDir::separator() + m_inspectionCacheName};
+            if (!cacheFile.open(QIODevice::WriteOnly) || !m_inspectionCache->save(cacheFile))
+                qInfo() << "Writing inspection cache to" << cacheFile.fileName() << "failed";
+
             m_undoStack.setClean();
             m_neverSaved = false;
             emit projectSaved(m_saveDir);
@@ -687,6 +701,11 @@ namespace novelist {
         return m_undoStack;
     }
 
+    std::shared_ptr<InspectionCache> const& ProjectModel::inspectionCache() const noexcept
+    {
+        return m_inspectionCache;
+    }
+
     std::ostream& operator<<(std::ostream& stream, ProjectModel const& model)
     {
         stream << model.m_root;
@@ -920,9 +939,12 @@ namespace novelist {
         switch (type) {
             case InsertableNodeType::Chapter:
                 return std::make_shared<NodeDataUnique>(ChapterData{name, m_chapterIdMgr.generate()});
-            case InsertableNodeType::Scene:
-                return std::make_shared<NodeDataUnique>(SceneData{name, m_sceneIdMgr.generate(),
-                                                                  std::make_unique<SceneDocument>(properties().m_lang)});
+            case InsertableNodeType::Scene: {
+                auto doc = std::make_unique<SceneDocument>(properties().m_lang);
+                doc->setInspectionCache(m_inspectionCache);
+                doc->setStringPool(m_stringPool);
+                return std::make_shared<NodeDataUnique>(SceneData{name, m_sceneIdMgr.generate(), std::move(doc)});
+            }
         }
 
         throw std::runtime_error{"Should never get here. Probably forgot to update switch statement."};
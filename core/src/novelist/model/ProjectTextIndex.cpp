@@ -0,0 +1,435 @@
+/**********************************************************
+ * @file   ProjectTextIndex.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#include <algorithm>
+#include <tuple>
+#include <QtCore/QRegularExpression>
+#include <QtConcurrent/QtConcurrent>
+#include "model/ProjectTextIndex.h"
+#include "document/SceneDocument.h"
+#include "util/Profiler.h"
+
+namespace novelist {
+    namespace {
+        template<typename F>
+        void forEachWord(QString const& text, F f)
+        {
+            int start = -1;
+            for (int i = 0; i <= text.size(); ++i) {
+                bool const inWord = i < text.size() && ProjectTextIndex::isWordCharacter(text[i]);
+                if (inWord && start < 0)
+                    start = i;
+                else if (!inWord && start >= 0) {
+                    f(start, i - start);
+                    start = -1;
+                }
+            }
+        }
+
+        void addSceneTerms(internal::TextIndexTerms& terms, std::vector<QString>& sceneTerms, int sceneId,
+                QString const& text)
+        {
+            forEachWord(text, [&](int offset, int length) {
+                QString term = text.mid(offset, length).toCaseFolded();
+                auto& offsets = terms[term][sceneId];
+                if (offsets.empty())
+                    sceneTerms.push_back(std::move(term));
+                offsets.push_back(offset);
+            });
+        }
+
+        std::shared_ptr<internal::TextIndexBuild> buildIndex(std::vector<std::pair<int, QString>> const& texts)
+        {
+            NOVELIST_PROFILE_SCOPE("ProjectTextIndex::build");
+
+            auto result = std::make_shared<internal::TextIndexBuild>();
+            for (auto const& [sceneId, text] : texts)
+                addSceneTerms(result->m_terms, result->m_sceneTerms[sceneId], sceneId, text);
+            return result;
+        }
+
+        void addOccurrences(std::vector<ProjectTextIndex::Occurrence>& result,
+                std::unordered_map<int, std::vector<int>> const& postings, int shift, int length)
+        {
+            for (auto const& [sceneId, offsets] : postings) {
+                for (int offset : offsets)
+                    result.push_back({sceneId, offset + shift, length});
+            }
+        }
+
+        void sortOccurrences(std::vector<ProjectTextIndex::Occurrence>& occurrences)
+        {
+            std::sort(occurrences.begin(), occurrences.end(), [](auto const& a, auto const& b) {
+                return std::tie(a.m_sceneId, a.m_offset) < std::tie(b.m_sceneId, b.m_offset);
+            });
+        }
+    }
+
+    bool ProjectTextIndex::Occurrence::operator==(Occurrence const& other) const noexcept
+    {
+        return m_sceneId == other.m_sceneId && m_offset == other.m_offset && m_length == other.m_length;
+    }
+
+    ProjectTextIndex::ProjectTextIndex(QObject* parent)
+            :QObject(parent)
+    {
+        m_updateTimer.setSingleShot(true);
+        connect(&m_updateTimer, &QTimer::timeout, this, [this] {
+            // Don't block while the initial build is still running, it triggers another update when it's done
+            if (!isBuilding())
+                update();
+        });
+        connect(&m_buildWatcher, &QFutureWatcher<std::shared_ptr<internal::TextIndexBuild>>::finished, this,
+                &ProjectTextIndex::finishBuild);
+    }
+
+    ProjectTextIndex::~ProjectTextIndex() noexcept
+    {
+        if (m_build.isRunning())
+            m_build.waitForFinished();
+    }
+
+    void ProjectTextIndex::setProject(ProjectModel* model)
+    {
+        m_modelConnections.clear();
+        m_model = model;
+        if (m_model != nullptr) {
+            m_modelConnections.emplace_back(connect(m_model, &QObject::destroyed, this, [this] { setProject(nullptr); }));
+            m_modelConnections.emplace_back(connect(m_model, &ProjectModel::rowsInserted, this,
+                    &ProjectTextIndex::onStructureChanged));
+            m_modelConnections.emplace_back(connect(m_model, &ProjectModel::rowsRemoved, this,
+                    &ProjectTextIndex::onStructureChanged));
+            m_modelConnections.emplace_back(connect(m_model, &ProjectModel::rowsMoved, this,
+                    &ProjectTextIndex::onStructureChanged));
+            m_modelConnections.emplace_back(connect(m_model, &ProjectModel::modelReset, this,
+                    &ProjectTextIndex::rebuild));
+            m_modelConnections.emplace_back(connect(m_model, &ProjectModel::projectOpened, this,
+                    &ProjectTextIndex::rebuild));
+        }
+        rebuild();
+    }
+
+    ProjectModel* ProjectTextIndex::project() const noexcept
+    {
+        return m_model;
+    }
+
+    bool ProjectTextIndex::isBuilding() const noexcept
+    {
+        return m_buildPending;
+    }
+
+    void ProjectTextIndex::update()
+    {
+        NOVELIST_PROFILE_SCOPE("ProjectTextIndex::update");
+
+        m_updateTimer.stop();
+        if (m_buildPending) {
+            m_build.waitForFinished();
+            finishBuild();
+        }
+        if (m_model == nullptr)
+            return;
+
+        // Walking the project is cheap compared to indexing, and it also catches scenes that were loaded or unloaded
+        syncStructure();
+        for (auto& [id, scene] : m_scenes) {
+            if (scene.m_dirty)
+                indexScene(id, scene);
+        }
+    }
+
+    std::vector<ProjectTextIndex::Occurrence> ProjectTextIndex::findWord(QString const& word)
+    {
+        update();
+
+        std::vector<Occurrence> result;
+        if (!isWord(word))
+            return result;
+        if (auto iter = m_terms.find(word.toCaseFolded()); iter != m_terms.end())
+            addOccurrences(result, iter->second, 0, word.size());
+        sortOccurrences(result);
+        return result;
+    }
+
+    std::vector<ProjectTextIndex::Occurrence> ProjectTextIndex::findPrefix(QString const& prefix)
+    {
+        update();
+
+        std::vector<Occurrence> result;
+        if (!isWord(prefix))
+            return result;
+        // Terms are sorted, so all terms starting with the prefix are next to each other
+        QString const folded = prefix.toCaseFolded();
+        for (auto iter = m_terms.lower_bound(folded); iter != m_terms.end() && iter->first.startsWith(folded); ++iter)
+            addOccurrences(result, iter->second, 0, iter->first.size());
+        sortOccurrences(result);
+        return result;
+    }
+
+    std::vector<ProjectTextIndex::Occurrence> ProjectTextIndex::findPart(QString const& part)
+    {
+        update();
+
+        std::vector<Occurrence> result;
+        if (!isWord(part))
+            return result;
+        // There are far less distinct words than words in a project, so scanning them is still fast
+        QString const folded = part.toCaseFolded();
+        for (auto const& [term, postings] : m_terms) {
+            for (int pos = term.indexOf(folded); pos >= 0; pos = term.indexOf(folded, pos + folded.size()))
+                addOccurrences(result, postings, pos, folded.size());
+        }
+        sortOccurrences(result);
+        return result;
+    }
+
+    std::optional<std::unordered_set<int>> ProjectTextIndex::candidateScenes(QString const& phrase, bool regex)
+    {
+        NOVELIST_PROFILE_SCOPE("ProjectTextIndex::candidateScenes");
+
+        QStringList parts = requiredParts(phrase, regex);
+        if (parts.isEmpty())
+            return std::nullopt;
+
+        update();
+
+        // Long parts tend to be rare, so starting with them keeps the candidate set small
+        std::sort(parts.begin(), parts.end(), [](QString const& a, QString const& b) { return a.size() > b.size(); });
+        std::optional<std::unordered_set<int>> candidates;
+        for (QString const& part : parts) {
+            QString const folded = part.toCaseFolded();
+            std::unordered_set<int> scenes;
+            for (auto const& [term, postings] : m_terms) {
+                if (!term.contains(folded))
+                    continue;
+                for (auto const& posting : postings) {
+                    if (!candidates || candidates->count(posting.first) > 0)
+                        scenes.insert(posting.first);
+                }
+            }
+            candidates = std::move(scenes);
+            if (candidates->empty())
+                break;
+        }
+        return candidates;
+    }
+
+    int ProjectTextIndex::sceneId(ProjectModel const& model, QModelIndex const& index)
+    {
+        if (auto const* scene = std::get_if<ProjectModel::SceneData>(model.nodeData(index).get()))
+            return static_cast<int>(scene->m_id.id());
+        return -1;
+    }
+
+    bool ProjectTextIndex::isWordCharacter(QChar c) noexcept
+    {
+        // Surrogates are kept together so that words are never split in the middle of a character
+        return c.isLetterOrNumber() || c.isMark() || c.isSurrogate();
+    }
+
+    bool ProjectTextIndex::isWord(QString const& text) noexcept
+    {
+        return !text.isEmpty() && std::all_of(text.begin(), text.end(), isWordCharacter);
+    }
+
+    QStringList ProjectTextIndex::requiredParts(QString const& phrase, bool regex)
+    {
+        QStringList parts;
+        QString run;
+        auto flush = [&parts, &run] {
+            if (!run.isEmpty())
+                parts.push_back(run);
+            run.clear();
+        };
+
+        if (!regex) {
+            forEachWord(phrase, [&](int offset, int length) { parts.push_back(phrase.mid(offset, length)); });
+            return parts;
+        }
+
+        // Only literal text outside of groups and character classes is required by every match. Alternatives and
+        // extended syntax are too hard to reason about, all scenes have to be scanned for them.
+        static QRegularExpression const extendedSyntax(R"(\(\?\^?[a-zA-Z]*x)");
+        if (phrase.contains('|') || phrase.contains(extendedSyntax))
+            return {};
+
+        int depth = 0;
+        bool inClass = false;
+        for (int i = 0; i < phrase.size(); ++i) {
+            QChar const c = phrase[i];
+            if (inClass) {
+                if (c == '\\')
+                    ++i;
+                else if (c == ']')
+                    inClass = false;
+                continue;
+            }
+
+            if (c == '\\') {
+                flush();
+                if (i + 1 < phrase.size()) {
+                    // Escaped letters and digits might stand for anything, e.g. \x41 or \p{L}. Escaped punctuation is
+                    // still literal, but not part of a word.
+                    QChar const escaped = phrase[++i];
+                    if (escaped.isLetterOrNumber() && !QStringLiteral("wWdDsSbBAzZG").contains(escaped))
+                        return {};
+                }
+            }
+            else if (c == '[') {
+                flush();
+                inClass = true;
+                if (i + 1 < phrase.size() && phrase[i + 1] == '^')
+                    ++i;
+                if (i + 1 < phrase.size() && phrase[i + 1] == ']')
+                    ++i;
+            }
+            else if (c == '(') {
+                flush();
+                ++depth;
+            }
+            else if (c == ')') {
+                flush();
+                --depth;
+            }
+            else if (c == '?' || c == '*' || c == '{') {
+                // The character before might not be part of the match at all
+                run.chop(1);
+                flush();
+                if (c == '{') {
+                    while (i + 1 < phrase.size() && phrase[i] != '}')
+                        ++i;
+                }
+            }
+            else if (depth == 0 && isWordCharacter(c))
+                run += c;
+            else
+                flush();
+        }
+        flush();
+        return parts;
+    }
+
+    void ProjectTextIndex::rebuild()
+    {
+        // A running build belongs to a previous state of the project
+        if (m_build.isRunning())
+            m_build.waitForFinished();
+        m_buildPending = false;
+        m_updateTimer.stop();
+        m_terms.clear();
+        m_scenes.clear();
+        if (m_model == nullptr)
+            return;
+
+        // Documents can only be read on this thread, but taking their text is quick compared to indexing it
+        syncStructure();
+        std::vector<std::pair<int, QString>> texts;
+        texts.reserve(m_scenes.size());
+        for (auto& [id, scene] : m_scenes) {
+            if (scene.m_doc != nullptr) {
+                texts.emplace_back(id, scene.m_doc->toRawText());
+                scene.m_dirty = false;
+            }
+        }
+        m_build = QtConcurrent::run(buildIndex, std::move(texts));
+        m_buildPending = true;
+        m_buildWatcher.setFuture(m_build);
+    }
+
+    void ProjectTextIndex::finishBuild()
+    {
+        // The watcher might still report a build that was replaced in the meantime
+        if (!m_buildPending || !m_build.isFinished())
+            return;
+        m_buildPending = false;
+
+        // Scenes aren't added or removed while the build is running, that happens on the next update
+        std::shared_ptr<internal::TextIndexBuild> result = m_build.result();
+        m_build = QFuture<std::shared_ptr<internal::TextIndexBuild>>();
+        m_terms = std::move(result->m_terms);
+        for (auto& [id, terms] : result->m_sceneTerms) {
+            if (auto iter = m_scenes.find(id); iter != m_scenes.end())
+                iter->second.m_terms = std::move(terms);
+        }
+
+        emit built();
+        m_updateTimer.start(0);
+    }
+
+    void ProjectTextIndex::onStructureChanged()
+    {
+        m_updateTimer.start(s_updateDelay);
+    }
+
+    void ProjectTextIndex::onContentsChanged(int sceneId)
+    {
+        if (auto iter = m_scenes.find(sceneId); iter != m_scenes.end())
+            iter->second.m_dirty = true;
+        m_updateTimer.start(s_updateDelay);
+    }
+
+    void ProjectTextIndex::syncStructure()
+    {
+        std::unordered_set<int> present;
+        std::vector<QModelIndex> pending{m_model->notebookIndex(), m_model->projectRootIndex()};
+        while (!pending.empty()) {
+            QModelIndex index = pending.back();
+            pending.pop_back();
+            if (m_model->nodeType(index) == ProjectModel::NodeType::Scene) {
+                int const id = sceneId(*m_model, index);
+                auto* doc = qvariant_cast<SceneDocument*>(m_model->data(index, ProjectModel::DocumentRole));
+                present.insert(id);
+
+                // Scenes that were loaded again or unloaded have to be indexed again
+                Scene& scene = m_scenes[id];
+                if (scene.m_doc != doc || (doc == nullptr && !scene.m_terms.empty())) {
+                    scene.m_doc = doc;
+                    scene.m_contentsConnection.disconnect();
+                    if (doc != nullptr) {
+                        scene.m_contentsConnection = connect(doc, &SceneDocument::contentsChange, this,
+                                [this, id](int /*pos*/, int /*removed*/, int /*added*/) { onContentsChanged(id); });
+                    }
+                    scene.m_dirty = true;
+                }
+            }
+            for (int r = m_model->rowCount(index) - 1; r >= 0; --r)
+                pending.push_back(m_model->index(r, 0, index));
+        }
+
+        for (auto iter = m_scenes.begin(); iter != m_scenes.end();) {
+            if (present.count(iter->first) == 0) {
+                removeScene(iter->first, iter->second);
+                iter = m_scenes.erase(iter);
+            }
+            else
+                ++iter;
+        }
+    }
+
+    void ProjectTextIndex::indexScene(int sceneId, Scene& scene)
+    {
+        removeScene(sceneId, scene);
+        scene.m_dirty = false;
+        if (scene.m_doc != nullptr)
+            addSceneTerms(m_terms, scene.m_terms, sceneId, scene.m_doc->toRawText());
+    }
+
+    void ProjectTextIndex::removeScene(int sceneId, Scene& scene)
+    {
+        for (QString const& term : scene.m_terms) {
+            auto iter = m_terms.find(term);
+            if (iter == m_terms.end())
+                continue;
+            iter->second.erase(sceneId);
+            if (iter->second.empty())
+                m_terms.erase(iter);
+        }
+        scene.m_terms.clear();
+    }
+}
@@ -0,0 +1,114 @@
+/**********************************************************
+ * @file   SettingsPage_Diagnostics.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#include <QtCore/QEvent>
+#include <QtGui/QFontDatabase>
+#include "settings/SettingsPage_Diagnostics.h"
+#include "ui_SettingsPage_Diagnostics.h"
+#include "widgets/texteditor/InspectionMetrics.h"
+
+namespace novelist {
+    SettingsPage_Diagnostics::SettingsPage_Diagnostics(QWidget* parent, Qt::WindowFlags f)
+            :QWidget(parent, f),
+             m_ui{std::make_unique<Ui::SettingsPage_Diagnostics>()}
+    {
+        m_ui->setupUi(this);
+        m_ui->plainTextEditMetrics->setFont(QFontDatabase::systemFont(QFontDatabase::SystemFont::FixedFont));
+        connect(m_ui->checkBoxDump, &QCheckBox::toggled, m_ui->spinBoxDumpInterval, &QSpinBox::setEnabled);
+        connect(m_ui->pushButtonRefresh, &QPushButton::clicked, this, &SettingsPage_Diagnostics::refresh);
+        refresh();
+    }
+
+    SettingsPage_Diagnostics::~SettingsPage_Diagnostics() = default;
+
+    void SettingsPage_Diagnostics::retranslateUi()
+    {
+        m_ui->retranslateUi(this);
+    }
+
+    void SettingsPage_Diagnostics::refresh()
+    {
+        m_ui->plainTextEditMetrics->setPlainText(InspectionMetrics::instance().report());
+    }
+
+    void SettingsPage_Diagnostics::changeEvent(QEvent* event)
+    {
+        QWidget::changeEvent(event);
+        switch (event->type()) {
+            case QEvent::LanguageChange:
+                retranslateUi();
+                break;
+            default:
+                break;
+        }
+    }
+
+    SettingsPage_Diagnostics_Creator::SettingsPage_Diagnostics_Creator() noexcept
+    {
+        connect(&m_dumpTimer, &QTimer::timeout, [] { InspectionMetrics::instance().dumpToLog(); });
+    }
+
+    QString SettingsPage_Diagnostics_Creator::name() noexcept
+    {
+        return QObject::tr("Diagnostics", "SettingsPage_Diagnostics");
+    }
+
+    QString SettingsPage_Diagnostics_Creator::uid() noexcept
+    {
+        return "diagnostics";
+    }
+
+    void SettingsPage_Diagnostics_Creator::initialize(QWidget* widget, QSettings const& settings) noexcept
+    {
+        auto* page = dynamic_cast<SettingsPage_Diagnostics*>(widget);
+
+        restoreDefaults(widget);
+
+        if (settings.contains("metrics_dump_interval")) {
+            int dumpInterval = settings.value("metrics_dump_interval").toInt();
+            page->m_ui->checkBoxDump->setChecked(dumpInterval > 0);
+            if (dumpInterval > 0)
+                page->m_ui->spinBoxDumpInterval->setValue(dumpInterval);
+        }
+    }
+
+    void SettingsPage_Diagnostics_Creator::apply(QWidget const* widget, QSettings& settings) noexcept
+    {
+        auto* page = dynamic_cast<SettingsPage_Diagnostics const*>(widget);
+
+        int dumpInterval = page->m_ui->spinBoxDumpInterval->value();
+        if (!page->m_ui->checkBoxDump->isChecked())
+            dumpInterval = 0;
+        settings.setValue("metrics_dump_interval", dumpInterval);
+    }
+
+    void SettingsPage_Diagnostics_Creator::initiateUpdate(QSettings const& settings) noexcept
+    {
+        int const dumpInterval = settings.value("metrics_dump_interval", 0).toInt();
+        if (dumpInterval > 0)
+            m_dumpTimer.start(dumpInterval * 1000);
+        else
+            m_dumpTimer.stop();
+
+        emit updateInitiated();
+    }
+
+    void SettingsPage_Diagnostics_Creator::restoreDefaults(QWidget const* widget) noexcept
+    {
+        auto* page = dynamic_cast<SettingsPage_Diagnostics const*>(widget);
+
+        page->m_ui->checkBoxDump->setChecked(false);
+        page->m_ui->spinBoxDumpInterval->setValue(s_defaultDumpInterval);
+        page->m_ui->spinBoxDumpInterval->setEnabled(false);
+    }
+
+    QWidget* SettingsPage_Diagnostics_Creator::createWidget() noexcept
+    {
+        return new SettingsPage_Diagnostics;
+    }
+}
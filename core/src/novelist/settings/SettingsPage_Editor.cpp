@@ -9,6 +9,8 @@
 #include <QtCore/QEvent>
 #include "settings/SettingsPage_Editor.h"
 #include "ui_SettingsPage_Editor.h"
+#include "document/SceneDocumentInsightManager.h"
+#include "widgets/texteditor/TextEditorInsightManager.h"
 
 namespace novelist {
     SettingsPage_Editor::SettingsPage_Editor(QWidget* parent, Qt::WindowFlags f)
@@ -60,6 +62,14 @@ namespace novelist {
         }
         if (settings.contains("show_par_no"))
             page->m_ui->checkBoxShowParNo->setChecked(settings.value("show_par_no").toBool());
+        if (settings.contains("large_doc_threshold")) {
+            int largeDocThreshold = settings.value("large_doc_threshold").toInt();
+            page->m_ui->checkBoxLargeDoc->setChecked(largeDocThreshold > 0);
+            if (largeDocThreshold > 0)
+                page->m_ui->spinBoxLargeDocThreshold->setValue(largeDocThreshold);
+        }
+        if (settings.contains("inspection_delay"))
+            page->m_ui->spinBoxInspectionDelay->setValue(settings.value("inspection_delay").toInt());
 
         if (settings.contains("auto_quotes")) {
             page->m_ui->checkBoxAutoQuotes->setChecked(settings.value("auto_quotes").toInt() >= 0);
@@ -84,6 +94,11 @@ namespace novelist {
             widthLimit = 0;
         settings.setValue("width_limit", widthLimit);
         settings.setValue("show_par_no", page->m_ui->checkBoxShowParNo->isChecked());
+        int largeDocThreshold = page->m_ui->spinBoxLargeDocThreshold->value();
+        if (!page->m_ui->checkBoxLargeDoc->isChecked())
+            largeDocThreshold = 0;
+        settings.setValue("large_doc_threshold", largeDocThreshold);
+        settings.setValue("inspection_delay", page->m_ui->spinBoxInspectionDelay->value());
 
         int autoQuotes = -1;
         if (page->m_ui->checkBoxAutoQuotes->isChecked())
@@ -107,6 +122,9 @@ namespace novelist {
         page->m_ui->checkBoxLimitWidth->setChecked(false);
         page->m_ui->spinBoxTextWidth->setValue(350);
         page->m_ui->checkBoxShowParNo->setChecked(true);
+        page->m_ui->checkBoxLargeDoc->setChecked(true);
+        page->m_ui->spinBoxLargeDocThreshold->setValue(SceneDocumentInsightManager::s_defaultLargeDocumentThreshold);
+        page->m_ui->spinBoxInspectionDelay->setValue(TextEditorInsightManager::s_defaultQuietPeriod);
         page->m_ui->checkBoxAutoQuotes->setChecked(true);
         page->m_ui->comboBoxAutoQuotes->setCurrentIndex(0);
         if (QLocale().language() == QLocale::Language::German)
@@ -0,0 +1,250 @@
+/**********************************************************
+ * @file   Profiler.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <QtCore/QDebug>
+#include <QtCore/QStringList>
+#include "util/Profiler.h"
+
+namespace novelist::profiling {
+    namespace {
+        constexpr size_t s_invalidProbe = Probe::s_maxProbes;
+
+        size_t log2(uint64_t n) noexcept
+        {
+#if defined(__GNUC__)
+            return 63 - static_cast<size_t>(__builtin_clzll(n));
+#else
+            size_t result = 0;
+            while (n >>= 1)
+                ++result;
+            return result;
+#endif
+        }
+
+        /**
+         * Histograms of all probes for a single thread
+         */
+        struct ThreadHistograms {
+            std::array<Histogram, Probe::s_maxProbes> m_histograms;
+        };
+
+        /**
+         * Keeps track of all probes and all threads that recorded samples
+         */
+        class Registry {
+        public:
+            static Registry& instance() noexcept
+            {
+                static Registry registry;
+                return registry;
+            }
+
+            size_t registerProbe(char const* name) noexcept
+            {
+                size_t id = m_nextId.fetch_add(1, std::memory_order_relaxed);
+                if (id >= Probe::s_maxProbes)
+                    return s_invalidProbe;
+                m_names[id].store(name, std::memory_order_release);
+                return id;
+            }
+
+            void registerThread(ThreadHistograms* histograms) noexcept
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_threads.push_back(histograms);
+            }
+
+            void unregisterThread(ThreadHistograms* histograms) noexcept
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                for (size_t i = 0; i < Probe::s_maxProbes; ++i)
+                    m_retired[i].merge(histograms->m_histograms[i].snapshot());
+                m_threads.erase(std::remove(m_threads.begin(), m_threads.end(), histograms), m_threads.end());
+            }
+
+            std::vector<ProbeResult> collect() noexcept
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                std::vector<ProbeResult> results;
+                size_t const probeCount = std::min(m_nextId.load(std::memory_order_relaxed), Probe::s_maxProbes);
+                for (size_t i = 0; i < probeCount; ++i) {
+                    char const* name = m_names[i].load(std::memory_order_acquire);
+                    if (name == nullptr)
+                        continue;
+                    ProbeResult result{name, m_retired[i]};
+                    for (auto* t : m_threads)
+                        result.m_histogram.merge(t->m_histograms[i].snapshot());
+                    if (result.m_histogram.m_count > 0)
+                        results.push_back(std::move(result));
+                }
+                return results;
+            }
+
+        private:
+            std::mutex m_mutex;
+            std::vector<ThreadHistograms*> m_threads;
+            std::array<HistogramSnapshot, Probe::s_maxProbes> m_retired{};
+            std::array<std::atomic<char const*>, Probe::s_maxProbes> m_names{};
+            std::atomic<size_t> m_nextId{0};
+        };
+
+        /**
+         * Registers the calling thread's histograms on first use and folds them into the registry on thread exit
+         */
+        class ThreadHandle {
+        public:
+            ThreadHandle() noexcept
+                    :m_histograms(std::make_unique<ThreadHistograms>())
+            {
+                Registry::instance().registerThread(m_histograms.get());
+            }
+
+            ~ThreadHandle() noexcept
+            {
+                Registry::instance().unregisterThread(m_histograms.get());
+            }
+
+            ThreadHistograms& histograms() noexcept
+            {
+                return *m_histograms;
+            }
+
+        private:
+            std::unique_ptr<ThreadHistograms> m_histograms;
+        };
+
+        QString formatNanos(uint64_t nanos)
+        {
+            return QString::number(nanos / 1000.0, 'f', 1);
+        }
+    }
+
+    size_t Buckets::indexOf(uint64_t nanos) noexcept
+    {
+        if (nanos < s_subBuckets)
+            return static_cast<size_t>(nanos);
+        size_t const exp = log2(nanos);
+        size_t const sub = static_cast<size_t>(nanos >> (exp - 2)) & (s_subBuckets - 1);
+        return s_subBuckets * (exp - 1) + sub;
+    }
+
+    uint64_t Buckets::lowerBound(size_t index) noexcept
+    {
+        if (index < s_subBuckets)
+            return index;
+        size_t const exp = index / s_subBuckets + 1;
+        uint64_t const sub = index % s_subBuckets;
+        return (s_subBuckets + sub) << (exp - 2);
+    }
+
+    void HistogramSnapshot::merge(HistogramSnapshot const& other) noexcept
+    {
+        for (size_t i = 0; i < m_buckets.size(); ++i)
+            m_buckets[i] += other.m_buckets[i];
+        m_count += other.m_count;
+        m_sum += other.m_sum;
+        m_max = std::max(m_max, other.m_max);
+    }
+
+    uint64_t HistogramSnapshot::percentile(double p) const noexcept
+    {
+        if (m_count == 0)
+            return 0;
+
+        auto const rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::clamp(p, 0.0, 1.0) * m_count)));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < m_buckets.size(); ++i) {
+            seen += m_buckets[i];
+            if (seen >= rank) {
+                // Report the middle of the bucket
+                uint64_t const lower = Buckets::lowerBound(i);
+                uint64_t const upper = i + 1 < m_buckets.size() ? Buckets::lowerBound(i + 1) : lower;
+                return lower + (upper - lower) / 2;
+            }
+        }
+        return Buckets::lowerBound(m_buckets.size() - 1);
+    }
+
+    uint64_t HistogramSnapshot::mean() const noexcept
+    {
+        if (m_count == 0)
+            return 0;
+        return m_sum / m_count;
+    }
+
+    void Histogram::record(uint64_t nanos) noexcept
+    {
+        m_buckets[Buckets::indexOf(nanos)].fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(nanos, std::memory_order_relaxed);
+        // Buckets only approximate the samples, the maximum is kept exactly
+        uint64_t max = m_max.load(std::memory_order_relaxed);
+        while (nanos > max && !m_max.compare_exchange_weak(max, nanos, std::memory_order_relaxed))
+            ;
+    }
+
+    HistogramSnapshot Histogram::snapshot() const noexcept
+    {
+        HistogramSnapshot result;
+        // Count is derived from the buckets so it stays consistent with them while another thread is recording
+        for (size_t i = 0; i < m_buckets.size(); ++i) {
+            result.m_buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+            result.m_count += result.m_buckets[i];
+        }
+        result.m_sum = m_sum.load(std::memory_order_relaxed);
+        result.m_max = m_max.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    Probe::Probe(char const* name) noexcept
+            :m_id(Registry::instance().registerProbe(name))
+    {
+    }
+
+    void Probe::record(uint64_t nanos) const noexcept
+    {
+        if (m_id == s_invalidProbe)
+            return;
+
+        thread_local ThreadHandle handle;
+        handle.histograms().m_histograms[m_id].record(nanos);
+    }
+
+    std::vector<ProbeResult> collect() noexcept
+    {
+        return Registry::instance().collect();
+    }
+
+    QString report() noexcept
+    {
+        auto const results = collect();
+        QStringList lines;
+        lines << QString("%1 %2 %3 %4 %5 %6 %7")
+                .arg("Probe", -40).arg("Count", 10).arg("Mean [us]", 12).arg("p50 [us]", 12)
+                .arg("p90 [us]", 12).arg("p99 [us]", 12).arg("Max [us]", 12);
+        for (auto const& r : results) {
+            auto const& h = r.m_histogram;
+            lines << QString("%1 %2 %3 %4 %5 %6 %7")
+                    .arg(r.m_name, -40).arg(h.m_count, 10).arg(formatNanos(h.mean()), 12)
+                    .arg(formatNanos(h.percentile(0.5)), 12).arg(formatNanos(h.percentile(0.9)), 12)
+                    .arg(formatNanos(h.percentile(0.99)), 12).arg(formatNanos(h.m_max), 12);
+        }
+        return lines.join('\n');
+    }
+
+    void dumpToLog() noexcept
+    {
+        if (collect().empty())
+            return;
+
+        qInfo().noquote() << "Profiling results:\n" + report();
+    }
+}
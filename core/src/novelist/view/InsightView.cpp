@@ -62,7 +62,7 @@ namespace novelist {
     void InsightView::onDoubleClicked(QModelIndex const& index)
     {
         auto* insight = qvariant_cast<Insight*>(model()->data(index, static_cast<int>(InsightModelRoles::InsightDataRole)));
-        auto* editor = dynamic_cast<TextEditor*>(m_sceneTabs->currentWidget());
+        auto* editor = m_sceneTabs->currentEditor();
         if(editor) {
             auto cursor = editor->textCursor();
             cursor.setPosition(insight->range().second);
@@ -11,6 +11,7 @@
 #include <QDrag>
 #include <QMessageBox>
 #include "windows/ProjectPropertiesWindow.h"
+#include "widgets/texteditor/ProjectInspectionService.h"
 #include "view/ProjectView.h"
 
 // The macro cannot be called from within a namespace (see http://doc.qt.io/qt-5/qdir.html#Q_INIT_RESOURCE)
@@ -120,6 +121,18 @@ namespace novelist {
         m_treeView->scrollTo(index, hint);
     }
 
+    void ProjectView::useInspectionService(ProjectInspectionService* service)
+    {
+        m_inspectionService = service;
+        m_itemDelegate->useInspectionService(service);
+        if (service != nullptr)
+            m_insightCountConnection = connect(service, &ProjectInspectionService::insightCountChanged, this,
+                    [this] { m_treeView->viewport()->update(); });
+        else
+            m_insightCountConnection.disconnect();
+        m_treeView->viewport()->update();
+    }
+
     void ProjectView::onNewChapter()
     {
         ProjectModel* m = model();
@@ -291,6 +304,9 @@ namespace novelist {
                     m_actionNewScene->setEnabled(true);
                     m_actionRemoveEntry->setEnabled(true);
                     m_actionProperties->setEnabled(false);
+                    // The author might be about to open it
+                    if (m_inspectionService != nullptr)
+                        m_inspectionService->prioritize(idx);
                     break;
                 default:
                     m_actionNewChapter->setEnabled(false);
@@ -359,6 +375,8 @@ namespace novelist {
         m_treeView->setAnimated(true);
         m_treeView->setHeaderHidden(true);
         m_treeView->setContextMenuPolicy(Qt::CustomContextMenu);
+        m_itemDelegate = new internal::ProjectItemDelegate(m_treeView);
+        m_treeView->setItemDelegate(m_itemDelegate);
 
         m_topLayout->addWidget(m_treeView);
 
@@ -514,4 +532,24 @@ namespace novelist {
 
         QAbstractItemView::focusOutEvent(event);
     }
-}
\ No newline at end of file
+
+    internal::ProjectItemDelegate::ProjectItemDelegate(QObject* parent) noexcept
+            :QStyledItemDelegate(parent)
+    {
+    }
+
+    void internal::ProjectItemDelegate::useInspectionService(ProjectInspectionService const* service) noexcept
+    {
+        m_inspectionService = service;
+    }
+
+    void internal::ProjectItemDelegate::initStyleOption(QStyleOptionViewItem* option, QModelIndex const& index) const
+    {
+        QStyledItemDelegate::initStyleOption(option, index);
+        if (m_inspectionService == nullptr)
+            return;
+
+        if (auto count = m_inspectionService->insightCount(index); count && *count > 0)
+            option->text += QStringLiteral(" (%1)").arg(*count);
+    }
+}
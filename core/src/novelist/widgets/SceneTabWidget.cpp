@@ -7,29 +7,40 @@
  * @details
  **********************************************************/
 
+#include <optional>
 #include <QTabBar>
 #include "settings/Settings.h"
 #include "widgets/SceneTabWidget.h"
 
 namespace novelist {
+    namespace {
+        std::optional<int> sceneIdOf(ProjectModel const* model, QModelIndex const& index)
+        {
+            if (model == nullptr || !index.isValid())
+                return std::nullopt;
+            if (auto const* scene = std::get_if<ProjectModel::SceneData>(model->nodeData(index).get()))
+                return scene->m_id.id();
+            return std::nullopt;
+        }
+    }
+
     namespace internal {
         InternalTabBar::InternalTabBar(SceneTabWidget* parent) noexcept
-                :QTabBar(parent)
+                :QTabBar(parent),
+                 m_tabWidget(parent)
         {
         }
 
         void InternalTabBar::focusInEvent(QFocusEvent* event)
         {
-            auto* tabWidget = dynamic_cast<SceneTabWidget*>(parent());
-            emit tabWidget->focusReceived(true);
+            emit m_tabWidget->focusReceived(true);
 
             QWidget::focusInEvent(event);
         }
 
         void InternalTabBar::focusOutEvent(QFocusEvent* event)
         {
-            auto* tabWidget = dynamic_cast<SceneTabWidget*>(parent());
-            emit tabWidget->focusReceived(false);
+            emit m_tabWidget->focusReceived(false);
 
             QWidget::focusOutEvent(event);
         }
@@ -73,10 +84,12 @@ namespace novelist {
             editor->setFocusPolicy(focusPolicy());
             editor->m_model = model;
             editor->m_modelIndex = index;
+            editor->m_sceneId = *sceneIdOf(model, index);
+            m_editorsByScene[{model, editor->m_sceneId}] = editor.get();
             editor->setDocument(document);
             document->setModified(prevModified); // setDocument() resets modified state
             editor->setWordWrapMode(QTextOption::WrapMode::WordWrap);
-            editor->useInspectors(&m_inspectors);
+            editor->useInspectors(&m_inspectors, &m_inspectorsLock);
             applySettingsToEditor(settings, editor.get());
 
             // Make sure the tab title and color change appropriately
@@ -104,11 +117,12 @@ namespace novelist {
         if (index < 0 || index > count())
             return;
 
-        auto* w = dynamic_cast<internal::InternalTextEditor*>(widget(index));
+        auto* w = editorAt(index);
         removeTab(index);
 
         if (w != nullptr) {
             emit sceneClosing(w);
+            m_editorsByScene.erase({w->m_model, w->m_sceneId});
             m_editors.erase(std::remove_if(m_editors.begin(), m_editors.end(),
                     [this, w](std::unique_ptr<internal::InternalTextEditor> const& p) {
                         return p.get() == w;
@@ -124,19 +138,21 @@ namespace novelist {
 
     int SceneTabWidget::indexOf(ProjectModel const* model, QModelIndex index) const
     {
-        for (int i = 0; i < count(); ++i) {
-            auto* w = dynamic_cast<internal::InternalTextEditor*>(widget(i));
-            if (w != nullptr && w->m_model == model && w->m_modelIndex == index)
-                return i;
-        }
+        auto sceneId = sceneIdOf(model, index);
+        if (!sceneId)
+            return -1;
 
-        return -1;
+        auto iter = m_editorsByScene.find({model, *sceneId});
+        if (iter == m_editorsByScene.end())
+            return -1;
+
+        return QTabWidget::indexOf(iter->second);
     }
 
     std::pair<ProjectModel*, QModelIndex> SceneTabWidget::current() const noexcept
     {
         std::pair<ProjectModel*, QModelIndex> result;
-        auto* w = dynamic_cast<internal::InternalTextEditor*>(widget(currentIndex()));
+        auto* w = editorAt(currentIndex());
         if (w != nullptr) {
             result.first = w->m_model;
             result.second = w->m_modelIndex;
@@ -146,7 +162,7 @@ namespace novelist {
 
     TextEditor* SceneTabWidget::currentEditor() const noexcept
     {
-        return dynamic_cast<internal::InternalTextEditor*>(widget(currentIndex()));
+        return editorAt(currentIndex());
     }
 
     void SceneTabWidget::useInsightView(QAbstractItemView* insightView)
@@ -156,9 +172,20 @@ namespace novelist {
 
     void SceneTabWidget::registerInspector(std::unique_ptr<Inspector> inspector)
     {
+        QWriteLocker lock(&m_inspectorsLock);
         m_inspectors.push_back(std::move(inspector));
     }
 
+    std::vector<std::unique_ptr<Inspector>> const* SceneTabWidget::inspectors() const noexcept
+    {
+        return &m_inspectors;
+    }
+
+    QReadWriteLock* SceneTabWidget::inspectorsLock() const noexcept
+    {
+        return &m_inspectorsLock;
+    }
+
     QAction* SceneTabWidget::undoAction()
     {
         return &m_undoAction;
@@ -226,7 +253,7 @@ namespace novelist {
 
     void SceneTabWidget::onCurrentChanged(int /*index*/)
     {
-        auto* editor = dynamic_cast<internal::InternalTextEditor*>(currentWidget());
+        auto* editor = editorAt(currentIndex());
         if (editor) {
             QString title = editor->m_model->data(editor->m_modelIndex, Qt::DisplayRole).toString();
             m_undoAction.setDelegate(editor->undoAction());
@@ -271,7 +298,7 @@ namespace novelist {
 
     void SceneTabWidget::onModelDataChanged(QModelIndex const& topLeft, QModelIndex const& bottomRight)
     {
-        auto const* model = dynamic_cast<ProjectModel const*>(topLeft.model());
+        auto const* model = qobject_cast<ProjectModel const*>(topLeft.model());
         if (model == nullptr)
             return;
 
@@ -354,13 +381,25 @@ namespace novelist {
         }
 
         for (int i = 0; i < count(); ++i) {
-            auto* w = dynamic_cast<TextEditor*>(widget(i));
+            auto* w = editorAt(i);
             if (w != nullptr) {
                 applySettingsToEditor(settings, w);
             }
         }
     }
 
+    internal::InternalTextEditor* SceneTabWidget::editorAt(int index) const noexcept
+    {
+        // Only a handful of scenes are open at a time, so comparing pointers is cheaper than casting the widget
+        QWidget const* w = widget(index);
+        if (w == nullptr)
+            return nullptr;
+
+        auto iter = std::find_if(m_editors.begin(), m_editors.end(),
+                [w](std::unique_ptr<internal::InternalTextEditor> const& p) { return p.get() == w; });
+        return iter != m_editors.end() ? iter->get() : nullptr;
+    }
+
     void SceneTabWidget::applySettingsToEditor(QSettings const& settings, TextEditor* editor) const
     {
         editor->setShowParagraphNumberArea(settings.value("editor/show_par_no", true).toBool());
@@ -372,6 +411,10 @@ namespace novelist {
         else {
             editor->setLineWrapMode(TextEditor::LineWrapMode::WidgetWidth);
         }
+        editor->setLargeDocumentThreshold(settings.value("editor/large_doc_threshold",
+                SceneDocumentInsightManager::s_defaultLargeDocumentThreshold).toInt());
+        editor->setInspectionDelay(settings.value("editor/inspection_delay",
+                TextEditorInsightManager::s_defaultQuietPeriod).toInt());
         editor->useCharReplacement(&m_charReplacementRules);
     }
 }
\ No newline at end of file
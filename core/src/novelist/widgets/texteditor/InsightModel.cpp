@@ -8,6 +8,7 @@
  **********************************************************/
 #include "widgets/texteditor/InsightModel.h"
 #include "widgets/texteditor/TextEditor.h"
+#include <algorithm>
 #include <QtCore/QCoreApplication>
 
 namespace novelist {
@@ -37,7 +38,7 @@ namespace novelist {
         if (role == Qt::DisplayRole || role == Qt::ToolTipRole) {
             auto iter = insightManager()->begin();
             std::advance(iter, index.row());
-            auto* insight = dynamic_cast<Insight*>(iter->get());
+            auto* insight = iter->get();
             if (!insight)
                 return QVariant();
             switch (index.column()) {
@@ -59,7 +60,7 @@ namespace novelist {
         else if (role == static_cast<int>(InsightModelRoles::InsightDataRole)) {
             auto iter = insightManager()->begin();
             std::advance(iter, index.row());
-            return QVariant::fromValue<Insight*>(dynamic_cast<Insight*>(iter->get()));
+            return QVariant::fromValue<Insight*>(iter->get());
         }
         return QVariant();
     }
@@ -113,6 +114,45 @@ namespace novelist {
         return index(idx, 0);
     }
 
+    void InsightModel::insert(std::vector<std::unique_ptr<Insight>> insights)
+    {
+        if (!insightManager() || insights.empty())
+            return;
+
+        internal::InsightPtrOrderCompare comp;
+        std::stable_sort(insights.begin(), insights.end(), comp);
+
+        // Find the row each new insight is merged in front of. Merging puts new insights behind equal existing ones.
+        std::vector<int> rows;
+        rows.reserve(insights.size());
+        for (auto const& insight : insights) {
+            auto iter = std::upper_bound(insightManager()->begin(), insightManager()->end(), insight, comp);
+            rows.push_back(gsl::narrow<int>(std::distance(insightManager()->begin(), iter)));
+        }
+
+        insightManager()->beginBatch();
+        auto batchGuard = gsl::finally([this] { insightManager()->endBatch(); });
+
+        // Insights merged in front of the same existing row form one contiguous run of new rows
+        int inserted = 0;
+        for (size_t first = 0; first < insights.size();) {
+            size_t last = first + 1;
+            while (last < insights.size() && rows[last] == rows[first])
+                ++last;
+
+            int const row = rows[first] + inserted;
+            int const count = gsl::narrow<int>(last - first);
+            beginInsertRows(QModelIndex(), row, row + count - 1);
+            insightManager()->insert(std::vector<std::unique_ptr<Insight>>(
+                    std::make_move_iterator(insights.begin() + first),
+                    std::make_move_iterator(insights.begin() + last)));
+            endInsertRows();
+
+            inserted += count;
+            first = last;
+        }
+    }
+
     bool InsightModel::remove(QModelIndex const& index)
     {
         if (!insightManager())
@@ -138,22 +178,35 @@ namespace novelist {
         if (!insightManager())
             return false;
 
-        bool removed = false;
         auto overlap = [start, end](Insight* a) {
             return a->range().first < end && a->range().second > start;
         };
-        for (auto iter = insightManager()->begin(); iter != insightManager()->end();) {
-            if (!(*iter)->isPersistent() && overlap(iter->get())) {
-                auto idx = gsl::narrow<int>(std::distance(insightManager()->begin(), iter));
-                beginRemoveRows(QModelIndex(), idx, idx);
-                iter = insightManager()->erase(iter);
-                endRemoveRows();
-                removed = true;
-            }
+
+        // Collect contiguous runs of rows to remove
+        auto const [first, last] = insightManager()->findOverlapping(start, end);
+        std::vector<std::pair<int, int>> runs;
+        auto iter = insightManager()->begin() + first;
+        for (int row = first; row < last; ++row, ++iter) {
+            if ((*iter)->isPersistent() || !overlap(iter->get()))
+                continue;
+            if (!runs.empty() && runs.back().second == row)
+                ++runs.back().second;
             else
-                ++iter;
+                runs.emplace_back(row, row + 1);
         }
-        return removed;
+        if (runs.empty())
+            return false;
+
+        insightManager()->beginBatch();
+        auto batchGuard = gsl::finally([this] { insightManager()->endBatch(); });
+
+        // Back to front, so the rows of runs that are still to be removed stay valid
+        for (auto run = runs.rbegin(); run != runs.rend(); ++run) {
+            beginRemoveRows(QModelIndex(), run->first, run->second - 1);
+            insightManager()->erase(insightManager()->begin() + run->first, insightManager()->begin() + run->second);
+            endRemoveRows();
+        }
+        return true;
     }
 
     void InsightModel::clear()
@@ -201,12 +254,12 @@ namespace novelist {
         return nullptr;
     }
 
-    void InsightModel::onAboutToAutoRemove(int idx)
+    void InsightModel::onAboutToAutoRemove(int first, int last)
     {
-        beginRemoveRows(QModelIndex(), idx, idx);
+        beginRemoveRows(QModelIndex(), first, last);
     }
 
-    void InsightModel::onAutoRemoved(int /*idx*/)
+    void InsightModel::onAutoRemoved(int /*first*/, int /*last*/)
     {
         endRemoveRows();
     }
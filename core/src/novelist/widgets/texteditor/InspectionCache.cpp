@@ -0,0 +1,176 @@
+/**********************************************************
+ * @file   InspectionCache.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include "widgets/texteditor/InspectionCache.h"
+
+namespace novelist {
+    namespace {
+        constexpr quint32 s_magic = 0x4E494331; // "NIC1"
+        constexpr quint32 s_version = 1;
+    }
+
+    InspectionCache::InspectionCache(size_t budget) noexcept
+            :m_budget(budget)
+    {
+    }
+
+    QByteArray InspectionCache::makeKey(QString const& text, Language lang, QByteArray const& inspectorKey)
+    {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        hash.addData(inspectorKey);
+        hash.addData("\0", 1);
+        hash.addData(lang::identifier(lang).toUtf8());
+        hash.addData("\0", 1);
+        hash.addData(reinterpret_cast<char const*>(text.constData()), text.size() * sizeof(QChar));
+        return hash.result();
+    }
+
+    std::optional<InspectionBlockResult> InspectionCache::find(QByteArray const& key)
+    {
+        QMutexLocker lock(&m_mutex);
+        auto iter = m_index.find(key);
+        if (iter == m_index.end())
+            return std::nullopt;
+
+        m_entries.splice(m_entries.begin(), m_entries, iter.value());
+        return iter.value()->m_result;
+    }
+
+    void InspectionCache::insert(QByteArray const& key, InspectionBlockResult result)
+    {
+        QMutexLocker lock(&m_mutex);
+        insertLocked(key, std::move(result));
+    }
+
+    void InspectionCache::clear() noexcept
+    {
+        QMutexLocker lock(&m_mutex);
+        m_index.clear();
+        m_entries.clear();
+        m_usage = 0;
+    }
+
+    size_t InspectionCache::size() const noexcept
+    {
+        QMutexLocker lock(&m_mutex);
+        return m_entries.size();
+    }
+
+    size_t InspectionCache::memoryUsage() const noexcept
+    {
+        QMutexLocker lock(&m_mutex);
+        return m_usage;
+    }
+
+    bool InspectionCache::save(QIODevice& device) const
+    {
+        QMutexLocker lock(&m_mutex);
+
+        std::vector<std::pair<QByteArray const*, std::vector<InsightFactoryDescription>>> describable;
+        for (auto const& e : m_entries) {
+            std::vector<InsightFactoryDescription> descriptions;
+            for (auto const& insight : e.m_result) {
+                descriptions.push_back(insight.m_factory->describe());
+                if (descriptions.back().m_type.isEmpty())
+                    break;
+            }
+            if (descriptions.empty() || !descriptions.back().m_type.isEmpty())
+                describable.emplace_back(&e.m_key, std::move(descriptions));
+        }
+
+        QDataStream stream(&device);
+        stream.setVersion(QDataStream::Qt_5_9);
+        stream << s_magic << s_version << static_cast<quint32>(describable.size());
+        // Least recently used first, so loading restores the order
+        for (auto iter = describable.rbegin(); iter != describable.rend(); ++iter) {
+            auto const& [key, descriptions] = *iter;
+            auto const& result = m_index.value(*key)->m_result;
+            stream << *key << static_cast<quint32>(result.size());
+            for (size_t i = 0; i < result.size(); ++i) {
+                stream << descriptions[i].m_type << descriptions[i].m_message << descriptions[i].m_suggestions
+                       << static_cast<qint32>(result[i].m_left) << static_cast<qint32>(result[i].m_right);
+            }
+        }
+        return stream.status() == QDataStream::Ok;
+    }
+
+    bool InspectionCache::load(QIODevice& device)
+    {
+        QDataStream stream(&device);
+        stream.setVersion(QDataStream::Qt_5_9);
+        quint32 magic = 0;
+        quint32 version = 0;
+        quint32 entryCount = 0;
+        stream >> magic >> version >> entryCount;
+        if (stream.status() != QDataStream::Ok || magic != s_magic || version != s_version)
+            return false;
+
+        std::vector<std::pair<QByteArray, InspectionBlockResult>> entries;
+        for (quint32 e = 0; e < entryCount; ++e) {
+            QByteArray key;
+            quint32 insightCount = 0;
+            stream >> key >> insightCount;
+            if (stream.status() != QDataStream::Ok)
+                return false;
+
+            InspectionBlockResult result;
+            for (quint32 i = 0; i < insightCount; ++i) {
+                InsightFactoryDescription description;
+                qint32 left = 0;
+                qint32 right = 0;
+                stream >> description.m_type >> description.m_message >> description.m_suggestions >> left >> right;
+                auto factory = makeInsightFactory(description);
+                if (stream.status() != QDataStream::Ok || factory == nullptr)
+                    return false;
+                result.push_back({std::move(factory), left, right});
+            }
+            entries.emplace_back(std::move(key), std::move(result));
+        }
+
+        QMutexLocker lock(&m_mutex);
+        for (auto& [key, result] : entries)
+            insertLocked(key, std::move(result));
+        return true;
+    }
+
+    size_t InspectionCache::estimateSize(QByteArray const& key, InspectionBlockResult const& result) noexcept
+    {
+        // Factories are usually shared between many insights, but count them fully to stay on the safe side
+        size_t size = sizeof(Entry) + key.size() + 2 * sizeof(void*);
+        for (auto const& insight : result)
+            size += sizeof(InspectionInsight) + insight.m_factory->memoryUsage();
+        return size;
+    }
+
+    void InspectionCache::insertLocked(QByteArray const& key, InspectionBlockResult result)
+    {
+        if (auto iter = m_index.find(key); iter != m_index.end()) {
+            m_usage -= iter.value()->m_size;
+            m_entries.erase(iter.value());
+            m_index.erase(iter);
+        }
+
+        size_t const size = estimateSize(key, result);
+        m_entries.push_front({key, std::move(result), size});
+        m_index.insert(key, m_entries.begin());
+        m_usage += size;
+        evictLocked();
+    }
+
+    void InspectionCache::evictLocked() noexcept
+    {
+        // Always keep the most recent entry, even if it exceeds the budget on its own
+        while (m_usage > m_budget && m_entries.size() > 1) {
+            m_usage -= m_entries.back().m_size;
+            m_index.remove(m_entries.back().m_key);
+            m_entries.pop_back();
+        }
+    }
+}
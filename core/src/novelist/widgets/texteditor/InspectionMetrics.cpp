@@ -0,0 +1,151 @@
+/**********************************************************
+ * @file   InspectionMetrics.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#include <QtCore/QDebug>
+#include <QtCore/QStringList>
+#include "widgets/texteditor/InspectionMetrics.h"
+
+namespace novelist {
+    namespace {
+        QString formatMillis(uint64_t nanos)
+        {
+            return QString::number(nanos / 1000000.0, 'f', 1);
+        }
+
+        QString formatHistogram(QString const& name, profiling::HistogramSnapshot const& h)
+        {
+            return QString("%1 %2 %3 %4 %5 %6")
+                    .arg(name, -32).arg(h.m_count, 10).arg(formatMillis(h.mean()), 10)
+                    .arg(formatMillis(h.percentile(0.5)), 10).arg(formatMillis(h.percentile(0.9)), 10)
+                    .arg(formatMillis(h.m_max), 10);
+        }
+    }
+
+    InspectorMetrics::InspectorMetrics(QString name) noexcept
+            :m_name(std::move(name))
+    {
+    }
+
+    QString const& InspectorMetrics::name() const noexcept
+    {
+        return m_name;
+    }
+
+    void InspectorMetrics::recordCall(size_t blocks, uint64_t queueNanos, uint64_t latencyNanos) noexcept
+    {
+        m_calls.fetch_add(1, std::memory_order_relaxed);
+        m_blocks.fetch_add(blocks, std::memory_order_relaxed);
+        m_queueTime.record(queueNanos);
+        m_latency.record(latencyNanos);
+    }
+
+    void InspectorMetrics::recordCacheHits(size_t blocks) noexcept
+    {
+        m_cacheHits.fetch_add(blocks, std::memory_order_relaxed);
+    }
+
+    void InspectorMetrics::recordBytesSent(size_t bytes) noexcept
+    {
+        m_bytesSent.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void InspectorMetrics::recordError() noexcept
+    {
+        m_errors.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    InspectorMetricsSnapshot InspectorMetrics::snapshot() const
+    {
+        InspectorMetricsSnapshot result;
+        result.m_name = m_name;
+        result.m_calls = m_calls.load(std::memory_order_relaxed);
+        result.m_blocks = m_blocks.load(std::memory_order_relaxed);
+        result.m_cacheHits = m_cacheHits.load(std::memory_order_relaxed);
+        result.m_bytesSent = m_bytesSent.load(std::memory_order_relaxed);
+        result.m_errors = m_errors.load(std::memory_order_relaxed);
+        result.m_queueTime = m_queueTime.snapshot();
+        result.m_latency = m_latency.snapshot();
+        return result;
+    }
+
+    InspectionMetrics& InspectionMetrics::instance() noexcept
+    {
+        static InspectionMetrics metrics;
+        return metrics;
+    }
+
+    InspectorMetrics& InspectionMetrics::inspector(QString const& name)
+    {
+        QMutexLocker lock(&m_mutex);
+        for (auto& m : m_inspectors) {
+            if (m.name() == name)
+                return m;
+        }
+        return m_inspectors.emplace_back(name);
+    }
+
+    void InspectionMetrics::recordFinishRefresh(uint64_t nanos) noexcept
+    {
+        m_finishRefresh.record(nanos);
+    }
+
+    void InspectionMetrics::recordApplyResult(uint64_t nanos) noexcept
+    {
+        m_applyResult.record(nanos);
+    }
+
+    std::vector<InspectorMetricsSnapshot> InspectionMetrics::inspectors() const
+    {
+        QMutexLocker lock(&m_mutex);
+        std::vector<InspectorMetricsSnapshot> result;
+        result.reserve(m_inspectors.size());
+        for (auto const& m : m_inspectors)
+            result.push_back(m.snapshot());
+        return result;
+    }
+
+    profiling::HistogramSnapshot InspectionMetrics::finishRefresh() const noexcept
+    {
+        return m_finishRefresh.snapshot();
+    }
+
+    profiling::HistogramSnapshot InspectionMetrics::applyResult() const noexcept
+    {
+        return m_applyResult.snapshot();
+    }
+
+    QString InspectionMetrics::report() const
+    {
+        auto const inspectorResults = inspectors();
+        QStringList lines;
+        lines << QString("%1 %2 %3 %4 %5 %6")
+                .arg("Inspector", -32).arg("Calls", 10).arg("Blocks", 10).arg("Cached", 10).arg("Sent [B]", 12)
+                .arg("Errors", 8);
+        for (auto const& r : inspectorResults) {
+            lines << QString("%1 %2 %3 %4 %5 %6")
+                    .arg(r.m_name, -32).arg(r.m_calls, 10).arg(r.m_blocks, 10).arg(r.m_cacheHits, 10)
+                    .arg(r.m_bytesSent, 12).arg(r.m_errors, 8);
+        }
+
+        lines << "" << QString("%1 %2 %3 %4 %5 %6")
+                .arg("Timing", -32).arg("Count", 10).arg("Mean [ms]", 10).arg("p50 [ms]", 10).arg("p90 [ms]", 10)
+                .arg("Max [ms]", 10);
+        for (auto const& r : inspectorResults) {
+            lines << formatHistogram(r.m_name + " queued", r.m_queueTime);
+            lines << formatHistogram(r.m_name + " latency", r.m_latency);
+        }
+        lines << formatHistogram("Finish refresh", finishRefresh());
+        lines << formatHistogram("Apply block result", applyResult());
+        return lines.join('\n');
+    }
+
+    void InspectionMetrics::dumpToLog() const
+    {
+        qInfo().noquote() << "Inspection metrics:\n" + report();
+    }
+}
@@ -0,0 +1,381 @@
+/**********************************************************
+ * @file   ProjectInspectionService.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#include <algorithm>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QThread>
+#include <QtConcurrent/QtConcurrent>
+#include "widgets/texteditor/ProjectInspectionService.h"
+#include "widgets/texteditor/Inspector.h"
+#include "widgets/texteditor/InspectionCache.h"
+#include "util/Profiler.h"
+
+namespace novelist {
+    namespace {
+        constexpr quint32 s_magic = 0x4E495331; // "NIS1"
+        constexpr quint32 s_version = 1;
+    }
+
+    ProjectInspectionService::ProjectInspectionService(QObject* parent)
+            :QObject(parent)
+    {
+        // Scenes are inspected one after another, the runner mostly waits for the inspection pool anyway
+        m_runnerPool.setMaxThreadCount(1);
+        m_idleTimer.setSingleShot(true);
+        connect(&m_idleTimer, &QTimer::timeout, this, &ProjectInspectionService::inspectNext);
+        connect(&m_runningWatcher, &QFutureWatcher<void>::finished, this, &ProjectInspectionService::finishScene);
+        if (auto* app = QCoreApplication::instance())
+            app->installEventFilter(this);
+    }
+
+    ProjectInspectionService::~ProjectInspectionService() noexcept
+    {
+        if (auto* app = QCoreApplication::instance())
+            app->removeEventFilter(this);
+        m_idleTimer.stop();
+        cancel();
+        if (m_running.isRunning())
+            m_running.waitForFinished();
+    }
+
+    void ProjectInspectionService::setProject(ProjectModel* model)
+    {
+        // Results of a running inspection belong to the previous project
+        cancel();
+        if (m_running.isRunning())
+            m_running.waitForFinished();
+        m_job.reset();
+        ++m_batch;
+
+        m_modelConnections.clear();
+        m_queue.clear();
+        m_summaries.clear();
+        m_upToDate = false;
+        m_model = model;
+        if (m_model == nullptr) {
+            m_idleTimer.stop();
+            return;
+        }
+
+        auto onStructureChanged = [this] { onActivity(); };
+        m_modelConnections.emplace_back(connect(m_model, &QObject::destroyed, this, [this] { setProject(nullptr); }));
+        m_modelConnections.emplace_back(connect(m_model, &ProjectModel::rowsInserted, this, onStructureChanged));
+        m_modelConnections.emplace_back(connect(m_model, &ProjectModel::rowsRemoved, this, onStructureChanged));
+        m_modelConnections.emplace_back(connect(m_model, &ProjectModel::rowsMoved, this, onStructureChanged));
+        m_modelConnections.emplace_back(connect(m_model, &ProjectModel::modelReset, this, onStructureChanged));
+        m_modelConnections.emplace_back(connect(m_model, &ProjectModel::projectSaved, this,
+                &ProjectInspectionService::saveSummaries));
+        m_modelConnections.emplace_back(connect(m_model, &ProjectModel::projectOpened, this,
+                &ProjectInspectionService::loadSummaries));
+        loadSummaries();
+        m_idleTimer.start(m_idleDelay);
+    }
+
+    ProjectModel* ProjectInspectionService::project() const noexcept
+    {
+        return m_model;
+    }
+
+    void ProjectInspectionService::useInspectors(std::vector<std::unique_ptr<Inspector>> const* inspectors,
+            QReadWriteLock* lock) noexcept
+    {
+        m_inspectors = inspectors;
+        m_inspectorsLock = lock;
+    }
+
+    void ProjectInspectionService::prioritize(QModelIndex const& index)
+    {
+        if (m_model == nullptr || !index.isValid() || m_model->nodeType(index) != ProjectModel::NodeType::Scene)
+            return;
+
+        m_queue.erase(std::remove(m_queue.begin(), m_queue.end(), QPersistentModelIndex(index)), m_queue.end());
+        m_queue.emplace_front(index);
+    }
+
+    void ProjectInspectionService::setIdleDelay(int msec) noexcept
+    {
+        m_idleDelay = std::max(0, msec);
+    }
+
+    int ProjectInspectionService::idleDelay() const noexcept
+    {
+        return m_idleDelay;
+    }
+
+    std::optional<int> ProjectInspectionService::insightCount(QModelIndex const& index) const
+    {
+        if (m_model == nullptr || !index.isValid())
+            return std::nullopt;
+
+        if (m_model->nodeType(index) == ProjectModel::NodeType::Scene) {
+            if (auto iter = m_summaries.find(sceneId(index)); iter != m_summaries.end())
+                return iter->second.m_insightCount;
+            return std::nullopt;
+        }
+
+        std::optional<int> total;
+        for (int r = 0; r < m_model->rowCount(index); ++r) {
+            if (auto count = insightCount(m_model->index(r, 0, index)))
+                total = total.value_or(0) + *count;
+        }
+        return total;
+    }
+
+    bool ProjectInspectionService::isRunning() const noexcept
+    {
+        return m_job.has_value();
+    }
+
+    bool ProjectInspectionService::save(QIODevice& device) const
+    {
+        QDataStream stream(&device);
+        stream.setVersion(QDataStream::Qt_5_9);
+        stream << s_magic << s_version << static_cast<quint32>(m_summaries.size());
+        for (auto const& [id, summary] : m_summaries)
+            stream << static_cast<qint32>(id) << summary.m_hash << static_cast<qint32>(summary.m_insightCount);
+        return stream.status() == QDataStream::Ok;
+    }
+
+    bool ProjectInspectionService::load(QIODevice& device)
+    {
+        QDataStream stream(&device);
+        stream.setVersion(QDataStream::Qt_5_9);
+        quint32 magic = 0;
+        quint32 version = 0;
+        quint32 entryCount = 0;
+        stream >> magic >> version >> entryCount;
+        if (stream.status() != QDataStream::Ok || magic != s_magic || version != s_version)
+            return false;
+
+        std::unordered_map<int, SceneSummary> summaries;
+        for (quint32 e = 0; e < entryCount; ++e) {
+            qint32 id = 0;
+            SceneSummary summary;
+            qint32 count = 0;
+            stream >> id >> summary.m_hash >> count;
+            if (stream.status() != QDataStream::Ok)
+                return false;
+            summary.m_insightCount = count;
+            summaries[id] = std::move(summary);
+        }
+
+        m_summaries = std::move(summaries);
+        return true;
+    }
+
+    bool ProjectInspectionService::event(QEvent* event)
+    {
+        if (event->type() == internal::InspectionResultEvent::s_eventId) {
+            auto* resultEvent = static_cast<internal::InspectionResultEvent*>(event);
+            applyBlockResult(resultEvent->m_batch, resultEvent->m_index, resultEvent->m_result,
+                    resultEvent->m_complete);
+            resultEvent->accept();
+            return true;
+        }
+        return QObject::event(event);
+    }
+
+    bool ProjectInspectionService::eventFilter(QObject* watched, QEvent* event)
+    {
+        switch (event->type()) {
+            case QEvent::KeyPress:
+            case QEvent::InputMethod:
+            case QEvent::MouseButtonPress:
+            case QEvent::Wheel:
+                onActivity();
+                break;
+            default:
+                break;
+        }
+        return QObject::eventFilter(watched, event);
+    }
+
+    void ProjectInspectionService::onActivity()
+    {
+        // The author is back, so the cores belong to the editors again. Whatever the author does might change scenes,
+        // so all of them are checked again on the next idle period.
+        cancel();
+        m_upToDate = false;
+        if (m_model != nullptr)
+            m_idleTimer.start(m_idleDelay);
+    }
+
+    void ProjectInspectionService::cancel() noexcept
+    {
+        if (m_job) {
+            for (auto const& cancelled : m_job->m_cancelled)
+                cancelled->store(true);
+        }
+    }
+
+    void ProjectInspectionService::fillQueue()
+    {
+        // Scenes are queued in the order they appear in the project, scenes that were prioritized stay in front.
+        // Results of scenes that don't exist anymore are dropped along the way.
+        std::unordered_map<int, SceneSummary> summaries;
+        std::vector<QModelIndex> pending{m_model->notebookIndex(), m_model->projectRootIndex()};
+        while (!pending.empty()) {
+            QModelIndex index = pending.back();
+            pending.pop_back();
+            if (m_model->nodeType(index) == ProjectModel::NodeType::Scene) {
+                int const id = sceneId(index);
+                if (auto iter = m_summaries.find(id); iter != m_summaries.end())
+                    summaries.insert(*iter);
+                if (std::find(m_queue.begin(), m_queue.end(), QPersistentModelIndex(index)) == m_queue.end())
+                    m_queue.emplace_back(index);
+            }
+            for (int r = m_model->rowCount(index) - 1; r >= 0; --r)
+                pending.push_back(m_model->index(r, 0, index));
+        }
+        m_summaries = std::move(summaries);
+    }
+
+    void ProjectInspectionService::inspectNext()
+    {
+        NOVELIST_PROFILE_SCOPE("ProjectInspectionService::inspectNext");
+
+        if (m_model == nullptr || m_job || m_running.isRunning())
+            return;
+        {
+            QReadLocker lock(m_inspectorsLock);
+            if (m_inspectors == nullptr || m_inspectors->empty())
+                return;
+        }
+
+        if (!m_upToDate) {
+            fillQueue();
+            m_upToDate = true;
+        }
+
+        while (!m_queue.empty()) {
+            QPersistentModelIndex index = m_queue.front();
+            m_queue.pop_front();
+            if (!index.isValid() || m_model->nodeType(index) != ProjectModel::NodeType::Scene)
+                continue;
+            auto* doc = qvariant_cast<SceneDocument*>(m_model->data(index, ProjectModel::DocumentRole));
+            if (doc == nullptr)
+                continue;
+
+            std::vector<QString> blocks;
+            blocks.reserve(static_cast<size_t>(doc->blockCount()));
+            for (auto block = doc->begin(); block != doc->end(); block = block.next())
+                blocks.push_back(block.text());
+
+            // Scenes that didn't change since their last inspection keep their result
+            QByteArray hash = contentHash(blocks, doc->language());
+            int const id = sceneId(index);
+            if (auto iter = m_summaries.find(id); iter != m_summaries.end() && iter->second.m_hash == hash)
+                continue;
+
+            // One core is left to the editors and the user interface
+            int const maxLanes = std::max(1, QThread::idealThreadCount() - 1);
+            internal::InspectionRequest request{std::move(blocks), {}, doc->language(), doc->inspectionCache(), this,
+                                                ++m_batch, maxLanes};
+            for (size_t i = 0; i < request.m_blocks.size(); ++i)
+                request.m_cancelled.push_back(std::make_shared<std::atomic_bool>(false));
+
+            m_job = Job{index, id, std::move(hash), request.m_cancelled, 0, 0};
+            m_running = QtConcurrent::run(&m_runnerPool, internal::runInspection, std::move(request), m_inspectors,
+                    m_inspectorsLock);
+            m_runningWatcher.setFuture(m_running);
+            return;
+        }
+    }
+
+    void ProjectInspectionService::finishScene()
+    {
+        // Results are posted before the inspection finishes, make sure they are all counted
+        QCoreApplication::sendPostedEvents(this, internal::InspectionResultEvent::s_eventId);
+        if (!m_job)
+            return;
+
+        Job job = std::move(*m_job);
+        m_job.reset();
+
+        // An interrupted scene is picked up first once the author is idle again. A scene with failed blocks keeps its
+        // previous result and is tried again on the next idle period.
+        bool const interrupted = std::any_of(job.m_cancelled.begin(), job.m_cancelled.end(),
+                [](auto const& cancelled) { return cancelled->load(); });
+        if (interrupted) {
+            if (job.m_index.isValid())
+                m_queue.push_front(job.m_index);
+        }
+        else if (!job.m_failed && job.m_doneBlocks == job.m_cancelled.size()) {
+            auto& summary = m_summaries[job.m_sceneId];
+            bool const changed = summary.m_hash.isEmpty() || summary.m_insightCount != job.m_insightCount;
+            summary = {std::move(job.m_hash), job.m_insightCount};
+            if (changed && job.m_index.isValid())
+                emit insightCountChanged(job.m_index);
+        }
+
+        // If the idle timer already fired while this scene was running, nothing else continues with the queue
+        if (!m_idleTimer.isActive())
+            inspectNext();
+    }
+
+    void ProjectInspectionService::applyBlockResult(uint64_t batch, size_t index, InspectionBlockResult const& result,
+            bool complete)
+    {
+        if (!m_job || batch != m_batch || index >= m_job->m_cancelled.size())
+            return;
+
+        ++m_job->m_doneBlocks;
+        m_job->m_failed |= !complete;
+        m_job->m_insightCount += gsl::narrow_cast<int>(result.size());
+    }
+
+    QByteArray ProjectInspectionService::contentHash(std::vector<QString> const& blocks, Language lang) const
+    {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        hash.addData(QByteArray::number(static_cast<int>(lang)));
+        {
+            // Different inspector settings might find different insights in the same text
+            QReadLocker lock(m_inspectorsLock);
+            if (m_inspectors != nullptr) {
+                for (auto const& inspector : *m_inspectors)
+                    hash.addData(inspector->cacheKey() + '\0');
+            }
+        }
+        for (auto const& text : blocks) {
+            hash.addData(QByteArray::number(text.size()) + ':');
+            hash.addData(reinterpret_cast<char const*>(text.utf16()), text.size() * 2);
+        }
+        return hash.result();
+    }
+
+    void ProjectInspectionService::loadSummaries()
+    {
+        // Stored results only speed up inspections, so failing to read them is not an error
+        m_summaries.clear();
+        m_upToDate = false;
+        if (m_model == nullptr || m_model->neverSaved())
+            return;
+        if (QFile file{m_model->saveDir().path() + QDir::separator() + m_fileName}; file.open(QIODevice::ReadOnly))
+            load(file);
+    }
+
+    void ProjectInspectionService::saveSummaries() const
+    {
+        if (m_model == nullptr)
+            return;
+        QFile file{m_model->saveDir().path() + QDir::separator() + m_fileName};
+        if (!file.open(QIODevice::WriteOnly) || !save(file))
+            qInfo() << "Writing inspection summary to" << file.fileName() << "failed";
+    }
+
+    int ProjectInspectionService::sceneId(QModelIndex const& index) const
+    {
+        if (auto const* scene = std::get_if<ProjectModel::SceneData>(m_model->nodeData(index).get()))
+            return static_cast<int>(scene->m_id.id());
+        return -1;
+    }
+}
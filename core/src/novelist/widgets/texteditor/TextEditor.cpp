@@ -17,6 +17,7 @@
 #include <QRegularExpression>
 #include <QApplication>
 #include "document/NoteInsight.h"
+#include "util/Profiler.h"
 #include "widgets/texteditor/TextEditor.h"
 #include "windows/NoteEditWindow.h"
 
@@ -28,6 +29,8 @@ namespace novelist {
     {
         connect(this, &TextEditor::textChanged, this, &TextEditor::onTextChanged);
         connect(this, &TextEditor::blockCountChanged, this, &TextEditor::updateParagraphNumberAreaWidth);
+        connect(this, &TextEditor::blockCountChanged, this, &TextEditor::updateVisibleBlocks);
+        connect(verticalScrollBar(), &QScrollBar::valueChanged, this, &TextEditor::updateVisibleBlocks);
         connect(this, &TextEditor::cursorPositionChanged, this, &TextEditor::highlightCurrentLine);
         connect(this, &TextEditor::cursorPositionChanged, this, &TextEditor::highlightMatchingChars);
         connect(this, &TextEditor::cursorPositionChanged, this, &TextEditor::onCursorPositionChanged);
@@ -109,18 +112,39 @@ namespace novelist {
         return m_showParagraphNumberArea;
     }
 
+    void TextEditor::setLargeDocumentThreshold(int blockCount) noexcept
+    {
+        m_largeDocThreshold = blockCount;
+        if (document() != nullptr)
+            document()->insightManager().setLargeDocumentThreshold(blockCount);
+    }
+
+    void TextEditor::setInspectionDelay(int msec) noexcept
+    {
+        m_insightMgr.setQuietPeriod(msec);
+    }
+
     SceneDocument* TextEditor::document() const
     {
-        return dynamic_cast<SceneDocument*>(QTextEdit::document());
+        return m_document;
     }
 
     void TextEditor::setDocument(SceneDocument* document)
     {
+        m_document = document;
+        if (document != nullptr)
+            m_documentDestroyedConnection = connect(document, &QObject::destroyed, this, [this] { m_document = nullptr; });
+        else
+            m_documentDestroyedConnection = QMetaObject::Connection{};
         m_insights.clear();
         m_insights.setDocument(document);
         QTextEdit::setDocument(document);
         setDefaultBlockFormat();
         m_insightMgr.onDocumentChanged();
+        if (document != nullptr) {
+            document->insightManager().setLargeDocumentThreshold(m_largeDocThreshold);
+            updateVisibleBlocks();
+        }
     }
 
     void TextEditor::setDocument(QTextDocument* document)
@@ -146,10 +170,11 @@ namespace novelist {
         return false;
     }
 
-    void TextEditor::useInspectors(std::vector<std::unique_ptr<Inspector>> const* inspectors) noexcept
+    void TextEditor::useInspectors(std::vector<std::unique_ptr<Inspector>> const* inspectors,
+            QReadWriteLock* lock) noexcept
     {
-        QWriteLocker lock(&m_inspectorsLock);
         m_inspectors = inspectors;
+        m_inspectorsLock = lock;
     }
 
     void TextEditor::useCharReplacement(std::vector<CharacterReplacementRule> const* rules) noexcept
@@ -213,10 +238,14 @@ namespace novelist {
 
         QRect cr = contentsRect();
         m_paragraphNumberArea->setGeometry(QRect(cr.left(), cr.top(), paragraphNumberAreaWidth(), cr.height()));
+
+        updateVisibleBlocks();
     }
 
     void TextEditor::paintEvent(QPaintEvent* e)
     {
+        NOVELIST_PROFILE_SCOPE("TextEditor::paintEvent");
+
         QTextEdit::paintEvent(e);
 
         if (m_showParagraphNumberArea)
@@ -294,6 +323,8 @@ namespace novelist {
 
     void TextEditor::keyPressEvent(QKeyEvent* e)
     {
+        NOVELIST_PROFILE_SCOPE("TextEditor::keyPressEvent");
+
         if (m_charReplacementRules != nullptr) {
             for (auto r : *m_charReplacementRules) {
                 if (r.m_enableKey != Qt::NoModifier && !QApplication::keyboardModifiers().testFlag(r.m_enableKey))
@@ -342,22 +373,17 @@ namespace novelist {
 
     QTextBlock TextEditor::firstVisibleBlock() const
     {
-        QTextCursor curs{document()};
-        curs.movePosition(QTextCursor::Start);
-        for (int i = 0; i < document()->blockCount(); ++i) {
-            QTextBlock block = curs.block();
-
-            QRect r1 = viewport()->geometry();
-            QRect r2 = document()->documentLayout()->blockBoundingRect(block).translated(viewport()->geometry().x(),
-                    viewport()->geometry().y() - (verticalScrollBar()->value())).toRect();
-
-            if (r1.intersects(r2))
-                return block;
-
-            curs.movePosition(QTextCursor::NextBlock);
-        }
+        // Hit test is logarithmic in the amount of blocks, as opposed to checking each block's bounding rect
+        if (document() == nullptr)
+            return QTextBlock{};
+        return cursorForPosition(QPoint(0, 0)).block();
+    }
 
-        return QTextBlock{};
+    QTextBlock TextEditor::lastVisibleBlock() const
+    {
+        if (document() == nullptr)
+            return QTextBlock{};
+        return cursorForPosition(QPoint(0, qMax(0, viewport()->height() - 1))).block();
     }
 
     void TextEditor::onTextChanged()
@@ -459,7 +485,10 @@ namespace novelist {
             bb.translate(viewport()->geometry().x() - paragraphNumberAreaWidth() + block.blockFormat().leftMargin(),
                     viewport()->geometry().y() - verticalScrollBar()->value());
 
-            if (bb.top() <= event->rect().bottom() && bb.bottom() >= event->rect().top()) {
+            if (bb.top() > event->rect().bottom())
+                break;
+
+            if (bb.bottom() >= event->rect().top()) {
                 QString number = QString::number(blockNumber + 1);
 
                 QFont const& font = block.begin() != block.end() ? block.begin().fragment().charFormat().font()
@@ -482,6 +511,17 @@ namespace novelist {
         setViewportMargins(paragraphNumberAreaWidth(), 0, 0, 0);
     }
 
+    void TextEditor::updateVisibleBlocks()
+    {
+        if (document() == nullptr)
+            return;
+
+        auto first = firstVisibleBlock();
+        auto last = lastVisibleBlock();
+        if (first.isValid() && last.isValid())
+            document()->insightManager().setVisibleBlocks(first.blockNumber(), last.blockNumber());
+    }
+
     void TextEditor::updateParagraphNumberArea(QRect const& rect, int dy)
     {
         if (dy != 0)
@@ -6,28 +6,359 @@
  * @brief
  * @details
  **********************************************************/
+#include <algorithm>
+#include <atomic>
 #include <QtWidgets/QToolTip>
 #include <QtGui/QTextCursor>
 #include <QtCore/QCoreApplication>
 #include <QtConcurrent/QtConcurrent>
 #include "widgets/texteditor/TextEditorInsightManager.h"
 #include "widgets/texteditor/Inspector.h"
+#include "widgets/texteditor/InspectionCache.h"
+#include "widgets/texteditor/InspectionMetrics.h"
 #include "widgets/texteditor/TextEditor.h"
+#include "util/Profiler.h"
 
 namespace novelist {
+    namespace {
+        /**
+         * @return Thread pool dedicated to inspection tasks, so slow inspectors can't starve the global pool
+         */
+        QThreadPool& inspectionPool()
+        {
+            static QThreadPool pool;
+            return pool;
+        }
+
+        /**
+         * @return Thread pool for refreshes. Refreshes mostly wait for their inspections, so they get their own pool
+         *         and neither occupy inspection threads nor the global pool.
+         */
+        QThreadPool& refreshPool()
+        {
+            static QThreadPool pool;
+            return pool;
+        }
+
+        /**
+         * State shared between all tasks of a single refresh
+         */
+        struct InspectionGraph {
+            InspectionGraph(internal::InspectionRequest const& request,
+                    std::vector<std::unique_ptr<Inspector>> const* inspectors, QReadWriteLock* rwlock,
+                    size_t inspectorCount)
+                    :m_request(request),
+                     m_inspectors(inspectors),
+                     m_rwlock(rwlock),
+                     m_results(inspectorCount, std::vector<InspectionBlockResult>(request.m_blocks.size())),
+                     m_inspected(inspectorCount, std::vector<char>(request.m_blocks.size(), false)),
+                     m_pendingBlocks(inspectorCount),
+                     m_batchSizes(inspectorCount, 1),
+                     m_nextChunk(inspectorCount),
+                     m_remaining(request.m_blocks.size()),
+                     m_failed(request.m_blocks.size()),
+                     m_metrics(inspectorCount, nullptr)
+            {
+                m_started.start();
+                for (auto& n : m_nextChunk)
+                    n.store(0);
+                for (auto& n : m_remaining)
+                    n.store(0);
+                for (auto& f : m_failed)
+                    f.store(false);
+            }
+
+            /**
+             * Sends the merged result of a block to the manager, unless the block was cancelled
+             * @param block Block index
+             */
+            void postResult(size_t block) const
+            {
+                if (m_request.m_cancelled[block]->load())
+                    return;
+
+                // Merge in inspector order, so the result doesn't depend on scheduling
+                InspectionBlockResult result;
+                for (auto const& inspectorResults : m_results)
+                    result.insert(result.end(), inspectorResults[block].begin(), inspectorResults[block].end());
+                QCoreApplication::postEvent(m_request.m_receiver, new internal::InspectionResultEvent(m_request.m_batch,
+                        block, std::move(result), !m_failed[block].load()));
+            }
+
+            /**
+             * Called once per inspector and block. The last call for a block posts its result.
+             * @param block Block index
+             */
+            void finishBlock(size_t block) const
+            {
+                if (m_remaining[block].fetch_sub(1) == 1)
+                    postResult(block);
+            }
+
+            /**
+             * @param inspector Inspector index
+             * @return Amount of calls needed to inspect all pending blocks of an inspector
+             */
+            size_t chunkCount(size_t inspector) const noexcept
+            {
+                size_t const blockCount = m_pendingBlocks[inspector].size();
+                size_t const batchSize = m_batchSizes[inspector];
+                return blockCount == 0 ? 0 : 1 + (blockCount - 1 + batchSize - 1) / batchSize;
+            }
+
+            /**
+             * Inspects a chunk of pending blocks. The chunk is done once the inspector calls back, which synchronous
+             * inspectors do right away and asynchronous ones possibly later from another thread. Must be called with
+             * m_rwlock locked for reading.
+             * @param inspector Inspector index
+             * @param chunk Chunk index
+             * @param inFlight Released when the chunk is done, may be nullptr
+             */
+            void runChunk(size_t inspector, size_t chunk, QSemaphore* inFlight)
+            {
+                // The block with the highest priority, usually the one under the cursor, always gets a call of its
+                // own, so its result isn't held back by a whole batch
+                auto const& pending = m_pendingBlocks[inspector];
+                size_t const batchSize = m_batchSizes[inspector];
+                size_t const first = chunk == 0 ? 0 : 1 + (chunk - 1) * batchSize;
+                size_t const last = chunk == 0 ? 1 : std::min(first + batchSize, pending.size());
+                std::vector<size_t> blocks;
+                std::vector<QString> texts;
+                std::vector<InspectionCancelToken> tokens;
+                for (size_t i = first; i < last; ++i) {
+                    size_t const block = pending[i];
+                    if (m_request.m_cancelled[block]->load())
+                        finishBlock(block);
+                    else {
+                        blocks.push_back(block);
+                        texts.push_back(m_request.m_blocks[block]);
+                        tokens.push_back(m_request.m_cancelled[block]);
+                    }
+                }
+
+                QElapsedTimer callTimer;
+                callTimer.start();
+                auto const queueNanos = static_cast<uint64_t>(m_started.nsecsElapsed());
+                auto done = [this, inspector, blocks, inFlight, callTimer, queueNanos](
+                        std::vector<std::optional<InspectionBlockResult>> results) {
+                    if (!blocks.empty() && m_metrics[inspector] != nullptr) {
+                        m_metrics[inspector]->recordCall(blocks.size(), queueNanos,
+                                static_cast<uint64_t>(callTimer.nsecsElapsed()));
+                        if (results.size() < blocks.size())
+                            m_metrics[inspector]->recordError();
+                    }
+
+                    // Results of cancelled blocks might be incomplete, so they are neither posted nor cached. Blocks
+                    // without a result failed and are posted with what the other inspectors found, but not cached.
+                    for (size_t i = 0; i < blocks.size(); ++i) {
+                        if (m_request.m_cancelled[blocks[i]]->load())
+                            continue;
+                        if (i < results.size() && results[i]) {
+                            m_results[inspector][blocks[i]] = std::move(*results[i]);
+                            m_inspected[inspector][blocks[i]] = true;
+                        }
+                        else
+                            m_failed[blocks[i]] = true;
+                    }
+                    for (size_t block : blocks)
+                        finishBlock(block);
+                    if (inFlight != nullptr)
+                        inFlight->release();
+                    m_doneChunks.release();
+                };
+
+                if (blocks.empty() || m_inspectors == nullptr || inspector >= m_inspectors->size()) {
+                    done({});
+                    return;
+                }
+
+                NOVELIST_PROFILE_SCOPE("TextEditorInsightManager::inspectBlock");
+                (*m_inspectors)[inspector]->inspectAsync(std::move(texts), m_request.m_lang, std::move(tokens),
+                        std::move(done));
+            }
+
+            internal::InspectionRequest const& m_request;
+            std::vector<std::unique_ptr<Inspector>> const* m_inspectors;
+            QReadWriteLock* m_rwlock;
+            std::vector<std::vector<InspectionBlockResult>> m_results; // Indexed by [inspector][block]
+            std::vector<std::vector<char>> m_inspected; // Indexed by [inspector][block]
+            std::vector<std::vector<size_t>> m_pendingBlocks; // Blocks without cached result, per inspector
+            std::vector<size_t> m_batchSizes; // Blocks per call, per inspector
+            std::vector<std::atomic<size_t>> m_nextChunk; // Next chunk of m_pendingBlocks, per inspector
+            mutable std::vector<std::atomic<size_t>> m_remaining; // Inspectors that still need to process a block
+            std::vector<std::atomic_bool> m_failed; // Per block, set if an inspector couldn't inspect it
+            std::vector<InspectorMetrics*> m_metrics; // Per inspector
+            QElapsedTimer m_started;
+            QSemaphore m_doneLanes;
+            QSemaphore m_doneChunks;
+        };
+
+        /**
+         * Inspects blocks with a single synchronous inspector until there are no blocks left. Each inspector gets as
+         * many lanes as it allows concurrent calls, and all lanes of an inspector pull chunks of blocks from the same
+         * counter, as many blocks at once as the inspector's batch size. Whichever lane finishes the last inspector of
+         * a block posts the block's result.
+         */
+        class InspectionLane : public QRunnable {
+        public:
+            InspectionLane(InspectionGraph& graph, size_t inspector) noexcept
+                    :m_graph(graph),
+                     m_inspector(inspector)
+            {
+            }
+
+            void run() override
+            {
+                auto releaseLane = gsl::finally([this] { m_graph.m_doneLanes.release(); });
+                size_t chunk;
+                while ((chunk = m_graph.m_nextChunk[m_inspector].fetch_add(1)) < m_graph.chunkCount(m_inspector)) {
+                    QReadLocker lock(m_graph.m_rwlock);
+                    m_graph.runChunk(m_inspector, chunk, nullptr);
+                }
+            }
+
+        private:
+            InspectionGraph& m_graph;
+            size_t m_inspector;
+        };
+    }
+
+    namespace internal {
+        void runInspection(InspectionRequest request, std::vector<std::unique_ptr<Inspector>> const* inspectors,
+                QReadWriteLock* rwlock)
+        {
+            auto const& blocks = request.m_blocks;
+            auto const& cache = request.m_cache;
+            auto const cacheKeys = [&] {
+                std::vector<QByteArray> keys;
+                QReadLocker lock(rwlock);
+                if (inspectors != nullptr) {
+                    for (auto const& inspector : *inspectors)
+                        keys.push_back(cache ? inspector->cacheKey() : QByteArray());
+                }
+                return keys;
+            };
+
+            auto const inspectorKeys = cacheKeys();
+            InspectionGraph graph(request, inspectors, rwlock, inspectorKeys.size());
+
+            {
+                QReadLocker lock(rwlock);
+                for (size_t i = 0; inspectors != nullptr && i < inspectorKeys.size() && i < inspectors->size(); ++i)
+                    graph.m_metrics[i] = &InspectionMetrics::instance().inspector((*inspectors)[i]->name());
+            }
+
+            // Cached results are taken as they are, only the remaining blocks need to be inspected
+            std::vector<std::vector<QByteArray>> blockKeys(inspectorKeys.size());
+            for (size_t i = 0; i < inspectorKeys.size(); ++i) {
+                size_t cacheHits = 0;
+                for (size_t b = 0; b < blocks.size(); ++b) {
+                    if (!inspectorKeys[i].isEmpty()) {
+                        blockKeys[i].push_back(InspectionCache::makeKey(blocks[b], request.m_lang, inspectorKeys[i]));
+                        if (auto cached = cache->find(blockKeys[i].back())) {
+                            graph.m_results[i][b] = std::move(*cached);
+                            ++cacheHits;
+                            continue;
+                        }
+                    }
+                    graph.m_pendingBlocks[i].push_back(b);
+                    ++graph.m_remaining[b];
+                }
+                if (graph.m_metrics[i] != nullptr)
+                    graph.m_metrics[i]->recordCacheHits(cacheHits);
+            }
+
+            // Blocks that are completely cached are done right away
+            for (size_t b = 0; b < blocks.size(); ++b) {
+                if (graph.m_remaining[b] == 0)
+                    graph.postResult(b);
+            }
+
+            // Every (block, inspector) pair is a separate task. Tasks of the same synchronous inspector are spread over
+            // at most maxConcurrency() lanes, which keep pulling blocks in order of priority until all are done.
+            // Asynchronous inspectors don't need a thread while they wait, their chunks are submitted from here
+            // instead.
+            std::vector<int> laneCounts;
+            std::vector<size_t> asyncInspectors;
+            std::vector<std::unique_ptr<QSemaphore>> asyncSlots;
+            size_t totalChunks = 0;
+            {
+                QReadLocker lock(rwlock);
+                if (inspectors != nullptr) {
+                    int const poolSize = std::max(1, request.m_maxLanes > 0
+                            ? std::min(request.m_maxLanes, inspectionPool().maxThreadCount())
+                            : inspectionPool().maxThreadCount());
+                    for (size_t i = 0; i < inspectorKeys.size() && i < inspectors->size(); ++i) {
+                        auto const& inspector = (*inspectors)[i];
+                        graph.m_batchSizes[i] = static_cast<size_t>(std::max(1, inspector->batchSize()));
+                        totalChunks += graph.chunkCount(i);
+                        int const pending = gsl::narrow_cast<int>(graph.chunkCount(i));
+                        int const limit = inspector->maxConcurrency();
+                        if (inspector->isAsync()) {
+                            laneCounts.push_back(0);
+                            asyncInspectors.push_back(i);
+                            asyncSlots.push_back(
+                                    std::make_unique<QSemaphore>(limit > 0 ? limit : std::max(1, pending)));
+                            continue;
+                        }
+                        int const maxLanes = std::min(pending, poolSize);
+                        laneCounts.push_back(limit > 0 ? std::min(limit, maxLanes) : maxLanes);
+                    }
+                }
+            }
+
+            int totalLanes = 0;
+            for (size_t i = 0; i < laneCounts.size(); ++i) {
+                for (int l = 0; l < laneCounts[i]; ++l)
+                    inspectionPool().start(new InspectionLane(graph, i));
+                totalLanes += laneCounts[i];
+            }
+
+            // At most maxConcurrency() calls of an asynchronous inspector are pending at once
+            for (size_t a = 0; a < asyncInspectors.size(); ++a) {
+                size_t const i = asyncInspectors[a];
+                for (size_t chunk = 0; chunk < graph.chunkCount(i); ++chunk) {
+                    asyncSlots[a]->acquire();
+                    QReadLocker lock(rwlock);
+                    graph.runChunk(i, chunk, asyncSlots[a].get());
+                }
+            }
+
+            graph.m_doneLanes.acquire(totalLanes);
+            graph.m_doneChunks.acquire(gsl::narrow_cast<int>(totalChunks));
+
+            // Results are only cached if the inspector's key didn't change in the meantime
+            if (cache && cacheKeys() == inspectorKeys) {
+                for (size_t i = 0; i < inspectorKeys.size(); ++i) {
+                    if (inspectorKeys[i].isEmpty())
+                        continue;
+                    for (size_t b : graph.m_pendingBlocks[i]) {
+                        if (graph.m_inspected[i][b])
+                            cache->insert(blockKeys[i][b], graph.m_results[i][b]);
+                    }
+                }
+            }
+        }
+    }
 
     TextEditorInsightManager::TextEditorInsightManager(gsl::not_null<TextEditor*> editor) noexcept
             :QObject(nullptr),
              m_editor(editor)
     {
-        onDocumentChanged();
+        // The timer only runs while there is something to inspect
+        m_updateTimer.setSingleShot(true);
         connect(&m_updateTimer, &QTimer::timeout, this, &TextEditorInsightManager::onUpdate);
-        m_updateTimer.start(1000);
+        connect(&m_updateWatcher, &QFutureWatcher<void>::finished, this,
+                &TextEditorInsightManager::finishAutoInsightRefresh);
+        connect(m_editor.get(), &TextEditor::cursorPositionChanged, this,
+                &TextEditorInsightManager::onCursorPositionChanged);
+        onDocumentChanged();
     }
 
     TextEditorInsightManager::~TextEditorInsightManager() noexcept
     {
         m_updateTimer.stop();
+        cancelAutoInsightRefresh();
         if (m_updateResults.isRunning())
             m_updateResults.waitForFinished();
     }
@@ -35,10 +366,35 @@ namespace novelist {
     void TextEditorInsightManager::reinspect() noexcept
     {
         if (m_editor->document()) {
+            m_blockCount = m_editor->document()->blockCount();
             m_needUpdateBlocks.clear();
-            for (auto b = m_editor->document()->begin(); b != m_editor->document()->end(); b = b.next())
-                m_needUpdateBlocks.push_back(b);
+            m_needUpdateBlocks.insert(0, m_blockCount);
+            // Everything in flight is superseded now
+            cancelAutoInsightRefresh();
+            m_updateTimer.start(0);
+        }
+    }
+
+    void TextEditorInsightManager::setQuietPeriod(int msec) noexcept
+    {
+        m_quietPeriod = std::max(0, msec);
+        m_currentDelay = m_quietPeriod;
+    }
+
+    int TextEditorInsightManager::quietPeriod() const noexcept
+    {
+        return m_quietPeriod;
+    }
+
+    bool TextEditorInsightManager::event(QEvent* event)
+    {
+        if (event->type() == internal::InspectionResultEvent::s_eventId) {
+            auto* resultEvent = static_cast<internal::InspectionResultEvent*>(event);
+            applyBlockResult(resultEvent->m_batch, resultEvent->m_index, resultEvent->m_result);
+            resultEvent->accept();
+            return true;
         }
+        return QObject::event(event);
     }
 
     void TextEditorInsightManager::onMousePosChanged(QPoint pos)
@@ -68,6 +424,14 @@ namespace novelist {
 
     void TextEditorInsightManager::onDocumentChanged()
     {
+        // Results of a running refresh belong to the previous document
+        cancelAutoInsightRefresh();
+        m_updatingBlocks.clear();
+        m_needUpdateBlocks.clear();
+        m_updateTimer.stop();
+        m_lastCursorBlock = -1;
+        ++m_batch;
+
         if (m_editor->document()) {
             m_contentsChangeConnection = connect(m_editor->document(),
                     &SceneDocument::contentsChange, this, &TextEditorInsightManager::onContentsChange);
@@ -77,77 +441,175 @@ namespace novelist {
             m_contentsChangeConnection.disconnect();
     }
 
-    void TextEditorInsightManager::startAutoInsightRefresh()
+    void TextEditorInsightManager::markDirty(int firstBlock, int lastBlock)
     {
-        std::vector<QString> blocks;
-        for (auto const& e : m_needUpdateBlocks)
-            blocks.push_back(e.text());
+        m_needUpdateBlocks.insert(firstBlock, lastBlock + 1);
+
+        // Don't waste time on a text that is outdated already
+        for (auto& job : m_updatingBlocks) {
+            if (job.m_cancelled->load())
+                continue;
+            int const n = job.m_block.blockNumber();
+            if (n >= firstBlock && n <= lastBlock)
+                job.m_cancelled->store(true);
+        }
 
-        m_updatingBlocks = std::move(m_needUpdateBlocks);
-        m_updateResults = QtConcurrent::run(runAutoInsightRefresh, blocks, m_editor->m_inspectors,
-                &m_editor->m_inspectorsLock, m_editor->document()->language());
+        scheduleUpdate();
     }
 
-    void TextEditorInsightManager::finishAutoInsightRefresh()
+    void TextEditorInsightManager::scheduleUpdate()
     {
-        if (m_editor->document() == nullptr)
-            return;
+        // Changes within the quiet period of each other form a burst. Every further change in a burst pushes the
+        // inspection out a bit more, so fast typing doesn't keep preempting inspections of the blocks around it.
+        if (m_lastChange.isValid() && m_lastChange.elapsed() < m_currentDelay)
+            m_currentDelay = std::min(m_currentDelay * 3 / 2, m_quietPeriod * s_maxBackoffFactor);
+        else
+            m_currentDelay = m_quietPeriod;
+        m_lastChange.restart();
+        m_updateTimer.start(m_currentDelay);
+    }
 
-        auto const& blocks = m_updateResults.result();
-        Q_ASSERT(blocks.size() == m_updatingBlocks.size());
-        for (size_t i = 0; i < blocks.size(); ++i) {
-            auto const& b = blocks[i];
-            auto const& ub = m_updatingBlocks[i];
-            if (!ub.isValid())
-                continue;
+    void TextEditorInsightManager::cancelAutoInsightRefresh() noexcept
+    {
+        for (auto& job : m_updatingBlocks)
+            job.m_cancelled->store(true);
+    }
 
-            m_editor->m_insights.removeNonPersistentInRange(ub.position(), ub.position() + ub.length());
+    void TextEditorInsightManager::startAutoInsightRefresh()
+    {
+        NOVELIST_PROFILE_SCOPE("TextEditorInsightManager::startAutoInsightRefresh");
 
-            for (auto const& insight : b) {
-                int left = ub.position() + insight.m_left;
-                int right = ub.position() + insight.m_right;
-                auto ptr = insight.m_factory->create(m_editor->document(), left, right);
-                if (ptr)
-                    m_editor->m_insights.insert(std::move(ptr));
+        if (m_editor->document() == nullptr)
+            return;
+
+        // The block under the cursor comes first, then the visible blocks, then the rest by distance to the cursor
+        int const cursorBlock = m_editor->textCursor().blockNumber();
+        int const firstVisible = m_editor->firstVisibleBlock().blockNumber();
+        int const lastVisible = m_editor->lastVisibleBlock().blockNumber();
+        int const blockCount = m_editor->document()->blockCount();
+        std::vector<std::pair<std::pair<int, int>, int>> ordered;
+        ordered.reserve(m_needUpdateBlocks.size());
+        for (auto const& [first, last] : m_needUpdateBlocks) {
+            for (int n = first; n < std::min(last, blockCount); ++n) {
+                int const category = n == cursorBlock ? 0 : (n >= firstVisible && n <= lastVisible ? 1 : 2);
+                ordered.push_back({{category, std::abs(n - cursorBlock)}, n});
             }
         }
-        m_updateResults = decltype(m_updateResults)();
+        std::sort(ordered.begin(), ordered.end());
+        m_needUpdateBlocks.clear();
+
+        internal::InspectionRequest request{{}, {}, m_editor->document()->language(),
+                                            m_editor->document()->inspectionCache(), this, ++m_batch, 0};
+        m_updatingBlocks.clear();
+        for (auto const& [priority, n] : ordered) {
+            auto block = m_editor->document()->findBlockByNumber(n);
+            request.m_blocks.push_back(block.text());
+            request.m_cancelled.push_back(std::make_shared<std::atomic_bool>(false));
+            m_updatingBlocks.push_back({block, request.m_cancelled.back()});
+        }
+
+        m_updateResults = QtConcurrent::run(&refreshPool(), internal::runInspection, std::move(request),
+                m_editor->m_inspectors, m_editor->m_inspectorsLock);
+        m_updateWatcher.setFuture(m_updateResults);
     }
 
-    InspectionResult TextEditorInsightManager::runAutoInsightRefresh(std::vector<QString> blocks,
-            std::vector<std::unique_ptr<Inspector>> const* inspectors, QReadWriteLock* rwlock, Language lang)
+    void TextEditorInsightManager::finishAutoInsightRefresh()
     {
-        InspectionResult results;
-        for (auto const& text : blocks) {
+        NOVELIST_PROFILE_SCOPE("TextEditorInsightManager::finishAutoInsightRefresh");
+        QElapsedTimer timer;
+        timer.start();
+        auto recordTime = gsl::finally([&timer] {
+            InspectionMetrics::instance().recordFinishRefresh(static_cast<uint64_t>(timer.nsecsElapsed()));
+        });
 
-            QReadLocker lock(rwlock);
-            InspectionBlockResult blockResult{};
-            for (auto const& inspector : *inspectors) {
-                auto result = inspector->inspect(text, lang);
-                blockResult.insert(blockResult.end(), result.begin(), result.end());
-            }
+        // Results are posted before the refresh finishes, make sure they are all applied
+        QCoreApplication::sendPostedEvents(this, internal::InspectionResultEvent::s_eventId);
 
-            results.push_back(std::move(blockResult));
+        // Blocks that were skipped are scheduled again, unless they changed in the meantime anyway
+        for (auto const& job : m_updatingBlocks) {
+            if (!job.m_done && job.m_block.isValid())
+                m_needUpdateBlocks.insert(job.m_block.blockNumber());
         }
+        m_updatingBlocks.clear();
+
+        // If the author is still typing, the timer picks up the remaining blocks once they pause
+        if (!m_needUpdateBlocks.empty() && !m_updateTimer.isActive())
+            startAutoInsightRefresh();
+    }
+
+    void TextEditorInsightManager::applyBlockResult(uint64_t batch, size_t index, InspectionBlockResult const& result)
+    {
+        if (batch != m_batch || index >= m_updatingBlocks.size() || m_editor->document() == nullptr)
+            return;
+
+        auto& job = m_updatingBlocks[index];
+        job.m_done = true;
+        if (!job.m_block.isValid())
+            return;
+
+        // Blocks leave the dirty set when the refresh starts, so being in there again means the block changed since
+        if (m_needUpdateBlocks.contains(job.m_block.blockNumber()))
+            return;
+
+        QElapsedTimer timer;
+        timer.start();
+        auto recordTime = gsl::finally([&timer] {
+            InspectionMetrics::instance().recordApplyResult(static_cast<uint64_t>(timer.nsecsElapsed()));
+        });
+
+        // Old and new insights of the block are swapped within one batch, so the block is only rehighlighted once
+        auto& insightMgr = m_editor->document()->insightManager();
+        insightMgr.beginBatch();
+        auto batchGuard = gsl::finally([&insightMgr] { insightMgr.endBatch(); });
+
+        int const position = job.m_block.position();
+        m_editor->m_insights.removeNonPersistentInRange(position, position + job.m_block.length());
 
-        return results;
+        std::vector<InsightBatchEntry> batchEntries;
+        batchEntries.reserve(result.size());
+        for (auto const& insight : result)
+            batchEntries.push_back({insight.m_factory.get(), position + insight.m_left, position + insight.m_right});
+        m_editor->m_insights.insert(createInsights(m_editor->document(), batchEntries));
     }
 
-    void TextEditorInsightManager::onContentsChange(int pos, int /*removed*/, int /*added*/)
+    void TextEditorInsightManager::onContentsChange(int pos, int /*removed*/, int added)
     {
-        // Mark the changed block for future refresh of auto insights
-        auto block = m_editor->document()->findBlock(pos);
-        if (std::count(m_needUpdateBlocks.begin(), m_needUpdateBlocks.end(), block) == 0)
-            m_needUpdateBlocks.push_back(block);
+        auto* doc = m_editor->document();
+        int const blockCount = doc->blockCount();
+        int const delta = blockCount - m_blockCount;
+        m_blockCount = blockCount;
+
+        // All blocks touched by the change need a refresh. Paragraphs that were inserted or removed behind the first
+        // one shift the numbers of all following dirty blocks.
+        int const firstBlock = doc->findBlock(pos).blockNumber();
+        auto last = doc->findBlock(std::min(pos + added, doc->characterCount() - 1));
+        int const lastBlock = last.isValid() ? last.blockNumber() : blockCount - 1;
+        m_needUpdateBlocks.shift(firstBlock + 1, delta);
+        markDirty(firstBlock, std::max(firstBlock, lastBlock));
     }
 
     void TextEditorInsightManager::onUpdate()
     {
-        if (m_updateResults.isFinished()) {
-            if (!m_updateResults.isCanceled()) // Future is set as finished and cancelled if default-constructed
-                finishAutoInsightRefresh();
+        if (m_updateResults.isRunning()) {
+            // New changes preempt the running refresh. Blocks that weren't started yet are rescheduled together with
+            // the changed ones as soon as it finishes, so the blocks around the cursor come first again.
             if (!m_needUpdateBlocks.empty())
-                startAutoInsightRefresh();
+                cancelAutoInsightRefresh();
         }
+        else if (!m_needUpdateBlocks.empty())
+            startAutoInsightRefresh();
+    }
+
+    void TextEditorInsightManager::onCursorPositionChanged()
+    {
+        // Leaving a changed paragraph means the author is done with it for now, so don't wait for the quiet period
+        int const cursorBlock = m_editor->textCursor().blockNumber();
+        if (cursorBlock == m_lastCursorBlock)
+            return;
+        m_lastCursorBlock = cursorBlock;
+
+        bool const dirty = m_needUpdateBlocks.size() > (m_needUpdateBlocks.contains(cursorBlock) ? 1u : 0u);
+        if (dirty)
+            m_updateTimer.start(0);
     }
-}
\ No newline at end of file
+}
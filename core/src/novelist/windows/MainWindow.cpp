@@ -30,6 +30,8 @@ namespace novelist {
         m_ui->setupUi(this);
         m_ui->sceneTabWidget->useInsightView(m_ui->insightView);
         m_ui->insightView->useSceneTabWidget(m_ui->sceneTabWidget);
+        m_inspectionService.useInspectors(m_ui->sceneTabWidget->inspectors(), m_ui->sceneTabWidget->inspectorsLock());
+        m_ui->projectView->useInspectionService(&m_inspectionService);
 
         // Replace some actions with appropriate delegate actions
         m_ui->action_Undo = replaceMenuAction(m_ui->menu_Edit, m_ui->action_Undo, &m_undoAction);
@@ -295,6 +297,7 @@ namespace novelist {
 
     void MainWindow::onProjectChanged(ProjectModel* m)
     {
+        m_inspectionService.setProject(m);
         if (m == nullptr) {
             m_ui->menuExport->setEnabled(false);
             m_ui->action_New_Project->setEnabled(true);
@@ -358,7 +361,7 @@ namespace novelist {
 
     void MainWindow::onAboutToShowInspectionMenu()
     {
-        auto* editor = dynamic_cast<TextEditor*>(m_ui->sceneTabWidget->currentWidget());
+        auto* editor = m_ui->sceneTabWidget->currentEditor();
         if (editor) {
             QModelIndex insightIdx = editor->insights()->find(editor->textCursor().position());
             if (insightIdx.isValid()) {
@@ -0,0 +1,75 @@
+/**********************************************************
+ * @file   DawgTest.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+
+#include <algorithm>
+#include <catch.hpp>
+#include <datastructures/Dawg.h>
+
+using namespace novelist;
+
+TEST_CASE("Dawg lookup", "[DataStructures][Dawg]")
+{
+    Dawg dawg = Dawg::build({"tap", "taps", "top", "tops", "tap", "", "Straße", "hop", "hops"});
+    REQUIRE(dawg.wordCount() == 7);
+    REQUIRE(dawg.contains("tap"));
+    REQUIRE(dawg.contains("tops"));
+    REQUIRE(dawg.contains("Straße"));
+    REQUIRE(!dawg.contains("ta"));
+    REQUIRE(!dawg.contains("tapss"));
+    REQUIRE(!dawg.contains("Tap"));
+    REQUIRE(!dawg.contains(""));
+
+    SECTION("Common suffixes are shared") {
+        // A trie needs 11 edges, the minimal graph shares the "ps" behind "ta", "to" and "ho"
+        Dawg trieLike = Dawg::build({"taps", "tops", "hops"});
+        REQUIRE(trieLike.edgeCount() == 7);
+    }
+
+    SECTION("Empty graph") {
+        Dawg empty;
+        REQUIRE(empty.wordCount() == 0);
+        REQUIRE(!empty.contains("tap"));
+        REQUIRE(empty.suggest("tap", 2, 10).empty());
+    }
+}
+
+TEST_CASE("Dawg serialization", "[DataStructures][Dawg]")
+{
+    Dawg dawg = Dawg::build({"alpha", "beta", "gamma"});
+
+    auto copy = Dawg::fromData(dawg.data());
+    REQUIRE(copy);
+    REQUIRE(copy->wordCount() == 3);
+    REQUIRE(copy->contains("beta"));
+    REQUIRE(!copy->contains("delta"));
+
+    QByteArray corrupt = dawg.data();
+    corrupt.chop(1);
+    REQUIRE(!Dawg::fromData(corrupt));
+    REQUIRE(!Dawg::fromData(QByteArray("not a graph at all, really not")));
+}
+
+TEST_CASE("Dawg suggestions", "[DataStructures][Dawg]")
+{
+    Dawg dawg = Dawg::build({"house", "horse", "mouse", "hose", "houses", "louse", "garden"});
+
+    // Swapped characters count once
+    auto suggestions = dawg.suggest("hosue", 1, 10);
+    REQUIRE(suggestions.size() == 2);
+    REQUIRE(suggestions[0] == std::make_pair(QString("hose"), 1));
+    REQUIRE(suggestions[1] == std::make_pair(QString("house"), 1));
+
+    suggestions = dawg.suggest("houze", 2, 10);
+    REQUIRE(suggestions.front().first == "house");
+    for (size_t i = 1; i < suggestions.size(); ++i)
+        REQUIRE(suggestions[i - 1].second <= suggestions[i].second);
+    REQUIRE(std::none_of(suggestions.begin(), suggestions.end(), [](auto const& s) { return s.first == "garden"; }));
+
+    REQUIRE(dawg.suggest("houze", 2, 2).size() == 2);
+}
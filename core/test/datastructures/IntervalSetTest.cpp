@@ -0,0 +1,126 @@
+/**********************************************************
+ * @file   IntervalSetTest.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+
+#include <random>
+#include <set>
+#include <catch.hpp>
+#include <datastructures/IntervalSet.h>
+
+using namespace novelist;
+
+TEST_CASE("IntervalSet insert and erase", "[DataStructures][IntervalSet]")
+{
+    IntervalSet<int> set;
+    REQUIRE(set.empty());
+
+    set.insert(2, 5);
+    set.insert(7);
+    REQUIRE(set.size() == 4);
+    REQUIRE(set.intervalCount() == 2);
+    REQUIRE(!set.contains(1));
+    REQUIRE(set.contains(2));
+    REQUIRE(set.contains(4));
+    REQUIRE(!set.contains(5));
+    REQUIRE(set.contains(7));
+
+    SECTION("Touching intervals are merged") {
+        set.insert(5, 7);
+        REQUIRE(set.intervalCount() == 1);
+        REQUIRE(set.size() == 6);
+    }
+    SECTION("Overlapping intervals are merged") {
+        set.insert(0, 10);
+        REQUIRE(set.intervalCount() == 1);
+        REQUIRE(set.size() == 10);
+    }
+    SECTION("Erase splits intervals") {
+        set.erase(3);
+        REQUIRE(set.intervalCount() == 3);
+        REQUIRE(set.size() == 3);
+        REQUIRE(!set.contains(3));
+        REQUIRE(set.contains(4));
+    }
+    SECTION("Clear") {
+        set.clear();
+        REQUIRE(set.empty());
+        REQUIRE(set.intervalCount() == 0);
+    }
+}
+
+TEST_CASE("IntervalSet shift", "[DataStructures][IntervalSet]")
+{
+    IntervalSet<int> set;
+    set.insert(2, 5);
+    set.insert(8);
+
+    SECTION("Open a gap") {
+        set.shift(3, 2);
+        REQUIRE(set.size() == 4);
+        REQUIRE(set.contains(2));
+        REQUIRE(!set.contains(3));
+        REQUIRE(!set.contains(4));
+        REQUIRE(set.contains(5));
+        REQUIRE(set.contains(6));
+        REQUIRE(set.contains(10));
+    }
+    SECTION("Close a gap") {
+        set.shift(5, -3);
+        REQUIRE(set.size() == 4);
+        REQUIRE(set.intervalCount() == 1);
+        REQUIRE(set.contains(5));
+        REQUIRE(!set.contains(6));
+    }
+    SECTION("Remove values") {
+        set.shift(3, -2);
+        REQUIRE(set.size() == 2);
+        REQUIRE(set.contains(2));
+        REQUIRE(set.contains(3));
+        REQUIRE(set.contains(6));
+    }
+}
+
+TEST_CASE("IntervalSet matches std::set", "[DataStructures][IntervalSet]")
+{
+    std::mt19937 rng(42);
+    for (int round = 0; round < 200; ++round) {
+        IntervalSet<int> set;
+        std::set<int> reference;
+        for (int op = 0; op < 50; ++op) {
+            int const first = static_cast<int>(rng() % 60);
+            int const last = first + static_cast<int>(rng() % 10);
+            switch (rng() % 3) {
+                case 0:
+                    set.insert(first, last);
+                    for (int i = first; i < last; ++i)
+                        reference.insert(i);
+                    break;
+                case 1:
+                    set.erase(first, last);
+                    for (int i = first; i < last; ++i)
+                        reference.erase(i);
+                    break;
+                default: {
+                    int const delta = static_cast<int>(rng() % 9) - 4;
+                    set.shift(first, delta);
+                    std::set<int> shifted;
+                    for (int v : reference) {
+                        if (v < first)
+                            shifted.insert(v);
+                        else if (delta >= 0 || v >= first - delta)
+                            shifted.insert(v + delta);
+                    }
+                    reference = shifted;
+                }
+            }
+            REQUIRE(set.size() == reference.size());
+            for (int i = -10; i < 100; ++i)
+                REQUIRE(set.contains(i) == (reference.count(i) > 0));
+        }
+    }
+}
@@ -132,6 +132,19 @@ TEST_CASE("SortedVector insert", "[DataStructures][SortedVector]")
             ROW({-51, 44, 0, 999})
             ROW({87, 8, -424984, 283})
     )
+
+    DATA_SECTION("merge",
+            TESTFUN([&v](std::vector<int> l) {
+                auto const oldSize = v.size();
+                v.merge(l.begin(), l.end());
+                REQUIRE(v.size() == oldSize + l.size());
+                REQUIRE(isSorted(v));
+            }),
+            ROW(std::vector<int>{})
+            ROW(std::vector<int>{5})
+            ROW(std::vector<int>{7, -7, 1, 4})
+            ROW(std::vector<int>{87, 8, -424984, 283, 8})
+    )
 }
 
 TEST_CASE("SortedVector modify", "[DataStructures][SortedVector]")
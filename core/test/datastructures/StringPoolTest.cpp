@@ -0,0 +1,47 @@
+/**********************************************************
+ * @file   StringPoolTest.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+
+#include <vector>
+#include <catch.hpp>
+#include <datastructures/StringPool.h>
+
+using namespace novelist;
+
+TEST_CASE("StringPool intern", "[DataStructures][StringPool]")
+{
+    StringPool pool;
+    QString a = pool.intern(QString("Possible spelling mistake found."));
+    QString b = pool.intern(QString("Possible spelling mistake") + " found.");
+    QString c = pool.intern("Something else");
+
+    REQUIRE(pool.size() == 2);
+    REQUIRE(a == b);
+    REQUIRE(a.constData() == b.constData());
+    REQUIRE(a.constData() != c.constData());
+    REQUIRE(pool.intern(QString()).isNull());
+    REQUIRE(pool.size() == 2);
+
+    SECTION("Prune drops unused strings") {
+        c = QString();
+        pool.prune();
+        REQUIRE(pool.size() == 1);
+        REQUIRE(pool.intern("Possible spelling mistake found.").constData() == a.constData());
+    }
+    SECTION("Pool doesn't grow without bounds") {
+        for (int i = 0; i < 10000; ++i)
+            pool.intern(QString::number(i));
+        REQUIRE(pool.size() < 1000);
+    }
+    SECTION("Used strings survive automatic pruning") {
+        std::vector<QString> used;
+        for (int i = 0; i < 1000; ++i)
+            used.push_back(pool.intern(QString::number(i)));
+        REQUIRE(pool.size() == 1002);
+    }
+}
@@ -0,0 +1,83 @@
+/**********************************************************
+ * @file   PositionTrackerTest.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+
+#include <vector>
+#include <catch.hpp>
+#include <QtGui/QTextCursor>
+#include <QtGui/QTextDocument>
+#include <document/PositionTracker.h>
+
+using namespace novelist;
+
+TEST_CASE("PositionTracker handles", "[Document][PositionTracker]")
+{
+    PositionTracker tracker;
+    auto a = tracker.add(0, 4);
+    auto b = tracker.add(5, 7);
+    REQUIRE(tracker.size() == 2);
+    REQUIRE(tracker.range(a) == std::make_pair(0, 4));
+    REQUIRE(tracker.range(b) == std::make_pair(5, 7));
+
+    tracker.remove(a);
+    REQUIRE(tracker.size() == 1);
+    auto c = tracker.add(8, 12);
+    REQUIRE(c == a);
+    REQUIRE(tracker.range(c) == std::make_pair(8, 12));
+    REQUIRE(tracker.range(b) == std::make_pair(5, 7));
+}
+
+TEST_CASE("PositionTracker follows edits like cursors", "[Document][PositionTracker]")
+{
+    QTextDocument doc;
+    doc.setPlainText("This is some plain text.\nIt also has another block.");
+
+    PositionTracker tracker;
+    std::vector<std::pair<PositionTracker::Handle, QTextCursor>> ranges;
+    std::vector<std::pair<int, int>> const initial{{0, 4}, {5, 7}, {8, 12}, {13, 18}, {19, 23}, {25, 27}, {8, 18}};
+    for (auto [left, right] : initial) {
+        QTextCursor cursor(&doc);
+        cursor.setPosition(left);
+        cursor.setPosition(right, QTextCursor::KeepAnchor);
+        ranges.emplace_back(tracker.add(left, right), cursor);
+    }
+    QObject::connect(&doc, &QTextDocument::contentsChange, [&tracker](int pos, int removed, int added) {
+        tracker.update(pos, removed, added);
+    });
+
+    auto edit = [&doc](int left, int right, QString const& text) {
+        QTextCursor cursor(&doc);
+        cursor.setPosition(left);
+        cursor.setPosition(right, QTextCursor::KeepAnchor);
+        cursor.insertText(text);
+    };
+
+    SECTION("Insert") {
+        edit(8, 8, "really ");
+        edit(16, 16, "awesome");
+        edit(doc.characterCount() - 1, doc.characterCount() - 1, "!");
+    }
+    SECTION("Remove") {
+        edit(6, 14, "");
+        edit(0, 3, "");
+    }
+    SECTION("Replace") {
+        edit(10, 20, "ab");
+        edit(2, 3, "xyz");
+    }
+    SECTION("Replace with same length") {
+        edit(8, 12, "SOME");
+        edit(0, 7, "That is");
+    }
+    SECTION("Remove paragraph separator") {
+        edit(20, 26, "");
+    }
+
+    for (auto const& [handle, cursor] : ranges)
+        REQUIRE(tracker.range(handle) == std::make_pair(cursor.selectionStart(), cursor.selectionEnd()));
+}
@@ -7,9 +7,15 @@
  * @details
  **********************************************************/
 
+#include <algorithm>
 #include <QDebug>
 #include <catch.hpp>
+#include <QtGui/QTextCharFormat>
+#include <QtGui/QTextLayout>
+#include <document/InsightFactory.h>
+#include <document/NoteInsight.h>
 #include <document/SceneDocument.h>
+#include <document/SpellingInsight.h>
 
 using namespace novelist;
 
@@ -54,4 +60,92 @@ TEST_CASE("SceneDocument Cursor test", "[DataStructures][Document]")
     REQUIRE(doc.characterAt(cursor1.position()) == QChar{'T'});
     REQUIRE(doc.characterAt(cursor2.position()) == QChar{'m'});
     REQUIRE(doc.characterAt(cursor3.position()) == QChar{QChar::ParagraphSeparator});
-}
\ No newline at end of file
+}
+
+TEST_CASE("SceneDocument insights", "[DataStructures][Document]")
+{
+    SceneDocument doc(Language::en_US);
+    doc.setPlainText("This is some plain text.\nIt also has another block.");
+    auto& insights = doc.insightManager();
+    AutoInsightFactory<SpellingInsight> factory("Spelling mistake", {});
+
+    std::vector<std::unique_ptr<Insight>> batch;
+    batch.push_back(factory.create(&doc, 13, 18));
+    batch.push_back(factory.create(&doc, 0, 4));
+    batch.push_back(factory.create(&doc, 8, 12));
+    insights.insert(std::move(batch));
+    REQUIRE(insights.size() == 3);
+    REQUIRE(std::is_sorted(insights.begin(), insights.end(), internal::InsightPtrOrderCompare{}));
+
+    SECTION("Find overlapping") {
+        REQUIRE(insights.findOverlapping(5, 10) == std::make_pair(1, 2));
+        REQUIRE(insights.findOverlapping(2, 10) == std::make_pair(0, 2));
+        REQUIRE(insights.findOverlapping(25, 30) == std::make_pair(3, 3));
+    }
+    SECTION("Find overlapping nested") {
+        // Spans both blocks, so it reaches further than the insights behind it
+        insights.insert(factory.create(&doc, 1, 40));
+        REQUIRE(insights.findOverlapping(30, 35) == std::make_pair(1, 4));
+        REQUIRE(insights.findOverlapping(2, 10) == std::make_pair(0, 3));
+        REQUIRE(insights.findOverlapping(39, 45) == std::make_pair(1, 4));
+        REQUIRE(insights.findOverlapping(40, 45) == std::make_pair(4, 4));
+    }
+    SECTION("Erase range") {
+        insights.erase(insights.begin(), insights.begin() + 2);
+        REQUIRE(insights.size() == 1);
+        REQUIRE((*insights.begin())->range() == std::make_pair(13, 18));
+    }
+    SECTION("Remove collapsed") {
+        QTextCursor cursor(&doc);
+        cursor.setPosition(5);
+        cursor.setPosition(20, QTextCursor::KeepAnchor);
+        cursor.removeSelectedText();
+        QCoreApplication::sendPostedEvents(&insights);
+        REQUIRE(insights.size() == 1);
+        REQUIRE((*insights.begin())->range() == std::make_pair(0, 4));
+    }
+    SECTION("Change format") {
+        QTextCursor cursor(&doc);
+        cursor.setPosition(2);
+        cursor.setPosition(20, QTextCursor::KeepAnchor);
+        QTextCharFormat format;
+        format.setFontWeight(QFont::Bold);
+        cursor.mergeCharFormat(format);
+        QCoreApplication::sendPostedEvents(&insights);
+        REQUIRE(insights.size() == 3);
+        REQUIRE((*(insights.begin() + 1))->range() == std::make_pair(8, 12));
+    }
+    SECTION("Replace with same length") {
+        QTextCursor cursor(&doc);
+        cursor.setPosition(8);
+        cursor.setPosition(12, QTextCursor::KeepAnchor);
+        cursor.insertText("SOME");
+        QCoreApplication::sendPostedEvents(&insights);
+        REQUIRE(insights.size() == 2);
+        REQUIRE((*(insights.begin() + 1))->range() == std::make_pair(13, 18));
+    }
+}
+
+TEST_CASE("SceneDocument large document highlighting", "[DataStructures][Document]")
+{
+    SceneDocument doc(Language::en_US);
+    doc.setPlainText("First block.\nSecond block with a typo.\nThird block.\nFourth block.");
+    auto& insights = doc.insightManager();
+    insights.setLargeDocumentThreshold(1);
+    insights.setVisibleBlocks(0, 3);
+    REQUIRE(insights.isLargeDocument());
+
+    // A short insight sits between the start of the note and the last block the note spans
+    QTextBlock const second = doc.findBlockByNumber(1);
+    QTextBlock const third = doc.findBlockByNumber(2);
+    AutoInsightFactory<SpellingInsight> spelling("Spelling mistake", {});
+    BaseInsightFactory<NoteInsight> note("Note");
+    insights.insert(spelling.create(&doc, second.position() + 20, second.position() + 24));
+    insights.insert(note.create(&doc, 6, third.position() + 5));
+    REQUIRE(insights.size() == 2);
+
+    REQUIRE(!doc.findBlockByNumber(0).layout()->formats().isEmpty());
+    REQUIRE(second.layout()->formats().size() >= 2);
+    REQUIRE(!third.layout()->formats().isEmpty());
+    REQUIRE(doc.findBlockByNumber(3).layout()->formats().isEmpty());
+}
@@ -110,6 +110,25 @@ TEST_CASE("ProjectModel insert", "[Model]")
     )
 }
 
+TEST_CASE("ProjectModel new scenes share caches", "[Model]")
+{
+    ProjectModel model{properties};
+    fillModel(model);
+
+    auto document = [&model](ModelPath const& p) {
+        return qvariant_cast<SceneDocument*>(model.data(p.toModelIndex(&model), ProjectModel::DocumentRole));
+    };
+    REQUIRE(model.insertRow(0, NodeType::Scene, "foobar", ModelPath{0, 1}.toModelIndex(&model)));
+    SceneDocument* inserted = document({0, 1, 0});
+    REQUIRE(inserted != nullptr);
+    REQUIRE(inserted->inspectionCache() == model.inspectionCache());
+    REQUIRE(inserted->stringPool() == document({0, 0, 0})->stringPool());
+
+    SceneDocument* loaded = model.loadScene(ModelPath{0, 2}.toModelIndex(&model));
+    REQUIRE(loaded->inspectionCache() == model.inspectionCache());
+    REQUIRE(loaded->stringPool() == inserted->stringPool());
+}
+
 TEST_CASE("ProjectModel remove", "[Model]")
 {
     ProjectModel model{properties};
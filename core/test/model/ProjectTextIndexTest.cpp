@@ -0,0 +1,168 @@
+/**********************************************************
+ * @file   ProjectTextIndexTest.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+
+#include <algorithm>
+#include <catch.hpp>
+#include <QtGui/QTextCursor>
+#include "model/ProjectTextIndex.h"
+#include "document/SceneDocument.h"
+
+using namespace novelist;
+
+namespace {
+    using NodeType = ProjectModel::InsertableNodeType;
+
+    SceneDocument* addScene(ProjectModel& model, int row, QString const& text)
+    {
+        model.insertRow(row, NodeType::Scene, "Scene", model.projectRootIndex());
+        SceneDocument* doc = model.loadScene(model.index(row, 0, model.projectRootIndex()));
+        doc->setPlainText(text);
+        return doc;
+    }
+
+    int sceneIdAt(ProjectModel& model, int row)
+    {
+        return ProjectTextIndex::sceneId(model, model.index(row, 0, model.projectRootIndex()));
+    }
+
+    // What a full scan of the scene's text would find
+    std::vector<ProjectTextIndex::Occurrence> scan(ProjectModel& model, int row, QString const& phrase)
+    {
+        std::vector<ProjectTextIndex::Occurrence> result;
+        auto* doc = qvariant_cast<SceneDocument*>(
+                model.data(model.index(row, 0, model.projectRootIndex()), ProjectModel::DocumentRole));
+        QString const text = doc->toRawText();
+        for (int from = 0; (from = text.indexOf(phrase, from, Qt::CaseInsensitive)) != -1; from += phrase.size())
+            result.push_back({sceneIdAt(model, row), from, phrase.size()});
+        return result;
+    }
+}
+
+TEST_CASE("ProjectTextIndex lookup", "[Model][ProjectTextIndex]")
+{
+    ProjectModel model{{"Foo", "Ernie", Language::en_US}};
+    addScene(model, 0, "The dragon sleeps. Dragons dream of gold.");
+    addScene(model, 1, "A knight rides to the DRAGON's lair.\nThe knight draws a sword.");
+
+    ProjectTextIndex index;
+    index.setProject(&model);
+    index.update();
+    REQUIRE(!index.isBuilding());
+
+    int const first = sceneIdAt(model, 0);
+    int const second = sceneIdAt(model, 1);
+
+    SECTION("Words") {
+        std::vector<ProjectTextIndex::Occurrence> expected{{first, 4, 6}, {second, 22, 6}};
+        REQUIRE(index.findWord("dragon") == expected);
+        REQUIRE(index.findWord("Dragon") == expected);
+        REQUIRE(index.findWord("knight").size() == 2u);
+        REQUIRE(index.findWord("drag").empty());
+        REQUIRE(index.findWord("the dragon").empty());
+    }
+
+    SECTION("Prefixes") {
+        std::vector<ProjectTextIndex::Occurrence> expected{{first, 4, 6}, {first, 19, 7}, {second, 22, 6},
+                                                           {second, 48, 5}};
+        REQUIRE(index.findPrefix("dra") == expected);
+        REQUIRE(index.findPrefix("xyz").empty());
+    }
+
+    SECTION("Parts") {
+        for (QString const& part : {"ragon", "a", "o", "DRAGON", "s"}) {
+            auto expected = scan(model, 0, part);
+            auto more = scan(model, 1, part);
+            expected.insert(expected.end(), more.begin(), more.end());
+            std::sort(expected.begin(), expected.end(), [](auto const& a, auto const& b) {
+                return a.m_sceneId < b.m_sceneId || (a.m_sceneId == b.m_sceneId && a.m_offset < b.m_offset);
+            });
+            REQUIRE(index.findPart(part) == expected);
+        }
+    }
+
+    SECTION("Candidates") {
+        REQUIRE(index.candidateScenes("dragon", false) == std::unordered_set<int>{first, second});
+        REQUIRE(index.candidateScenes("the knight", false) == std::unordered_set<int>{second});
+        REQUIRE(index.candidateScenes("ream of", false) == std::unordered_set<int>{first});
+        REQUIRE(index.candidateScenes("unicorn", false)->empty());
+        REQUIRE(!index.candidateScenes("...", false));
+        REQUIRE(index.candidateScenes("kn[aeiou]ght", true) == std::unordered_set<int>{second});
+        REQUIRE(index.candidateScenes(R"(gold\.$)", true) == std::unordered_set<int>{first});
+        REQUIRE(!index.candidateScenes("gold|sword", true));
+    }
+}
+
+TEST_CASE("ProjectTextIndex incremental updates", "[Model][ProjectTextIndex]")
+{
+    ProjectModel model{{"Foo", "Ernie", Language::en_US}};
+    SceneDocument* doc = addScene(model, 0, "The dragon sleeps.");
+    addScene(model, 1, "A knight rides.");
+
+    ProjectTextIndex index;
+    index.setProject(&model);
+    REQUIRE(index.findWord("dragon").size() == 1u);
+
+    SECTION("Edit") {
+        QTextCursor cursor(doc);
+        cursor.setPosition(4);
+        cursor.insertText("old ");
+        REQUIRE(index.findWord("dragon") == std::vector<ProjectTextIndex::Occurrence>{{sceneIdAt(model, 0), 8, 6}});
+        REQUIRE(index.findWord("old").size() == 1u);
+        REQUIRE(index.findWord("sleeps").size() == 1u);
+
+        doc->setPlainText("Nothing left.");
+        REQUIRE(index.findWord("dragon").empty());
+        REQUIRE(index.findPrefix("s").empty());
+        REQUIRE(index.findWord("nothing").size() == 1u);
+    }
+
+    SECTION("Insert") {
+        addScene(model, 2, "Another dragon.");
+        REQUIRE(index.findWord("dragon").size() == 2u);
+        REQUIRE(index.candidateScenes("another", false) == std::unordered_set<int>{sceneIdAt(model, 2)});
+    }
+
+    SECTION("Remove") {
+        int const second = sceneIdAt(model, 1);
+        model.removeRow(0, model.projectRootIndex());
+        REQUIRE(index.findWord("dragon").empty());
+        REQUIRE(index.findWord("knight") == std::vector<ProjectTextIndex::Occurrence>{{second, 2, 6}});
+    }
+
+    SECTION("Unload") {
+        model.unloadScene(model.index(0, 0, model.projectRootIndex()));
+        REQUIRE(index.findWord("dragon").empty());
+        REQUIRE(index.findWord("knight").size() == 1u);
+    }
+
+    SECTION("Project change") {
+        index.setProject(nullptr);
+        REQUIRE(index.findWord("dragon").empty());
+        index.setProject(&model);
+        REQUIRE(index.findWord("dragon").size() == 1u);
+    }
+}
+
+TEST_CASE("ProjectTextIndex required parts", "[Model][ProjectTextIndex]")
+{
+    REQUIRE(ProjectTextIndex::requiredParts("the old-dragon!", false) == QStringList{"the", "old", "dragon"});
+    REQUIRE(ProjectTextIndex::requiredParts("?!", false).isEmpty());
+
+    REQUIRE(ProjectTextIndex::requiredParts("colou?r", true) == QStringList{"colo", "r"});
+    REQUIRE(ProjectTextIndex::requiredParts("dragons*", true) == QStringList{"dragon"});
+    REQUIRE(ProjectTextIndex::requiredParts("ab{0,2}c", true) == QStringList{"a", "c"});
+    REQUIRE(ProjectTextIndex::requiredParts("knights+", true) == QStringList{"knights"});
+    REQUIRE(ProjectTextIndex::requiredParts(R"(\bgold\w+)", true) == QStringList{"gold"});
+    REQUIRE(ProjectTextIndex::requiredParts("(the )?dragon[sz]", true) == QStringList{"dragon"});
+    REQUIRE(ProjectTextIndex::requiredParts("[]a]bc", true) == QStringList{"bc"});
+    REQUIRE(ProjectTextIndex::requiredParts(R"(\x41bc)", true).isEmpty());
+    REQUIRE(ProjectTextIndex::requiredParts("dragon|knight", true).isEmpty());
+    REQUIRE(ProjectTextIndex::requiredParts("(?x) d r a g o n", true).isEmpty());
+    REQUIRE(ProjectTextIndex::requiredParts(".*", true).isEmpty());
+}
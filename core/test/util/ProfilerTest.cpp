@@ -0,0 +1,69 @@
+/**********************************************************
+ * @file   ProfilerTest.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <catch.hpp>
+#include "util/Profiler.h"
+
+using namespace novelist::profiling;
+
+TEST_CASE("Profiler buckets", "[Profiler]")
+{
+    for (uint64_t v : {0ull, 1ull, 3ull, 4ull, 5ull, 7ull, 8ull, 1000ull, 123456789ull, 1ull << 40}) {
+        auto idx = Buckets::indexOf(v);
+        REQUIRE(Buckets::lowerBound(idx) <= v);
+        REQUIRE(v < Buckets::lowerBound(idx + 1));
+    }
+    REQUIRE(Buckets::indexOf(UINT64_MAX) < Buckets::s_count);
+}
+
+TEST_CASE("Profiler histogram", "[Profiler]")
+{
+    Histogram histogram;
+    REQUIRE(histogram.snapshot().percentile(0.5) == 0);
+
+    for (uint64_t i = 1; i <= 100; ++i)
+        histogram.record(i * 1000);
+
+    auto snapshot = histogram.snapshot();
+    REQUIRE(snapshot.m_count == 100);
+    REQUIRE(snapshot.mean() == 50500);
+    // Buckets are at most 25% wide
+    REQUIRE(snapshot.percentile(0.5) == Approx(50000).epsilon(0.25));
+    REQUIRE(snapshot.percentile(0.99) == Approx(99000).epsilon(0.25));
+    REQUIRE(snapshot.percentile(0.5) <= snapshot.percentile(0.99));
+    REQUIRE(snapshot.m_max == 100000);
+
+    HistogramSnapshot merged = snapshot;
+    merged.merge(snapshot);
+    REQUIRE(merged.m_count == 200);
+    REQUIRE(merged.mean() == snapshot.mean());
+    REQUIRE(merged.m_max == 100000);
+}
+
+TEST_CASE("Profiler probes", "[Profiler]")
+{
+    static Probe const probe("ProfilerTest::probe");
+
+    probe.record(42);
+    std::thread worker([] {
+        probe.record(42);
+        probe.record(42);
+    });
+    worker.join();
+
+    auto results = collect();
+    auto iter = std::find_if(results.begin(), results.end(),
+            [](ProbeResult const& r) { return std::string(r.m_name) == "ProfilerTest::probe"; });
+    REQUIRE(iter != results.end());
+    REQUIRE(iter->m_histogram.m_count == 3);
+    REQUIRE(!report().isEmpty());
+}
@@ -0,0 +1,117 @@
+/**********************************************************
+ * @file   InspectionCacheTest.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+
+#include <catch.hpp>
+#include <QtCore/QBuffer>
+#include "widgets/texteditor/InspectionCache.h"
+#include "document/SpellingInsight.h"
+
+using namespace novelist;
+
+namespace {
+    InspectionBlockResult makeResult(int left, int right)
+    {
+        InspectionBlockResult result;
+        result.push_back({std::make_shared<AutoInsightFactory<SpellingInsight>>("Spelling", QStringList{"a", "b"}),
+                          left, right});
+        return result;
+    }
+}
+
+TEST_CASE("InspectionCache keys", "[InspectionCache]")
+{
+    auto key = InspectionCache::makeKey("Some text", Language::en_US, "inspector");
+    REQUIRE(key == InspectionCache::makeKey("Some text", Language::en_US, "inspector"));
+    REQUIRE(key != InspectionCache::makeKey("Some text.", Language::en_US, "inspector"));
+    REQUIRE(key != InspectionCache::makeKey("Some text", Language::de_DE, "inspector"));
+    REQUIRE(key != InspectionCache::makeKey("Some text", Language::en_US, "inspector2"));
+}
+
+TEST_CASE("InspectionCache lookup and eviction", "[InspectionCache]")
+{
+    InspectionCache cache(1024);
+    auto keyA = InspectionCache::makeKey("A", Language::en_US, "i");
+    auto keyB = InspectionCache::makeKey("B", Language::en_US, "i");
+
+    REQUIRE(!cache.find(keyA));
+    cache.insert(keyA, makeResult(0, 1));
+    auto found = cache.find(keyA);
+    REQUIRE(found);
+    REQUIRE(found->size() == 1);
+    REQUIRE((*found)[0].m_right == 1);
+
+    // Fill up the cache until the first entry is evicted; looking it up keeps it alive
+    for (int i = 0; i < 100; ++i) {
+        cache.insert(InspectionCache::makeKey(QString::number(i), Language::en_US, "i"), makeResult(i, i + 1));
+        cache.find(keyA);
+    }
+    cache.insert(keyB, {});
+    REQUIRE(cache.find(keyA));
+    REQUIRE(cache.find(keyB));
+    REQUIRE(cache.memoryUsage() <= 1024);
+    REQUIRE(cache.size() < 102);
+
+    cache.clear();
+    REQUIRE(cache.size() == 0);
+    REQUIRE(cache.memoryUsage() == 0);
+}
+
+TEST_CASE("InspectionCache persistence", "[InspectionCache]")
+{
+    InspectionCache cache;
+    auto keyA = InspectionCache::makeKey("A", Language::en_US, "i");
+    auto keyB = InspectionCache::makeKey("B", Language::en_US, "i");
+    cache.insert(keyA, makeResult(2, 5));
+    cache.insert(keyB, {});
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    REQUIRE(cache.save(buffer));
+    buffer.close();
+
+    InspectionCache loaded;
+    buffer.open(QIODevice::ReadOnly);
+    REQUIRE(loaded.load(buffer));
+    REQUIRE(loaded.size() == 2);
+    auto found = loaded.find(keyA);
+    REQUIRE(found);
+    REQUIRE(found->size() == 1);
+    REQUIRE((*found)[0].m_left == 2);
+    REQUIRE((*found)[0].m_right == 5);
+    auto description = (*found)[0].m_factory->describe();
+    REQUIRE(description.m_type == SpellingInsight::staticMetaObject.className());
+    REQUIRE(description.m_message == "Spelling");
+    REQUIRE(description.m_suggestions == QStringList{"a", "b"});
+    REQUIRE(loaded.find(keyB));
+
+    QBuffer garbage;
+    garbage.setData("not a cache");
+    garbage.open(QIODevice::ReadOnly);
+    REQUIRE(!loaded.load(garbage));
+}
+
+TEST_CASE("InspectionCache lazy messages", "[InspectionCache]")
+{
+    int built = 0;
+    InspectionBlockResult result;
+    result.push_back({std::make_shared<AutoInsightFactory<SpellingInsight>>([&built] {
+        ++built;
+        return QString("Spelling");
+    }, QStringList{"a"}), 0, 1});
+
+    InspectionCache cache;
+    cache.insert(InspectionCache::makeKey("A", Language::en_US, "i"), std::move(result));
+    REQUIRE(cache.memoryUsage() > 0);
+    REQUIRE(built == 0);
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    REQUIRE(cache.save(buffer));
+    REQUIRE(built == 1);
+}
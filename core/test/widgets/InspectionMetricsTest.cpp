@@ -0,0 +1,94 @@
+/**********************************************************
+ * @file   InspectionMetricsTest.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+
+#include <algorithm>
+#include <catch.hpp>
+#include <QtCore/QCoreApplication>
+#include "widgets/texteditor/InspectionMetrics.h"
+#include "widgets/texteditor/InspectionCache.h"
+#include "widgets/texteditor/Inspector.h"
+
+using namespace novelist;
+
+namespace {
+    class CountingInspector : public Inspector {
+    public:
+        InspectionBlockResult inspect(QString const& /*text*/, Language /*lang*/) const noexcept override
+        {
+            return {};
+        }
+
+        QByteArray cacheKey() const noexcept override
+        {
+            return "counting/1";
+        }
+
+        QString name() const noexcept override
+        {
+            return "InspectionMetricsTest::CountingInspector";
+        }
+    };
+}
+
+TEST_CASE("InspectionMetrics counters", "[InspectionMetrics]")
+{
+    auto& metrics = InspectionMetrics::instance().inspector("InspectionMetricsTest::counters");
+    REQUIRE(&metrics == &InspectionMetrics::instance().inspector("InspectionMetricsTest::counters"));
+
+    metrics.recordCall(3, 1000, 2000);
+    metrics.recordCall(1, 1000, 4000);
+    metrics.recordCacheHits(5);
+    metrics.recordBytesSent(42);
+    metrics.recordError();
+
+    auto snapshot = metrics.snapshot();
+    REQUIRE(snapshot.m_name == "InspectionMetricsTest::counters");
+    REQUIRE(snapshot.m_calls == 2);
+    REQUIRE(snapshot.m_blocks == 4);
+    REQUIRE(snapshot.m_cacheHits == 5);
+    REQUIRE(snapshot.m_bytesSent == 42);
+    REQUIRE(snapshot.m_errors == 1);
+    REQUIRE(snapshot.m_latency.m_count == 2);
+    REQUIRE(snapshot.m_latency.mean() == 3000);
+
+    auto all = InspectionMetrics::instance().inspectors();
+    REQUIRE(std::any_of(all.begin(), all.end(),
+            [](auto const& s) { return s.m_name == "InspectionMetricsTest::counters"; }));
+    REQUIRE(InspectionMetrics::instance().report().contains("InspectionMetricsTest::counters"));
+}
+
+TEST_CASE("InspectionMetrics pipeline", "[InspectionMetrics]")
+{
+    std::vector<std::unique_ptr<Inspector>> inspectors;
+    inspectors.push_back(std::make_unique<CountingInspector>());
+    QReadWriteLock lock;
+    QObject receiver;
+    auto cache = std::make_shared<InspectionCache>();
+
+    auto makeRequest = [&] {
+        internal::InspectionRequest request{{"First", "Second", "Third"}, {}, Language::en_US, cache, &receiver, 1, 0};
+        for (size_t i = 0; i < request.m_blocks.size(); ++i)
+            request.m_cancelled.push_back(std::make_shared<std::atomic_bool>(false));
+        return request;
+    };
+
+    auto& metrics = InspectionMetrics::instance().inspector("InspectionMetricsTest::CountingInspector");
+    auto const before = metrics.snapshot();
+
+    // First run inspects every block, second run finds all of them in the cache
+    internal::runInspection(makeRequest(), &inspectors, &lock);
+    internal::runInspection(makeRequest(), &inspectors, &lock);
+    QCoreApplication::removePostedEvents(&receiver);
+
+    auto const after = metrics.snapshot();
+    REQUIRE(after.m_blocks - before.m_blocks == 3);
+    REQUIRE(after.m_calls - before.m_calls == 3);
+    REQUIRE(after.m_cacheHits - before.m_cacheHits == 3);
+    REQUIRE(after.m_errors == before.m_errors);
+}
@@ -0,0 +1,187 @@
+/**********************************************************
+ * @file   ProjectInspectionServiceTest.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <catch.hpp>
+#include <QtCore/QBuffer>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+#include <QtGui/QKeyEvent>
+#include <QtGui/QTextCursor>
+#include "document/InsightFactory.h"
+#include "document/SceneDocument.h"
+#include "document/SpellingInsight.h"
+#include "widgets/texteditor/Inspector.h"
+#include "widgets/texteditor/ProjectInspectionService.h"
+
+using namespace novelist;
+
+namespace {
+    using NodeType = ProjectModel::InsertableNodeType;
+
+    /**
+     * Reports every occurrence of "typo" and remembers which texts it inspected
+     */
+    class TypoInspector : public Inspector {
+    public:
+        InspectionBlockResult inspect(QString const& text, Language /*lang*/) const noexcept override
+        {
+            {
+                QMutexLocker lock(&m_mutex);
+                m_inspected.push_back(text);
+            }
+            if (text == s_blocking) {
+                m_blocked = true;
+                while (!m_released)
+                    QThread::msleep(1);
+            }
+
+            InspectionBlockResult result;
+            for (int from = 0; (from = text.indexOf("typo", from)) != -1; from += 4)
+                result.push_back({std::make_shared<AutoInsightFactory<SpellingInsight>>(QString("Typo"), QStringList{}),
+                                  from, from + 4});
+            return result;
+        }
+
+        std::vector<QString> inspected() const
+        {
+            QMutexLocker lock(&m_mutex);
+            return m_inspected;
+        }
+
+        static inline QString const s_blocking = "Wait for me";
+        mutable std::atomic_bool m_blocked{false};
+        mutable std::atomic_bool m_released{false};
+
+    private:
+        mutable QMutex m_mutex;
+        mutable std::vector<QString> m_inspected;
+    };
+
+    QModelIndex addNode(ProjectModel& model, NodeType type, int row, QModelIndex const& parent)
+    {
+        model.insertRow(row, type, type == NodeType::Scene ? "Scene" : "Chapter", parent);
+        return model.index(row, 0, parent);
+    }
+
+    QModelIndex addScene(ProjectModel& model, int row, QModelIndex const& parent, QString const& text)
+    {
+        QModelIndex index = addNode(model, NodeType::Scene, row, parent);
+        model.loadScene(index)->setPlainText(text);
+        return index;
+    }
+
+    template<typename Predicate>
+    bool waitFor(Predicate done)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        while (!done() && timer.elapsed() < 5000)
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        return done();
+    }
+}
+
+TEST_CASE("ProjectInspectionService", "[ProjectInspectionService]")
+{
+    ProjectModel model{{"Foo", "Ernie", Language::en_US}};
+    QPersistentModelIndex const root = model.projectRootIndex();
+    QPersistentModelIndex const chapter = addNode(model, NodeType::Chapter, 0, root);
+    QPersistentModelIndex const first = addScene(model, 0, chapter, "One typo.\nAnother typo and a typo.");
+    QPersistentModelIndex const second = addScene(model, 1, chapter, "No mistakes.");
+    QPersistentModelIndex const third = addScene(model, 1, root, "Just a typo.");
+
+    std::vector<std::unique_ptr<Inspector>> inspectors;
+    inspectors.push_back(std::make_unique<TypoInspector>());
+    auto const& inspector = static_cast<TypoInspector const&>(*inspectors.front());
+
+    ProjectInspectionService service;
+    service.useInspectors(&inspectors);
+    service.setIdleDelay(0);
+    service.setProject(&model);
+    REQUIRE(!service.insightCount(chapter));
+    REQUIRE(waitFor([&] { return service.insightCount(root) == 4 && !service.isRunning(); }));
+    REQUIRE(inspector.inspected().size() == 4u);
+
+    SECTION("Insight count") {
+        REQUIRE(service.insightCount(first) == 3);
+        REQUIRE(service.insightCount(second) == 0);
+        REQUIRE(service.insightCount(third) == 1);
+        REQUIRE(service.insightCount(chapter) == 3);
+        REQUIRE(service.insightCount(root) == 4);
+    }
+
+    SECTION("Unchanged scenes are skipped") {
+        QTextCursor cursor(qvariant_cast<SceneDocument*>(model.data(second, ProjectModel::DocumentRole)));
+        cursor.insertText("A typo. ");
+        addScene(model, 2, root, "Yet another typo.");
+        REQUIRE(waitFor([&] { return service.insightCount(root) == 6 && !service.isRunning(); }));
+
+        auto const inspected = inspector.inspected();
+        REQUIRE(inspected.size() == 6u);
+        REQUIRE(std::count(inspected.begin() + 4, inspected.end(), "A typo. No mistakes.") == 1);
+        REQUIRE(std::count(inspected.begin() + 4, inspected.end(), "Yet another typo.") == 1);
+        REQUIRE(service.insightCount(chapter) == 4);
+    }
+
+    SECTION("Cancelled scenes are queued again") {
+        QPersistentModelIndex const blocking = addScene(model, 2, root, TypoInspector::s_blocking);
+        service.prioritize(blocking);
+        REQUIRE(waitFor([&] { return inspector.m_blocked.load(); }));
+
+        // The author comes back while the scene is inspected
+        QKeyEvent press(QEvent::KeyPress, Qt::Key_A, Qt::NoModifier);
+        QCoreApplication::sendEvent(&model, &press);
+        inspector.m_released = true;
+        REQUIRE(waitFor([&] { return service.insightCount(blocking) && !service.isRunning(); }));
+
+        // The interrupted scene is picked up before all others
+        auto const inspected = inspector.inspected();
+        REQUIRE(inspected.size() == 6u);
+        REQUIRE(inspected[4] == TypoInspector::s_blocking);
+        REQUIRE(inspected[5] == TypoInspector::s_blocking);
+        REQUIRE(service.insightCount(blocking) == 0);
+    }
+
+    SECTION("Save and load") {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        REQUIRE(service.save(buffer));
+        QByteArray const data = buffer.data();
+
+        ProjectInspectionService loaded;
+        loaded.setProject(&model);
+        REQUIRE(!loaded.insightCount(root));
+
+        QBuffer truncated;
+        truncated.setData(data.left(data.size() - 3));
+        truncated.open(QIODevice::ReadOnly);
+        REQUIRE(!loaded.load(truncated));
+        REQUIRE(!loaded.insightCount(root));
+
+        QByteArray badMagic = data;
+        badMagic[0] = 'X';
+        QBuffer wrongMagic(&badMagic);
+        wrongMagic.open(QIODevice::ReadOnly);
+        REQUIRE(!loaded.load(wrongMagic));
+        REQUIRE(!loaded.insightCount(root));
+
+        QBuffer valid;
+        valid.setData(data);
+        valid.open(QIODevice::ReadOnly);
+        REQUIRE(loaded.load(valid));
+        REQUIRE(loaded.insightCount(first) == 3);
+        REQUIRE(loaded.insightCount(second) == 0);
+        REQUIRE(loaded.insightCount(third) == 1);
+        REQUIRE(loaded.insightCount(root) == 4);
+    }
+}
@@ -0,0 +1,259 @@
+/**********************************************************
+ * @file   TextEditorInsightManagerTest.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <catch.hpp>
+#include <gsl/gsl>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+#include <QtGui/QTextCursor>
+#include <QtWidgets/QScrollBar>
+#include "document/InsightFactory.h"
+#include "document/SceneDocument.h"
+#include "document/SpellingInsight.h"
+#include "widgets/texteditor/Inspector.h"
+#include "widgets/texteditor/TextEditor.h"
+#include "widgets/texteditor/TextEditorInsightManager.h"
+
+using namespace novelist;
+
+namespace {
+    /**
+     * Reports every occurrence of "typo" and remembers the order in which it inspected texts. Only inspects one text
+     * at a time, and texts starting with the gate wait until they are released.
+     */
+    class RecordingInspector : public Inspector {
+    public:
+        InspectionBlockResult inspect(QString const& text, Language /*lang*/) const noexcept override
+        {
+            {
+                QMutexLocker lock(&m_mutex);
+                m_inspected.push_back(text);
+            }
+            if (text.startsWith(s_gate)) {
+                m_blocked = true;
+                while (!m_released)
+                    QThread::msleep(1);
+            }
+
+            InspectionBlockResult result;
+            for (int from = 0; (from = text.indexOf("typo", from)) != -1; from += 4)
+                result.push_back({std::make_shared<AutoInsightFactory<SpellingInsight>>(QString("Typo"), QStringList{}),
+                                  from, from + 4});
+            ++m_finished;
+            return result;
+        }
+
+        int maxConcurrency() const noexcept override
+        {
+            return 1;
+        }
+
+        std::vector<QString> inspected() const
+        {
+            QMutexLocker lock(&m_mutex);
+            return m_inspected;
+        }
+
+        static inline QString const s_gate = "Gate";
+        mutable std::atomic_bool m_blocked{false};
+        mutable std::atomic_bool m_released{false};
+        mutable std::atomic_int m_finished{0};
+
+    private:
+        mutable QMutex m_mutex;
+        mutable std::vector<QString> m_inspected;
+    };
+
+    /**
+     * Makes the visible area accessible
+     */
+    class VisibleAreaEditor : public TextEditor {
+    public:
+        using TextEditor::TextEditor;
+        using TextEditor::firstVisibleBlock;
+        using TextEditor::lastVisibleBlock;
+    };
+
+    template<typename Predicate>
+    bool waitFor(Predicate done)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        while (!done() && timer.elapsed() < 5000)
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        return done();
+    }
+
+    void wait(int msec)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        while (timer.elapsed() < msec)
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 5);
+    }
+
+    void applyPostedResults()
+    {
+        QCoreApplication::sendPostedEvents(nullptr, internal::InspectionResultEvent::s_eventId);
+    }
+
+    int insightCount(TextEditor& editor)
+    {
+        return editor.insights()->rowCount();
+    }
+}
+
+TEST_CASE("TextEditorInsightManager refresh order", "[TextEditor][Inspection]")
+{
+    std::vector<std::unique_ptr<Inspector>> inspectors;
+    inspectors.push_back(std::make_unique<RecordingInspector>());
+    auto const& inspector = static_cast<RecordingInspector const&>(*inspectors.front());
+
+    int const blockCount = 200;
+    QStringList lines;
+    for (int i = 0; i < blockCount; ++i)
+        lines << QString::number(i);
+    SceneDocument doc(Language::en_US);
+    doc.setPlainText(lines.join('\n'));
+
+    VisibleAreaEditor editor(Language::en_US);
+    editor.useInspectors(&inspectors);
+    editor.resize(400, 200);
+    editor.show();
+    editor.setDocument(&doc);
+
+    // The cursor is far below the visible area
+    int const cursorBlock = 100;
+    editor.setTextCursor(QTextCursor(doc.findBlockByNumber(cursorBlock)));
+    editor.verticalScrollBar()->setValue(0);
+    REQUIRE(waitFor([&] { return inspector.inspected().size() == static_cast<size_t>(blockCount); }));
+
+    int const firstVisible = editor.firstVisibleBlock().blockNumber();
+    int const lastVisible = editor.lastVisibleBlock().blockNumber();
+    REQUIRE(lastVisible > firstVisible);
+    REQUIRE(lastVisible < cursorBlock);
+    auto isVisible = [&](int n) { return n >= firstVisible && n <= lastVisible; };
+
+    std::vector<int> order;
+    for (auto const& text : inspector.inspected())
+        order.push_back(text.toInt());
+
+    // The cursor block comes first, then the visible blocks, then all others, each by distance to the cursor
+    REQUIRE(order.front() == cursorBlock);
+    auto const visibleEnd = order.begin() + 1 + (lastVisible - firstVisible + 1);
+    REQUIRE(std::all_of(order.begin() + 1, visibleEnd, isVisible));
+    REQUIRE(std::none_of(visibleEnd, order.end(), isVisible));
+    auto byDistance = [cursorBlock](int lhs, int rhs) {
+        return std::abs(lhs - cursorBlock) < std::abs(rhs - cursorBlock);
+    };
+    REQUIRE(std::is_sorted(order.begin() + 1, visibleEnd, byDistance));
+    REQUIRE(std::is_sorted(visibleEnd, order.end(), byDistance));
+}
+
+TEST_CASE("TextEditorInsightManager block results", "[TextEditor][Inspection]")
+{
+    std::vector<std::unique_ptr<Inspector>> inspectors;
+    inspectors.push_back(std::make_unique<RecordingInspector>());
+    auto& inspector = static_cast<RecordingInspector&>(*inspectors.front());
+
+    SceneDocument doc(Language::en_US);
+    TextEditor editor(Language::en_US);
+    editor.useInspectors(&inspectors);
+    editor.setInspectionDelay(60000); // Only the initial refresh runs
+    // The editor waits for the refresh when it is destroyed
+    auto releaseInspector = gsl::finally([&inspector] { inspector.m_released = true; });
+
+    SECTION("Results are applied per block") {
+        doc.setPlainText("A typo.\nGate, another typo.");
+        editor.setDocument(&doc);
+        REQUIRE(waitFor([&] { return inspector.m_blocked.load(); }));
+
+        // The refresh is still waiting for the second block
+        applyPostedResults();
+        REQUIRE(insightCount(editor) == 1);
+
+        inspector.m_released = true;
+        REQUIRE(waitFor([&] { return insightCount(editor) == 2; }));
+    }
+
+    SECTION("Results of blocks that changed again are dropped") {
+        doc.setPlainText("Gate, a typo.\nAnother typo.");
+        editor.setDocument(&doc);
+        REQUIRE(waitFor([&] { return inspector.m_blocked.load(); }));
+
+        // Both results are posted, but not applied before the first block changes
+        inspector.m_released = true;
+        QElapsedTimer timer;
+        timer.start();
+        while (inspector.m_finished < 2 && timer.elapsed() < 5000)
+            QThread::msleep(1);
+        QThread::msleep(50);
+        QTextCursor cursor(doc.findBlockByNumber(0));
+        cursor.movePosition(QTextCursor::EndOfBlock);
+        cursor.insertText(" Changed.");
+        applyPostedResults();
+
+        REQUIRE(insightCount(editor) == 1);
+        auto const index = editor.insights()->index(0, 0);
+        auto* insight = qvariant_cast<Insight*>(
+                editor.insights()->data(index, static_cast<int>(InsightModelRoles::InsightDataRole)));
+        REQUIRE(insight->range().first >= doc.findBlockByNumber(1).position());
+    }
+}
+
+TEST_CASE("TextEditorInsightManager quiet period", "[TextEditor][Inspection]")
+{
+    std::vector<std::unique_ptr<Inspector>> inspectors;
+    inspectors.push_back(std::make_unique<RecordingInspector>());
+    auto const& inspector = static_cast<RecordingInspector const&>(*inspectors.front());
+
+    int const quietPeriod = 200;
+    SceneDocument doc(Language::en_US);
+    doc.setPlainText("A line.\nAnother line.");
+    TextEditor editor(Language::en_US);
+    editor.useInspectors(&inspectors);
+    editor.setInspectionDelay(quietPeriod);
+    editor.setDocument(&doc);
+    REQUIRE(waitFor([&] { return inspector.inspected().size() == 2u; }));
+
+    QTextCursor cursor(doc.findBlockByNumber(1));
+    cursor.movePosition(QTextCursor::EndOfBlock);
+    QElapsedTimer sinceChange;
+
+    SECTION("Single change") {
+        cursor.insertText("x");
+        sinceChange.start();
+        REQUIRE(waitFor([&] { return inspector.inspected().size() == 3u; }));
+        REQUIRE(inspector.inspected().back() == "Another line.x");
+        // Timers may fire a few percent early
+        REQUIRE(sinceChange.elapsed() >= quietPeriod * 9 / 10);
+    }
+
+    SECTION("Bursts of changes back off") {
+        for (int i = 0; i < 10; ++i) {
+            cursor.insertText("x");
+            sinceChange.start();
+            wait(20);
+        }
+        REQUIRE(inspector.inspected().size() == 2u);
+
+        // The changed block is inspected once, after the grown quiet period
+        REQUIRE(waitFor([&] { return inspector.inspected().size() == 3u; }));
+        REQUIRE(inspector.inspected().back() == "Another line.xxxxxxxxxx");
+        REQUIRE(sinceChange.elapsed()
+                >= quietPeriod * TextEditorInsightManager::s_maxBackoffFactor * 9 / 10);
+        wait(quietPeriod * TextEditorInsightManager::s_maxBackoffFactor);
+        REQUIRE(inspector.inspected().size() == 3u);
+    }
+}
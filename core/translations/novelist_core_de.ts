@@ -267,6 +267,12 @@
         <comment>SettingsPage_Editor</comment>
         <translation></translation>
     </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Diagnostics.cpp" line="58"/>
+        <source>Diagnostics</source>
+        <comment>SettingsPage_Diagnostics</comment>
+        <translation>Diagnose</translation>
+    </message>
     <message>
         <location filename="../src/novelist/settings/SettingsPage_General.cpp" line="48"/>
         <source>General</source>
@@ -282,6 +288,34 @@
         <translation>Einstellungen</translation>
     </message>
 </context>
+<context>
+    <name>SettingsPage_Diagnostics</name>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Diagnostics.ui" line="14"/>
+        <source>Settings - Diagnostics</source>
+        <translation>Einstellungen - Diagnose</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Diagnostics.ui" line="20"/>
+        <source>Inspection metrics</source>
+        <translation>Inspektionsmetriken</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Diagnostics.ui" line="38"/>
+        <source>Write metrics to the log every</source>
+        <translation>Metriken ins Protokoll schreiben alle</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Diagnostics.ui" line="45"/>
+        <source> s</source>
+        <translation> s</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Diagnostics.ui" line="77"/>
+        <source>Refresh</source>
+        <translation>Aktualisieren</translation>
+    </message>
+</context>
 <context>
     <name>SettingsPage_Editor</name>
     <message>
@@ -304,6 +338,31 @@
         <source>Show paragraph numbers</source>
         <translation>Absatznummerierung</translation>
     </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Editor.ui" line="65"/>
+        <source>In scenes with more paragraphs than this, insights are only highlighted in the visible area. This keeps the editor responsive on very long scenes.</source>
+        <translation>In Szenen mit mehr Absätzen werden Hinweise nur im sichtbaren Bereich hervorgehoben. Dadurch bleibt der Editor auch bei sehr langen Szenen flüssig.</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Editor.ui" line="68"/>
+        <source>Highlight only the visible area in scenes with more paragraphs than</source>
+        <translation>Nur den sichtbaren Bereich hervorheben in Szenen mit mehr Absätzen als</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Editor.ui" line="100"/>
+        <source>Changed paragraphs are checked once you pause typing for this long, or right away when you move on to another paragraph.</source>
+        <translation>Geänderte Absätze werden geprüft, sobald du so lange nicht tippst, oder sofort, wenn du zu einem anderen Absatz wechselst.</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Editor.ui" line="103"/>
+        <source>Check paragraphs after a typing pause of</source>
+        <translation>Absätze prüfen nach einer Tipppause von</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Editor.ui" line="110"/>
+        <source> ms</source>
+        <translation> ms</translation>
+    </message>
     <message>
         <location filename="../src/novelist/settings/SettingsPage_Editor.ui" line="66"/>
         <source>Automatically replaces characters on input with other characters, e.g. the quote substitute character &quot; can be replaced with “”.</source>
@@ -458,7 +517,12 @@
 <context>
     <name>novelist::AutoInsight</name>
     <message>
-        <location filename="../src/novelist/document/AutoInsight.cpp" line="39"/>
+        <location filename="../src/novelist/document/AutoInsight.cpp" line="22"/>
+        <source>Remove</source>
+        <translation>Entfernen</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/document/AutoInsight.cpp" line="45"/>
         <source>Suggestions</source>
         <translation>Vorschläge</translation>
     </message>
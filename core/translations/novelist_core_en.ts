@@ -267,6 +267,12 @@
         <comment>SettingsPage_Editor</comment>
         <translation></translation>
     </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Diagnostics.cpp" line="58"/>
+        <source>Diagnostics</source>
+        <comment>SettingsPage_Diagnostics</comment>
+        <translation></translation>
+    </message>
     <message>
         <location filename="../src/novelist/settings/SettingsPage_General.cpp" line="48"/>
         <source>General</source>
@@ -282,6 +288,34 @@
         <translation></translation>
     </message>
 </context>
+<context>
+    <name>SettingsPage_Diagnostics</name>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Diagnostics.ui" line="14"/>
+        <source>Settings - Diagnostics</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Diagnostics.ui" line="20"/>
+        <source>Inspection metrics</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Diagnostics.ui" line="38"/>
+        <source>Write metrics to the log every</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Diagnostics.ui" line="45"/>
+        <source> s</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Diagnostics.ui" line="77"/>
+        <source>Refresh</source>
+        <translation></translation>
+    </message>
+</context>
 <context>
     <name>SettingsPage_Editor</name>
     <message>
@@ -304,6 +338,31 @@
         <source>Show paragraph numbers</source>
         <translation></translation>
     </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Editor.ui" line="65"/>
+        <source>In scenes with more paragraphs than this, insights are only highlighted in the visible area. This keeps the editor responsive on very long scenes.</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Editor.ui" line="68"/>
+        <source>Highlight only the visible area in scenes with more paragraphs than</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Editor.ui" line="100"/>
+        <source>Changed paragraphs are checked once you pause typing for this long, or right away when you move on to another paragraph.</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Editor.ui" line="103"/>
+        <source>Check paragraphs after a typing pause of</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/settings/SettingsPage_Editor.ui" line="110"/>
+        <source> ms</source>
+        <translation></translation>
+    </message>
     <message>
         <location filename="../src/novelist/settings/SettingsPage_Editor.ui" line="66"/>
         <source>Automatically replaces characters on input with other characters, e.g. the quote substitute character &quot; can be replaced with “”.</source>
@@ -426,7 +485,12 @@
 <context>
     <name>novelist::AutoInsight</name>
     <message>
-        <location filename="../src/novelist/document/AutoInsight.cpp" line="39"/>
+        <location filename="../src/novelist/document/AutoInsight.cpp" line="22"/>
+        <source>Remove</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/document/AutoInsight.cpp" line="45"/>
         <source>Suggestions</source>
         <translation></translation>
     </message>
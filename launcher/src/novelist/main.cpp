@@ -15,6 +15,7 @@
 #include <settings/Settings.h>
 #include <plugin/Plugin.h>
 #include <plugin/PluginManager.h>
+#include <util/Profiler.h>
 #include <iostream>
 #include <string>
 #include <ctime>
@@ -123,5 +124,9 @@ int main(int argc, char* argv[])
 
     mngr.unload();
 
+#ifdef NOVELIST_PROFILING_ENABLED
+    profiling::dumpToLog();
+#endif
+
     return retCode;
 }
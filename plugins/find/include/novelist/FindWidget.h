@@ -13,7 +13,11 @@
 #include <QStandardItemModel>
 #include <QProgressDialog>
 #include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
 #include <model/ProjectModel.h>
+#include <model/ProjectTextIndex.h>
 #include <QtWidgets/QStyledItemDelegate>
 
 namespace Ui {
@@ -128,6 +132,11 @@ namespace novelist {
         std::unique_ptr<Ui::FindWidget> m_ui;
         std::unique_ptr<QStandardItemModel> m_findModel;
         MainWindow* m_mainWin = nullptr;
+        ProjectTextIndex m_index;
+        // Content matches of the running search as found by the index, by scene id. Scenes without entry don't match.
+        std::optional<std::unordered_map<int, std::vector<std::pair<int, int>>>> m_indexedMatches;
+        // Scenes that might contain matches of the running search. All scenes might if not set.
+        std::optional<std::unordered_set<int>> m_candidateScenes;
     };
 
     namespace internal {
@@ -35,8 +35,13 @@ namespace novelist {
             }
         }
 
-        if (m_mainWin != nullptr)
-            connect(m_mainWin, &MainWindow::projectChanged, [this](ProjectModel*) { reset(); });
+        if (m_mainWin != nullptr) {
+            connect(m_mainWin, &MainWindow::projectChanged, [this](ProjectModel* m) {
+                reset();
+                m_index.setProject(m);
+            });
+            m_index.setProject(m_mainWin->project());
+        }
     }
 
     void FindWidget::retranslateUi() noexcept
@@ -215,9 +220,15 @@ namespace novelist {
                     }
                     QStandardItem* contentItem = makeNode(NodeType::ContentResultTopic, root).release();
                     item->appendRow(contentItem);
-                    QString text = arg.m_doc->toRawText();
-                    auto contentResults = find(text, searchPhrase, matchCase, regex);
-                    addResults(root, contentItem, contentResults, text);
+                    // Scenes the index rules out don't have to be looked at
+                    int const id = ProjectTextIndex::sceneId(*model, root);
+                    if (arg.m_doc != nullptr && (!m_candidateScenes || m_candidateScenes->count(id) > 0)
+                            && (!m_indexedMatches || m_indexedMatches->count(id) > 0)) {
+                        QString text = arg.m_doc->toRawText();
+                        auto contentResults = m_indexedMatches ? m_indexedMatches->at(id)
+                                                               : find(text, searchPhrase, matchCase, regex);
+                        addResults(root, contentItem, contentResults, text);
+                    }
                     dialog.setValue(dialog.value() + 1);
                 },
         }, *model->nodeData(root));
@@ -567,12 +578,28 @@ namespace novelist {
         progress.setWindowModality(Qt::WindowModal);
         progress.setMinimumDuration(1000); // Don't show dialog if finished in less than 1 second
 
+        // Single words are looked up in the index right away. Anything else is still matched against the scenes'
+        // text, but only against scenes that the index can't rule out.
+        bool const regex = m_ui->checkBoxRegEx->isChecked();
+        if (m_index.project() == model) {
+            if (!regex && !m_ui->checkBoxMatchCase->isChecked() && ProjectTextIndex::isWord(searchTerm)) {
+                m_indexedMatches.emplace();
+                for (auto const& occurrence : m_index.findPart(searchTerm))
+                    (*m_indexedMatches)[occurrence.m_sceneId].emplace_back(occurrence.m_offset,
+                            occurrence.m_offset + occurrence.m_length);
+            }
+            else
+                m_candidateScenes = m_index.candidateScenes(searchTerm, regex);
+        }
+
         if (!idx.isValid()) { // Invisible root, consider all its children
             for (int i = 0; i < model->rowCount(QModelIndex()); ++i)
                 search(model, model->index(i, 0, QModelIndex()), *m_findModel, m_findModel->invisibleRootItem(), progress);
         }
         else
             search(model, idx, *m_findModel, m_findModel->invisibleRootItem(), progress);
+        m_indexedMatches.reset();
+        m_candidateScenes.reset();
         removeEmptyResults(m_findModel->invisibleRootItem());
         updateCountsAndTitles(m_findModel->invisibleRootItem());
 
@@ -0,0 +1,159 @@
+/**********************************************************
+ * @file   LanguageToolClient.h
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#ifndef NOVELIST_LANGUAGETOOLCLIENT_H
+#define NOVELIST_LANGUAGETOOLCLIENT_H
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <optional>
+#include <QtCore/QFuture>
+#include <QtCore/QFutureInterface>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QThread>
+#include <QtCore/QUrl>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+
+namespace novelist {
+    /**
+     * Receives the response body of a request, or nothing if the request failed or was cancelled
+     */
+    using LanguageToolResponseCallback = std::function<void(std::optional<QByteArray>)>;
+
+    /**
+     * Receives the next chunk of a successful response body as soon as it arrives
+     */
+    using LanguageToolDataCallback = std::function<void(QByteArray const&)>;
+
+    /**
+     * Checked right before a request is sent. Returns true if the response is no longer needed.
+     */
+    using LanguageToolCancelCheck = std::function<bool()>;
+
+    namespace internal {
+        /**
+         * Lives on the network thread and owns all network objects
+         */
+        class LanguageToolNetworkWorker : public QObject {
+        Q_OBJECT
+
+        public:
+            explicit LanguageToolNetworkWorker(int maxRunningRequests) noexcept;
+
+            ~LanguageToolNetworkWorker() noexcept override;
+
+            /**
+             * Queue a request. Thread-safe.
+             * @param url Destination
+             * @param body Form-encoded request body
+             * @param done Receives the response
+             * @param cancelled Allows to skip the request while it is queued, may be empty
+             * @param received If not empty, receives the response body in chunks instead of \p done
+             */
+            void enqueue(QUrl url, QByteArray body, LanguageToolResponseCallback done,
+                    LanguageToolCancelCheck cancelled, LanguageToolDataCallback received = {});
+
+        public slots:
+
+            void processQueue();
+
+        private:
+            struct PendingRequest {
+                QUrl m_url;
+                QByteArray m_body;
+                LanguageToolResponseCallback m_done;
+                LanguageToolCancelCheck m_cancelled;
+                LanguageToolDataCallback m_received;
+            };
+
+            struct RunningRequest {
+                LanguageToolResponseCallback m_done;
+                LanguageToolDataCallback m_received;
+            };
+
+            QMutex m_queueMutex;
+            std::deque<PendingRequest> m_queue;
+            int const m_maxRunningRequests;
+            QNetworkAccessManager* m_network = nullptr;
+            std::map<QNetworkReply*, RunningRequest> m_running;
+
+            void onReadyRead(QNetworkReply* reply);
+
+            void onFinished(QNetworkReply* reply);
+        };
+    }
+
+    /**
+     * Sends requests to a LanguageTool server. All requests go through a single network access manager on a
+     * dedicated thread, so connections to the server are kept alive and reused, and no thread of the caller is
+     * blocked by network I/O unless it chooses to wait for the result.
+     */
+    class LanguageToolClient {
+    public:
+        /**
+         * Default maximum amount of requests that are sent to the server at the same time
+         */
+        static constexpr int s_defaultMaxRunningRequests = 4;
+
+        /**
+         * @param maxRunningRequests Maximum amount of requests that are sent to the server at the same time. Further
+         *                           requests are queued.
+         */
+        explicit LanguageToolClient(int maxRunningRequests = s_defaultMaxRunningRequests);
+
+        /**
+         * Stops the network thread. Requests that haven't finished yet are cancelled.
+         */
+        ~LanguageToolClient() noexcept;
+
+        LanguageToolClient(LanguageToolClient const&) = delete;
+
+        LanguageToolClient& operator=(LanguageToolClient const&) = delete;
+
+        /**
+         * Send a POST request. Thread-safe.
+         * @param url Destination
+         * @param body Form-encoded request body
+         * @return Future that receives the response body. It is cancelled if the request failed.
+         */
+        QFuture<QByteArray> post(QUrl url, QByteArray body);
+
+        /**
+         * Send a POST request without waiting for the response. Thread-safe.
+         * @param url Destination
+         * @param body Form-encoded request body
+         * @param done Called exactly once with the response body on the network thread. Receives nothing if the
+         *             request failed or was cancelled.
+         * @param cancelled Checked before the request is sent; if it returns true, the request is skipped
+         */
+        void post(QUrl url, QByteArray body, LanguageToolResponseCallback done,
+                LanguageToolCancelCheck cancelled = {});
+
+        /**
+         * Send a POST request and receive the response body while it arrives. Thread-safe.
+         * @param url Destination
+         * @param body Form-encoded request body
+         * @param received Called on the network thread with each chunk of a successful response, in order
+         * @param done Called exactly once on the network thread after the last chunk. Receives an empty byte array if
+         *             the request succeeded, otherwise nothing; chunks received so far must be discarded then.
+         * @param cancelled Checked before the request is sent; if it returns true, the request is skipped
+         */
+        void postStreaming(QUrl url, QByteArray body, LanguageToolDataCallback received,
+                LanguageToolResponseCallback done, LanguageToolCancelCheck cancelled = {});
+
+    private:
+        QThread m_thread;
+        internal::LanguageToolNetworkWorker* m_worker;
+    };
+}
+
+#endif //NOVELIST_LANGUAGETOOLCLIENT_H
@@ -10,6 +10,9 @@
 #define NOVELIST_LANGUAGETOOLINSPECTOR_H
 
 #include <widgets/texteditor/Inspector.h>
+#include <widgets/texteditor/InspectionMetrics.h>
+#include "LanguageToolClient.h"
+#include "LanguageToolResponseParser.h"
 
 namespace novelist {
     /**
@@ -17,12 +20,59 @@ namespace novelist {
      */
     class LanguageToolInspector : public Inspector {
     public:
+        /**
+         * Default maximum amount of characters sent to the server in a single request
+         */
+        static constexpr int s_defaultMaxPayload = 20000;
+
+        /**
+         * Separates blocks that are checked in the same request. LanguageTool treats it as paragraph break.
+         */
+        static constexpr char const* s_blockSeparator = "\n\n";
+
+        LanguageToolInspector();
+
+        ~LanguageToolInspector() noexcept override;
+
         InspectionBlockResult inspect(QString const& text, Language lang) const noexcept override;
 
+        std::vector<InspectionBlockResult> inspectBatch(std::vector<QString> const& texts,
+                Language lang) const noexcept override;
+
+        void inspectAsync(std::vector<QString> texts, Language lang, std::vector<InspectionCancelToken> cancelled,
+                InspectionCallback done) const noexcept override;
+
+        bool isAsync() const noexcept override;
+
+        int batchSize() const noexcept override;
+
+        int maxConcurrency() const noexcept override;
+
+        QByteArray cacheKey() const noexcept override;
+
+        QString name() const noexcept override;
+
+        /**
+         * Splits the result of a request that contained several blocks back into results per block. Insights that
+         * span multiple blocks are dropped, insights are made relative to their block.
+         * @param combined Result of the whole request
+         * @param offsets Offset of each block within the request text
+         * @param lengths Length of each block
+         * @return One result per block
+         */
+        static std::vector<InspectionBlockResult> splitBatchResult(InspectionBlockResult combined,
+                std::vector<int> const& offsets, std::vector<int> const& lengths);
+
     private:
-        InspectionBlockResult parseJsonResponse(QJsonDocument const& json) const noexcept;
+        InspectorMetrics& m_metrics;
+        std::unique_ptr<LanguageToolClient> m_client;
+
+        void send(QString const& text, Language lang, LanguageToolDataCallback received,
+                LanguageToolResponseCallback done, LanguageToolCancelCheck cancelled) const;
+
+        static std::unique_ptr<InsightFactory> makeFactory(LanguageToolMatch match);
 
-        std::unique_ptr<InsightFactory> makeFactory(QString const& msg, QStringList suggestions, QJsonObject const& rule) const noexcept;
+        static QString makeMessage(LanguageToolMatch const& match);
     };
 }
 
@@ -0,0 +1,96 @@
+/**********************************************************
+ * @file   LanguageToolResponseParser.h
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#ifndef NOVELIST_LANGUAGETOOLRESPONSEPARSER_H
+#define NOVELIST_LANGUAGETOOLRESPONSEPARSER_H
+
+#include <functional>
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+namespace novelist {
+    /**
+     * Kind of issue reported by LanguageTool, as far as the plugin distinguishes them
+     */
+    enum class LanguageToolCategory {
+        Spelling,
+        Grammar,
+        Typography,
+    };
+
+    /**
+     * A single match reported by LanguageTool. Only the fields the plugin uses are extracted.
+     */
+    struct LanguageToolMatch {
+        QString m_message; //!< Detailed message
+        QString m_shortMessage; //!< Short message, might be empty
+        int m_offset = 0; //!< Offset of the match within the checked text
+        int m_length = 0; //!< Length of the match
+        QStringList m_replacements; //!< Suggested replacements
+        QString m_context; //!< Text surrounding the match
+        LanguageToolCategory m_category = LanguageToolCategory::Spelling; //!< Kind of issue
+    };
+
+    /**
+     * Incrementally parses the response of LanguageTool's /v2/check endpoint. Data can be passed in chunks of any size
+     * as it arrives, and every match is handed on as soon as it is complete, so most of the parsing is done while the
+     * rest of the response is still on its way. Only the current match is buffered, everything else is scanned once
+     * and dropped.
+     */
+    class LanguageToolResponseParser {
+    public:
+        /**
+         * Receives each match as soon as it is complete
+         */
+        using MatchCallback = std::function<void(LanguageToolMatch)>;
+
+        /**
+         * @param onMatch Receives the matches
+         */
+        explicit LanguageToolResponseParser(MatchCallback onMatch);
+
+        /**
+         * Parse the next chunk of the response
+         * @param chunk Data that directly follows the previously passed chunk
+         */
+        void feed(QByteArray const& chunk);
+
+        /**
+         * @return true if a complete and well-formed response has been passed
+         */
+        bool finish() const noexcept;
+
+        /**
+         * Classifies a rule as LanguageTool describes it
+         * @param issueType Issue type of the rule
+         * @param categoryId Id of the rule's category
+         * @return Category
+         */
+        static LanguageToolCategory classify(QByteArray const& issueType, QByteArray const& categoryId) noexcept;
+
+    private:
+        MatchCallback m_onMatch;
+        QByteArray m_buffer;
+        int m_pos = 0; // Next byte of the buffer to scan
+        QByteArray m_openers; // Brackets that are still open
+        bool m_started = false;
+        bool m_inString = false;
+        bool m_escaped = false;
+        bool m_expectKey = false; // The next string is a key of the root object
+        bool m_inMatches = false;
+        bool m_failed = false;
+        int m_stringStart = -1; // Start of the current string, if it is a key of the root object
+        int m_matchStart = -1; // Start of the current match
+        QByteArray m_lastRootKey;
+
+        bool parseMatch(char const* begin, char const* end);
+    };
+}
+
+#endif //NOVELIST_LANGUAGETOOLRESPONSEPARSER_H
@@ -0,0 +1,163 @@
+/**********************************************************
+ * @file   LanguageToolClient.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#include <algorithm>
+#include <vector>
+#include <QtCore/QDebug>
+#include <QtCore/QLoggingCategory>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+#include <gsl/gsl>
+#include "LanguageToolClient.h"
+
+namespace novelist {
+    namespace internal {
+        LanguageToolNetworkWorker::LanguageToolNetworkWorker(int maxRunningRequests) noexcept
+                :m_maxRunningRequests(std::max(1, maxRunningRequests))
+        {
+        }
+
+        LanguageToolNetworkWorker::~LanguageToolNetworkWorker() noexcept
+        {
+            // Nobody must wait forever for a request that will never be sent
+            for (auto& [reply, running] : m_running) {
+                reply->disconnect(this);
+                reply->abort();
+                running.m_done(std::nullopt);
+            }
+            QMutexLocker lock(&m_queueMutex);
+            auto queue = std::move(m_queue);
+            lock.unlock();
+            for (auto& r : queue)
+                r.m_done(std::nullopt);
+        }
+
+        void LanguageToolNetworkWorker::enqueue(QUrl url, QByteArray body, LanguageToolResponseCallback done,
+                LanguageToolCancelCheck cancelled, LanguageToolDataCallback received)
+        {
+            QMutexLocker lock(&m_queueMutex);
+            m_queue.push_back({std::move(url), std::move(body), std::move(done), std::move(cancelled),
+                    std::move(received)});
+        }
+
+        void LanguageToolNetworkWorker::processQueue()
+        {
+            if (m_network == nullptr) {
+                // Created lazily, so it belongs to the network thread
+                m_network = new QNetworkAccessManager(this);
+                QLoggingCategory::setFilterRules("qt.network.ssl.warning=false");
+            }
+
+            // Callbacks of skipped requests are called without holding the lock, so they may queue new requests
+            std::vector<LanguageToolResponseCallback> skipped;
+            auto notifySkipped = gsl::finally([&skipped] {
+                for (auto& done : skipped)
+                    done(std::nullopt);
+            });
+
+            QMutexLocker lock(&m_queueMutex);
+            while (!m_queue.empty() && static_cast<int>(m_running.size()) < m_maxRunningRequests) {
+                auto request = std::move(m_queue.front());
+                m_queue.pop_front();
+                if (request.m_cancelled && request.m_cancelled()) {
+                    skipped.push_back(std::move(request.m_done));
+                    continue;
+                }
+
+                QNetworkRequest dest(request.m_url);
+                dest.setHeader(QNetworkRequest::KnownHeaders::ContentTypeHeader, "application/x-www-form-urlencoded");
+                dest.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
+                QNetworkReply* reply = m_network->post(dest, request.m_body);
+                if (request.m_received)
+                    connect(reply, &QNetworkReply::readyRead, this, [this, reply] { onReadyRead(reply); });
+                connect(reply, &QNetworkReply::finished, this, [this, reply] { onFinished(reply); });
+                m_running.emplace(reply, RunningRequest{std::move(request.m_done), std::move(request.m_received)});
+            }
+        }
+
+        void LanguageToolNetworkWorker::onReadyRead(QNetworkReply* reply)
+        {
+            // Bodies of error responses are never handed on
+            int const status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            if (status < 200 || status >= 300)
+                return;
+
+            auto iter = m_running.find(reply);
+            if (iter != m_running.end())
+                iter->second.m_received(reply->readAll());
+        }
+
+        void LanguageToolNetworkWorker::onFinished(QNetworkReply* reply)
+        {
+            reply->deleteLater();
+            auto iter = m_running.find(reply);
+            if (iter == m_running.end())
+                return;
+
+            auto running = std::move(iter->second);
+            m_running.erase(iter);
+            if (reply->error() != QNetworkReply::NetworkError::NoError) {
+                qWarning() << "Communication with local LanguageTool server failed." << reply->error();
+                running.m_done(std::nullopt);
+            }
+            else if (running.m_received) {
+                if (reply->bytesAvailable() > 0)
+                    running.m_received(reply->readAll());
+                running.m_done(QByteArray());
+            }
+            else
+                running.m_done(reply->readAll());
+
+            processQueue();
+        }
+    }
+
+    LanguageToolClient::LanguageToolClient(int maxRunningRequests)
+            :m_worker(new internal::LanguageToolNetworkWorker(maxRunningRequests))
+    {
+        m_worker->moveToThread(&m_thread);
+        QObject::connect(&m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+        m_thread.setObjectName("LanguageTool network");
+        m_thread.start();
+    }
+
+    LanguageToolClient::~LanguageToolClient() noexcept
+    {
+        m_thread.quit();
+        m_thread.wait();
+    }
+
+    QFuture<QByteArray> LanguageToolClient::post(QUrl url, QByteArray body)
+    {
+        QFutureInterface<QByteArray> result;
+        result.reportStarted();
+        post(std::move(url), std::move(body), [result](std::optional<QByteArray> response) mutable {
+            if (response)
+                result.reportResult(*response);
+            else
+                result.reportCanceled();
+            result.reportFinished();
+        });
+        return result.future();
+    }
+
+    void LanguageToolClient::post(QUrl url, QByteArray body, LanguageToolResponseCallback done,
+            LanguageToolCancelCheck cancelled)
+    {
+        m_worker->enqueue(std::move(url), std::move(body), std::move(done), std::move(cancelled));
+        QMetaObject::invokeMethod(m_worker, "processQueue", Qt::QueuedConnection);
+    }
+
+    void LanguageToolClient::postStreaming(QUrl url, QByteArray body, LanguageToolDataCallback received,
+            LanguageToolResponseCallback done, LanguageToolCancelCheck cancelled)
+    {
+        m_worker->enqueue(std::move(url), std::move(body), std::move(done), std::move(cancelled),
+                std::move(received));
+        QMetaObject::invokeMethod(m_worker, "processQueue", Qt::QueuedConnection);
+    }
+}
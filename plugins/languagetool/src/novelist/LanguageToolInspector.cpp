@@ -6,6 +6,10 @@
  * @brief
  * @details
  **********************************************************/
+#include <algorithm>
+#include <future>
+#include <optional>
+#include <tuple>
 #include <QtNetwork>
 #include <document/SpellingInsight.h>
 #include <document/GrammarInsight.h>
@@ -14,108 +18,221 @@
 
 namespace novelist {
 
+    LanguageToolInspector::LanguageToolInspector()
+            :m_metrics(InspectionMetrics::instance().inspector("LanguageTool")),
+             m_client(std::make_unique<LanguageToolClient>())
+    {
+    }
+
+    LanguageToolInspector::~LanguageToolInspector() noexcept = default;
+
     InspectionBlockResult LanguageToolInspector::inspect(QString const& text, Language lang) const noexcept
     {
+        return inspectBatch({text}, lang).front();
+    }
+
+    std::vector<InspectionBlockResult> LanguageToolInspector::inspectBatch(std::vector<QString> const& texts,
+            Language lang) const noexcept
+    {
+        std::promise<std::vector<InspectionBlockResult>> promise;
+        auto results = promise.get_future();
+        std::vector<InspectionCancelToken> cancelled(texts.size(), std::make_shared<std::atomic_bool>(false));
+        inspectAsync(texts, lang, std::move(cancelled),
+                [&promise](std::vector<std::optional<InspectionBlockResult>> r) {
+                    // Blocks of failed requests come back without insights
+                    std::vector<InspectionBlockResult> all;
+                    all.reserve(r.size());
+                    for (auto& result : r)
+                        all.push_back(result ? std::move(*result) : InspectionBlockResult{});
+                    promise.set_value(std::move(all));
+                });
+        return results.get();
+    }
+
+    void LanguageToolInspector::inspectAsync(std::vector<QString> texts, Language lang,
+            std::vector<InspectionCancelToken> cancelled, InspectionCallback done) const noexcept
+    {
+        if (texts.empty()) {
+            done({});
+            return;
+        }
+
         QSettings settings;
-        QString url = settings.value("languagetool/url").toString();
-        QString disabledRules = settings.value("languagetool/ignore_rules").toString();
+        int const maxPayload = settings.value("languagetool/max_payload", s_defaultMaxPayload).toInt();
+        int const separatorLength = static_cast<int>(qstrlen(s_blockSeparator));
+
+        // Shared by all requests of this call, the last response to arrive hands the results on
+        struct PendingResults {
+            std::vector<std::optional<InspectionBlockResult>> m_results;
+            std::atomic<size_t> m_remainingRequests{0};
+            InspectionCallback m_done;
+        };
+        auto pending = std::make_shared<PendingResults>();
+        pending->m_results.resize(texts.size());
+        pending->m_done = std::move(done);
+
+        std::vector<std::tuple<QString, size_t, std::vector<int>, std::vector<int>>> requests;
+        size_t first = 0;
+        while (first < texts.size()) {
+            // Put as many blocks into one request as the payload limit allows, but at least one
+            QString text = texts[first];
+            std::vector<int> offsets{0};
+            std::vector<int> lengths{texts[first].size()};
+            size_t last = first + 1;
+            for (; last < texts.size() && text.size() + separatorLength + texts[last].size() <= maxPayload; ++last) {
+                text += s_blockSeparator;
+                offsets.push_back(text.size());
+                lengths.push_back(texts[last].size());
+                text += texts[last];
+            }
+
+            requests.emplace_back(std::move(text), first, std::move(offsets), std::move(lengths));
+            first = last;
+        }
+        pending->m_remainingRequests = requests.size();
+
+        // All requests are queued right away and processed by the server concurrently. Requests whose blocks were
+        // all cancelled while they waited in the queue are never sent.
+        for (auto& [text, firstBlock, offsets, lengths] : requests) {
+            // Blocks without a token are never cancelled, so neither is a request that contains any of them
+            std::vector<InspectionCancelToken> tokens;
+            if (firstBlock + offsets.size() <= cancelled.size())
+                tokens.assign(cancelled.begin() + firstBlock, cancelled.begin() + firstBlock + offsets.size());
+            auto isCancelled = [tokens] {
+                return !tokens.empty() && std::all_of(tokens.begin(), tokens.end(), [](auto const& t) {
+                    return t->load();
+                });
+            };
+            // Matches are parsed on the network thread while the rest of the response is still arriving
+            auto combined = std::make_shared<InspectionBlockResult>();
+            auto parser = std::make_shared<LanguageToolResponseParser>([combined](LanguageToolMatch match) {
+                int const left = match.m_offset;
+                int const right = match.m_offset + match.m_length;
+                combined->push_back({makeFactory(std::move(match)), left, right});
+            });
+            auto onData = [parser](QByteArray const& chunk) { parser->feed(chunk); };
+            auto onResponse = [this, pending, parser, combined, isCancelled, firstBlock = firstBlock,
+                    offsets = offsets, lengths = lengths](std::optional<QByteArray> response) {
+                if (response && parser->finish()) {
+                    auto results = splitBatchResult(std::move(*combined), offsets, lengths);
+                    std::move(results.begin(), results.end(), pending->m_results.begin() + firstBlock);
+                }
+                else if (!isCancelled())
+                    m_metrics.recordError();
+
+                if (pending->m_remainingRequests.fetch_sub(1) == 1)
+                    pending->m_done(std::move(pending->m_results));
+            };
+            send(text, lang, std::move(onData), std::move(onResponse), std::move(isCancelled));
+        }
+    }
+
+    bool LanguageToolInspector::isAsync() const noexcept
+    {
+        // Requests are handled by the client's network thread, inspection threads don't have to wait for them
+        return true;
+    }
+
+    int LanguageToolInspector::batchSize() const noexcept
+    {
+        // The payload limit decides how many of these actually go into the same request
+        return 50;
+    }
 
-        QNetworkAccessManager network;
-        QLoggingCategory::setFilterRules("qt.network.ssl.warning=false");
+    std::vector<InspectionBlockResult> LanguageToolInspector::splitBatchResult(InspectionBlockResult combined,
+            std::vector<int> const& offsets, std::vector<int> const& lengths)
+    {
+        Expects(offsets.size() == lengths.size());
+
+        std::vector<InspectionBlockResult> results(offsets.size());
+        for (auto& insight : combined) {
+            auto iter = std::upper_bound(offsets.begin(), offsets.end(), insight.m_left);
+            if (iter == offsets.begin())
+                continue;
+            auto const idx = static_cast<size_t>(std::distance(offsets.begin(), iter) - 1);
+            int const left = insight.m_left - offsets[idx];
+            int const right = insight.m_right - offsets[idx];
+            if (right > lengths[idx] || left >= right)
+                continue; // Spans the separator
+            insight.m_left = left;
+            insight.m_right = right;
+            results[idx].push_back(std::move(insight));
+        }
+        return results;
+    }
 
-        QNetworkRequest dest(QUrl(url + "/v2/check"));
-        dest.setHeader(QNetworkRequest::KnownHeaders::ContentTypeHeader, "application/x-www-form-urlencoded");
+    void LanguageToolInspector::send(QString const& text, Language lang, LanguageToolDataCallback received,
+            LanguageToolResponseCallback done, LanguageToolCancelCheck cancelled) const
+    {
+        QSettings settings;
+        QString url = settings.value("languagetool/url").toString();
+        QString disabledRules = settings.value("languagetool/ignore_rules").toString();
 
         QUrlQuery request;
         request.addQueryItem("text", text);
         request.addQueryItem("language", lang::identifier(lang));
         request.addQueryItem("disabledRules", disabledRules);
-        QString requestStr = request.toString(QUrl::FullyEncoded);
-
-        QByteArray response;
-        QNetworkReply* reply = network.post(dest, requestStr.toUtf8());
-        auto releaseReply = gsl::finally([reply] { delete reply; });
-
-        // Wait for response
-        QEventLoop loop;
-        QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-        loop.exec();
-        response += reply->readAll();
-
-        auto error = reply->error();
-        if (error != QNetworkReply::NetworkError::NoError) {
-            qWarning() << "Communication with local LanguageTool server failed." << error;
-            return InspectionBlockResult();
-        }
+        QByteArray body = request.toString(QUrl::FullyEncoded).toUtf8();
 
-        // Parse response
-        QJsonDocument json = QJsonDocument::fromJson(response);
-        InspectionBlockResult result = parseJsonResponse(json);
+        m_metrics.recordBytesSent(static_cast<size_t>(body.size()));
+        m_client->postStreaming(QUrl(url + "/v2/check"), std::move(body), std::move(received), std::move(done),
+                std::move(cancelled));
+    }
 
-        return result;
+    int LanguageToolInspector::maxConcurrency() const noexcept
+    {
+        // A local LanguageTool server handles few requests at a time; queueing more just makes them time out
+        return 2;
     }
 
-    InspectionBlockResult LanguageToolInspector::parseJsonResponse(QJsonDocument const& json) const noexcept
+    QByteArray LanguageToolInspector::cacheKey() const noexcept
     {
-        InspectionBlockResult result;
-
-        if (json.isObject()) {
-            auto root = json.object();
-            auto matches = root.value("matches");
-            auto matchesArr = matches.toArray();
-            for (auto val : matchesArr) {
-                auto obj = val.toObject();
-                QString msg = obj.value("message").toString();
-                QString shortMsg = obj.value("shortMessage").toString("");
-                int pos = obj.value("offset").toInt();
-                int length = obj.value("length").toInt();
-                QJsonArray replacements = obj.value("replacements").toArray();
-                QStringList replacementStrings;
-                for (auto o : replacements)
-                    replacementStrings.push_back(o.toObject().value("value").toString());
-                QJsonObject context = obj.value("context").toObject();
-                QString contextStr = context.value("text").toString();
-                QJsonObject rule = obj.value("rule").toObject();
-
-                InspectionInsight insight;
-                QString aggregateMsg;
-                if (!shortMsg.isEmpty())
-                    aggregateMsg += shortMsg + "\n\n";
-                aggregateMsg += msg + "\n";
-                if (replacementStrings.isEmpty())
-                    aggregateMsg += QObject::tr("No suggestions available.\n", "LanguageToolInspector");
-                else {
-                    aggregateMsg += QObject::tr("Suggestions: ", "LanguageToolInspector");
-                    aggregateMsg += replacementStrings.first();
-                    for (auto iter = replacementStrings.begin() + 1; iter != replacementStrings.end(); ++iter) {
-                        aggregateMsg += ", " + *iter;
-                    }
-                    aggregateMsg += "\n";
-                }
-                aggregateMsg += QObject::tr("In this context: ", "LanguageToolInspector");
-                aggregateMsg += contextStr;
-                insight.m_factory = makeFactory(aggregateMsg, replacementStrings, rule);
-                insight.m_left = pos;
-                insight.m_right = pos + length;
+        // Blocks of failed requests are reported without a result, so they are never cached under this key
+        QSettings settings;
+        return "languagetool/1|" + settings.value("languagetool/url").toByteArray() + "|"
+                + settings.value("languagetool/ignore_rules").toByteArray() + "|"
+                + settings.value("languagetool/max_payload", s_defaultMaxPayload).toByteArray();
+    }
 
-                result.push_back(std::move(insight));
-            }
+    QString LanguageToolInspector::name() const noexcept
+    {
+        return m_metrics.name();
+    }
+
+    std::unique_ptr<InsightFactory> LanguageToolInspector::makeFactory(LanguageToolMatch match)
+    {
+        // Most insights are never looked at, so their message is only put together once it is shown
+        QStringList suggestions = match.m_replacements;
+        LanguageToolCategory const category = match.m_category;
+        auto shared = std::make_shared<LanguageToolMatch const>(std::move(match));
+        auto msgBuilder = [shared] { return makeMessage(*shared); };
+
+        switch (category) {
+            case LanguageToolCategory::Grammar:
+                return std::make_unique<AutoInsightFactory<GrammarInsight>>(msgBuilder, std::move(suggestions));
+            case LanguageToolCategory::Typography:
+                return std::make_unique<AutoInsightFactory<TypographyInsight>>(msgBuilder, std::move(suggestions));
+            case LanguageToolCategory::Spelling:
+                break;
         }
-        return result;
+        return std::make_unique<AutoInsightFactory<SpellingInsight>>(msgBuilder, std::move(suggestions));
     }
 
-    std::unique_ptr<InsightFactory>
-    LanguageToolInspector::makeFactory(QString const& msg, QStringList suggestions, QJsonObject const& rule) const noexcept
+    QString LanguageToolInspector::makeMessage(LanguageToolMatch const& match)
     {
-        QString issueType = rule.value("issueType").toString("");
-        QString catId = rule.value("category").toObject().value("id").toString("");
-        QString combinedType = issueType + catId;
-
-        if (combinedType.contains(QRegExp("grammar|grammatic", Qt::CaseSensitivity::CaseInsensitive)))
-            return std::make_unique<AutoInsightFactory<GrammarInsight>>(msg, suggestions);
-        else if (combinedType.contains(QRegExp("typographical|typography", Qt::CaseSensitivity::CaseInsensitive)))
-            return std::make_unique<AutoInsightFactory<TypographyInsight>>(msg, suggestions);
-        else
-            return std::make_unique<AutoInsightFactory<SpellingInsight>>(msg, suggestions);
+        QString msg;
+        if (!match.m_shortMessage.isEmpty())
+            msg += match.m_shortMessage + "\n\n";
+        msg += match.m_message + "\n";
+        if (match.m_replacements.isEmpty())
+            msg += QObject::tr("No suggestions available.\n", "LanguageToolInspector");
+        else {
+            msg += QObject::tr("Suggestions: ", "LanguageToolInspector");
+            msg += match.m_replacements.join(", ");
+            msg += "\n";
+        }
+        msg += QObject::tr("In this context: ", "LanguageToolInspector");
+        msg += match.m_context;
+        return msg;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,435 @@
+/**********************************************************
+ * @file   LanguageToolResponseParser.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#include <algorithm>
+#include <iterator>
+#include <QtCore/QByteArrayMatcher>
+#include "LanguageToolResponseParser.h"
+
+namespace novelist {
+    namespace {
+        /**
+         * Pull parser over a complete JSON value. Values that aren't needed are skipped without being decoded.
+         */
+        class JsonReader {
+        public:
+            JsonReader(char const* begin, char const* end) noexcept
+                    :m_pos(begin),
+                     m_end(end)
+            {
+            }
+
+            bool ok() const noexcept
+            {
+                return m_ok;
+            }
+
+            /**
+             * @return String contents without decoding escape sequences. Only valid while the underlying data is.
+             */
+            QByteArray readRaw()
+            {
+                if (!consume('"')) {
+                    skipValue();
+                    return QByteArray();
+                }
+                char const* start = m_pos;
+                skipStringContents();
+                if (!m_ok)
+                    return QByteArray();
+                return QByteArray::fromRawData(start, static_cast<int>(m_pos - start - 1));
+            }
+
+            QString readString()
+            {
+                if (!consume('"')) {
+                    skipValue();
+                    return QString();
+                }
+
+                QString result;
+                char const* run = m_pos;
+                while (m_pos < m_end && *m_pos != '"') {
+                    if (*m_pos != '\\') {
+                        ++m_pos;
+                        continue;
+                    }
+                    result += QString::fromUtf8(run, static_cast<int>(m_pos - run));
+                    if (m_end - m_pos < 2)
+                        return fail<QString>();
+                    char const escaped = m_pos[1];
+                    m_pos += 2;
+                    switch (escaped) {
+                        case '"':
+                        case '\\':
+                        case '/':
+                            result += QLatin1Char(escaped);
+                            break;
+                        case 'b':
+                            result += QLatin1Char('\b');
+                            break;
+                        case 'f':
+                            result += QLatin1Char('\f');
+                            break;
+                        case 'n':
+                            result += QLatin1Char('\n');
+                            break;
+                        case 'r':
+                            result += QLatin1Char('\r');
+                            break;
+                        case 't':
+                            result += QLatin1Char('\t');
+                            break;
+                        case 'u': {
+                            // Surrogate pairs arrive as two escapes, each of which is a valid UTF-16 code unit
+                            bool valid = m_end - m_pos >= 4;
+                            ushort const unit = valid ? QByteArray::fromRawData(m_pos, 4).toUShort(&valid, 16) : 0;
+                            if (!valid)
+                                return fail<QString>();
+                            result += QChar(unit);
+                            m_pos += 4;
+                            break;
+                        }
+                        default:
+                            return fail<QString>();
+                    }
+                    run = m_pos;
+                }
+                if (m_pos >= m_end)
+                    return fail<QString>();
+                result += QString::fromUtf8(run, static_cast<int>(m_pos - run));
+                ++m_pos;
+                return result;
+            }
+
+            int readInt()
+            {
+                skipWhitespace();
+                bool const negative = m_pos < m_end && *m_pos == '-';
+                if (negative)
+                    ++m_pos;
+                if (m_pos >= m_end || !isDigit(*m_pos)) {
+                    skipValue();
+                    return 0;
+                }
+                int result = 0;
+                for (; m_pos < m_end && isDigit(*m_pos); ++m_pos)
+                    result = result * 10 + (*m_pos - '0');
+                skipLiteral(); // Fractions and exponents
+                return negative ? -result : result;
+            }
+
+            /**
+             * @param onKey Called with each key, must consume the value
+             */
+            template<typename F>
+            void readObject(F onKey)
+            {
+                if (!consume('{')) {
+                    m_ok = false;
+                    return;
+                }
+                if (consume('}'))
+                    return;
+                do {
+                    QByteArray const key = readRaw();
+                    if (!m_ok || !consume(':'))
+                        return fail<void>();
+                    onKey(key);
+                } while (m_ok && consume(','));
+                if (!consume('}'))
+                    m_ok = false;
+            }
+
+            /**
+             * @param onElement Called for each element, must consume it
+             */
+            template<typename F>
+            void readArray(F onElement)
+            {
+                if (!consume('[')) {
+                    skipValue();
+                    return;
+                }
+                if (consume(']'))
+                    return;
+                do
+                    onElement();
+                while (m_ok && consume(','));
+                if (!consume(']'))
+                    m_ok = false;
+            }
+
+            void skipValue()
+            {
+                skipWhitespace();
+                if (m_pos >= m_end)
+                    return fail<void>();
+                switch (*m_pos) {
+                    case '"':
+                        ++m_pos;
+                        skipStringContents();
+                        break;
+                    case '{':
+                        readObject([this](QByteArray const&) { skipValue(); });
+                        break;
+                    case '[':
+                        readArray([this] { skipValue(); });
+                        break;
+                    default:
+                        if (!skipLiteral())
+                            m_ok = false;
+                        break;
+                }
+            }
+
+        private:
+            char const* m_pos;
+            char const* const m_end;
+            bool m_ok = true;
+
+            static bool isDigit(char c) noexcept
+            {
+                return c >= '0' && c <= '9';
+            }
+
+            template<typename T>
+            T fail()
+            {
+                m_ok = false;
+                m_pos = m_end;
+                return T();
+            }
+
+            void skipWhitespace() noexcept
+            {
+                while (m_pos < m_end && (*m_pos == ' ' || *m_pos == '\n' || *m_pos == '\r' || *m_pos == '\t'))
+                    ++m_pos;
+            }
+
+            bool consume(char c) noexcept
+            {
+                skipWhitespace();
+                if (m_pos < m_end && *m_pos == c) {
+                    ++m_pos;
+                    return true;
+                }
+                return false;
+            }
+
+            // Numbers, true, false and null
+            bool skipLiteral() noexcept
+            {
+                char const* start = m_pos;
+                while (m_pos < m_end && (isDigit(*m_pos) || (*m_pos >= 'a' && *m_pos <= 'z') || *m_pos == '-'
+                        || *m_pos == '+' || *m_pos == '.' || *m_pos == 'E'))
+                    ++m_pos;
+                return m_pos != start;
+            }
+
+            // Expects the opening quote to be consumed already, consumes the closing quote
+            void skipStringContents() noexcept
+            {
+                for (; m_pos < m_end; ++m_pos) {
+                    if (*m_pos == '\\')
+                        ++m_pos;
+                    else if (*m_pos == '"') {
+                        ++m_pos;
+                        return;
+                    }
+                }
+                fail<void>();
+            }
+        };
+    }
+
+    LanguageToolResponseParser::LanguageToolResponseParser(MatchCallback onMatch)
+            :m_onMatch(std::move(onMatch))
+    {
+    }
+
+    void LanguageToolResponseParser::feed(QByteArray const& chunk)
+    {
+        if (m_failed)
+            return;
+        m_buffer += chunk;
+
+        // Tracks just enough structure to find the elements of the root object's "matches" array. Each element is
+        // parsed as soon as its closing brace arrives.
+        char const* data = m_buffer.constData();
+        int const size = m_buffer.size();
+        for (; m_pos < size && !m_failed; ++m_pos) {
+            char const c = data[m_pos];
+            if (m_inString) {
+                if (m_escaped)
+                    m_escaped = false;
+                else if (c == '\\')
+                    m_escaped = true;
+                else if (c == '"') {
+                    m_inString = false;
+                    if (m_stringStart >= 0)
+                        m_lastRootKey = m_buffer.mid(m_stringStart, m_pos - m_stringStart);
+                    m_stringStart = -1;
+                }
+                continue;
+            }
+
+            switch (c) {
+                case '"':
+                    m_inString = true;
+                    if (m_expectKey)
+                        m_stringStart = m_pos + 1;
+                    m_expectKey = false;
+                    break;
+                case ',':
+                    // Strings of the root object right after its opening brace or a comma are keys, not values
+                    m_failed = m_openers.isEmpty();
+                    m_expectKey = m_openers.size() == 1;
+                    break;
+                case '{':
+                case '[':
+                    if (m_openers.isEmpty()) {
+                        m_failed = m_started || c != '{';
+                        m_started = true;
+                    }
+                    m_openers += c;
+                    m_expectKey = m_openers.size() == 1;
+                    if (m_openers.size() == 2 && c == '[' && m_lastRootKey == "matches")
+                        m_inMatches = true;
+                    else if (m_inMatches && m_openers.size() == 3)
+                        m_matchStart = m_pos;
+                    break;
+                case '}':
+                case ']':
+                    if (m_openers.isEmpty() || !m_openers.endsWith(c == '}' ? '{' : '[')) {
+                        m_failed = true;
+                        break;
+                    }
+                    if (m_matchStart >= 0 && m_openers.size() == 3) {
+                        m_failed = !parseMatch(data + m_matchStart, data + m_pos + 1);
+                        m_matchStart = -1;
+                    }
+                    m_openers.chop(1);
+                    if (m_openers.size() == 1)
+                        m_inMatches = false;
+                    break;
+                case ' ':
+                case '\n':
+                case '\r':
+                case '\t':
+                    break;
+                default:
+                    m_failed = m_openers.isEmpty(); // Nothing but whitespace may surround the root object
+                    break;
+            }
+        }
+
+        // Everything that was scanned is dropped, except for the incomplete match or root key
+        int keep = m_pos;
+        if (m_matchStart >= 0)
+            keep = std::min(keep, m_matchStart);
+        if (m_stringStart >= 0)
+            keep = std::min(keep, m_stringStart);
+        if (keep > 0) {
+            m_buffer.remove(0, keep);
+            m_pos -= keep;
+            if (m_matchStart >= 0)
+                m_matchStart -= keep;
+            if (m_stringStart >= 0)
+                m_stringStart -= keep;
+        }
+    }
+
+    bool LanguageToolResponseParser::finish() const noexcept
+    {
+        return !m_failed && m_started && m_openers.isEmpty() && !m_inString;
+    }
+
+    LanguageToolCategory LanguageToolResponseParser::classify(QByteArray const& issueType,
+            QByteArray const& categoryId) noexcept
+    {
+        static QByteArrayMatcher const grammar("grammar");
+        static QByteArrayMatcher const grammatic("grammatic");
+        static QByteArrayMatcher const typographical("typographical");
+        static QByteArrayMatcher const typography("typography");
+
+        // Fields are searched separately, so a hit can't span both of them
+        QByteArray const fields[] = {issueType.toLower(), categoryId.toLower()};
+        auto found = [&fields](QByteArrayMatcher const& matcher) {
+            return std::any_of(std::begin(fields), std::end(fields), [&matcher](QByteArray const& field) {
+                return matcher.indexIn(field) >= 0;
+            });
+        };
+        if (found(grammar) || found(grammatic))
+            return LanguageToolCategory::Grammar;
+        if (found(typographical) || found(typography))
+            return LanguageToolCategory::Typography;
+        return LanguageToolCategory::Spelling;
+    }
+
+    bool LanguageToolResponseParser::parseMatch(char const* begin, char const* end)
+    {
+        JsonReader reader(begin, end);
+        LanguageToolMatch match;
+        QByteArray issueType;
+        QByteArray categoryId;
+
+        auto readStringField = [&reader](QByteArray const& wanted, QString& target) {
+            return [&reader, wanted, &target](QByteArray const& key) {
+                if (key == wanted)
+                    target = reader.readString();
+                else
+                    reader.skipValue();
+            };
+        };
+
+        reader.readObject([&](QByteArray const& key) {
+            if (key == "message")
+                match.m_message = reader.readString();
+            else if (key == "shortMessage")
+                match.m_shortMessage = reader.readString();
+            else if (key == "offset")
+                match.m_offset = reader.readInt();
+            else if (key == "length")
+                match.m_length = reader.readInt();
+            else if (key == "replacements") {
+                reader.readArray([&] {
+                    QString value;
+                    reader.readObject(readStringField("value", value));
+                    match.m_replacements.push_back(value);
+                });
+            }
+            else if (key == "context")
+                reader.readObject(readStringField("text", match.m_context));
+            else if (key == "rule") {
+                reader.readObject([&](QByteArray const& ruleKey) {
+                    if (ruleKey == "issueType")
+                        issueType = reader.readRaw();
+                    else if (ruleKey == "category") {
+                        reader.readObject([&](QByteArray const& categoryKey) {
+                            if (categoryKey == "id")
+                                categoryId = reader.readRaw();
+                            else
+                                reader.skipValue();
+                        });
+                    }
+                    else
+                        reader.skipValue();
+                });
+            }
+            else
+                reader.skipValue();
+        });
+        if (!reader.ok())
+            return false;
+
+        match.m_category = classify(issueType, categoryId);
+        m_onMatch(std::move(match));
+        return true;
+    }
+}
@@ -10,6 +10,7 @@
 #include <QtCore/QTimer>
 #include <QtWidgets/QMainWindow>
 #include "SettingsPage_LanguageTool.h"
+#include "LanguageToolInspector.h"
 #include "ui_SettingsPage_LanguageTool.h"
 
 namespace novelist {
@@ -60,6 +61,8 @@ namespace novelist {
 
         page->m_ui->lineEditServerUrl->setText(settings.value("url", "http://localhost:8081").toString());
         page->m_ui->lineEditIgnoreRules->setText(settings.value("ignore_rules", "").toString());
+        page->m_ui->spinBoxMaxPayload->setValue(
+                settings.value("max_payload", LanguageToolInspector::s_defaultMaxPayload).toInt());
         page->m_ui->groupBoxAutoStart->setChecked(settings.value("autostart", true).toBool());
         page->m_ui->filePicker->setSelectedFile(settings.value("path", "").toString());
         page->m_ui->lineEditJava->setText(settings.value("java", "java").toString());
@@ -76,6 +79,7 @@ namespace novelist {
             url.truncate(url.size()-1);
         settings.setValue("url", url);
         settings.setValue("ignore_rules", page->m_ui->lineEditIgnoreRules->text());
+        settings.setValue("max_payload", page->m_ui->spinBoxMaxPayload->value());
         settings.setValue("autostart", page->m_ui->groupBoxAutoStart->isChecked());
         settings.setValue("path", page->m_ui->filePicker->selectedFile());
         settings.setValue("java", page->m_ui->lineEditJava->text());
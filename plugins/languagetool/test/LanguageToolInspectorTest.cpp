@@ -0,0 +1,286 @@
+/**********************************************************
+ * @file   LanguageToolInspectorTest.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+
+#include <algorithm>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <random>
+#include <tuple>
+#include <catch.hpp>
+#include <gsl/gsl>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSettings>
+#include <widgets/texteditor/InspectionCache.h>
+#include <widgets/texteditor/InspectionMetrics.h>
+#include <widgets/texteditor/TextEditorInsightManager.h>
+#include <LanguageToolClient.h>
+#include <LanguageToolInspector.h>
+#include "LanguageToolStubServer.h"
+
+using namespace novelist;
+
+namespace {
+    LanguageToolStubConfig makeConfig(int latency, int latencyJitter, double errorRate, double matchDensity)
+    {
+        LanguageToolStubConfig config;
+        config.m_latency = latency;
+        config.m_latencyJitter = latencyJitter;
+        config.m_errorRate = errorRate;
+        config.m_matchDensity = matchDensity;
+        config.m_seed = 42;
+        return config;
+    }
+
+    std::vector<QString> makeParagraphs(size_t count)
+    {
+        static char const* const words[] = {"the", "dragon", "slept", "beneath", "a", "mountain", "of", "gold",
+                "while", "knights", "argued", "about", "who", "should", "wake", "it", "first", "and", "why"};
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<size_t> wordDist(0, std::size(words) - 1);
+        std::uniform_int_distribution<int> lengthDist(20, 80);
+
+        std::vector<QString> paragraphs;
+        for (size_t i = 0; i < count; ++i) {
+            QString paragraph;
+            for (int w = lengthDist(rng); w > 0; --w)
+                paragraph += QString(words[wordDist(rng)]) + (w > 1 ? " " : ".");
+            paragraph[0] = paragraph[0].toUpper();
+            paragraphs.push_back(paragraph);
+        }
+        return paragraphs;
+    }
+}
+
+TEST_CASE("LanguageToolStubServer", "[LanguageTool]")
+{
+    LanguageToolStubServer server(makeConfig(0, 0, 0, 1));
+    LanguageToolClient client;
+    QUrl const checkUrl(server.url() + "/v2/check");
+
+    SECTION("Check") {
+        auto response = client.post(checkUrl, "text=Hello%20world&language=en-US");
+        response.waitForFinished();
+        REQUIRE(!response.isCanceled());
+        auto matches = QJsonDocument::fromJson(response.result()).object().value("matches").toArray();
+        REQUIRE(matches.size() == 2);
+        REQUIRE(matches[0].toObject().value("offset").toInt() == 0);
+        REQUIRE(matches[0].toObject().value("length").toInt() == 5);
+        REQUIRE(matches[1].toObject().value("offset").toInt() == 6);
+        REQUIRE(matches[1].toObject().value("length").toInt() == 5);
+        REQUIRE(server.stats().m_requests == 1u);
+        REQUIRE(server.stats().m_matches == 2u);
+    }
+
+    SECTION("Deterministic matches") {
+        QString const text = "Some words are flagged, others are not.";
+        REQUIRE(LanguageToolStubServer::makeCheckResponse(text, "en-US", 0.5, 1)
+                == LanguageToolStubServer::makeCheckResponse(text, "en-US", 0.5, 1));
+        int matchCount = -1;
+        LanguageToolStubServer::makeCheckResponse(text, "en-US", 0, 1, &matchCount);
+        REQUIRE(matchCount == 0);
+        LanguageToolStubServer::makeCheckResponse(text, "en-US", 1, 1, &matchCount);
+        REQUIRE(matchCount == 7);
+    }
+
+    SECTION("Server errors") {
+        server.setConfig(makeConfig(0, 0, 1, 1));
+        auto response = client.post(checkUrl, "text=Hello&language=en-US");
+        response.waitForFinished();
+        REQUIRE(response.isCanceled());
+        REQUIRE(server.stats().m_errors == 1u);
+    }
+
+    SECTION("Invalid requests") {
+        auto wrongPath = client.post(QUrl(server.url() + "/v2/languages"), "text=Hello&language=en-US");
+        auto missingLanguage = client.post(checkUrl, "text=Hello");
+        wrongPath.waitForFinished();
+        missingLanguage.waitForFinished();
+        REQUIRE(wrongPath.isCanceled());
+        REQUIRE(missingLanguage.isCanceled());
+        REQUIRE(server.stats().m_errors == 2u);
+    }
+}
+
+TEST_CASE("LanguageToolInspector", "[LanguageTool]")
+{
+    LanguageToolStubServer server(makeConfig(0, 0, 0, 1));
+    QSettings settings;
+    settings.setValue("languagetool/url", server.url());
+    auto restoreSettings = gsl::finally([] { QSettings().remove("languagetool"); });
+    LanguageToolInspector inspector;
+
+    auto checkResults = [](std::vector<InspectionBlockResult> const& results) {
+        REQUIRE(results.size() == 3);
+        REQUIRE(results[0].size() == 2);
+        REQUIRE(results[0][1].m_left == 6);
+        REQUIRE(results[0][1].m_right == 11);
+        REQUIRE(results[1].size() == 1);
+        REQUIRE(results[1][0].m_left == 0);
+        REQUIRE(results[1][0].m_right == 3);
+        REQUIRE(results[2].empty());
+    };
+
+    SECTION("Blocks share a request") {
+        checkResults(inspector.inspectBatch({"Hello world", "Foo", ""}, Language::en_US));
+        REQUIRE(server.stats().m_requests == 1u);
+    }
+
+    SECTION("Payload limit") {
+        settings.setValue("languagetool/max_payload", 5);
+        checkResults(inspector.inspectBatch({"Hello world", "Foo", ""}, Language::en_US));
+        REQUIRE(server.stats().m_requests == 2u);
+    }
+
+    SECTION("Connections are reused") {
+        settings.setValue("languagetool/max_payload", 1);
+        server.setConfig(makeConfig(5, 5, 0, 1));
+        auto results = inspector.inspectBatch(std::vector<QString>(32, "Lorem ipsum"), Language::en_US);
+        REQUIRE(std::all_of(results.begin(), results.end(), [](auto const& r) { return r.size() == 2; }));
+        auto const stats = server.stats();
+        REQUIRE(stats.m_requests == 32u);
+        REQUIRE(stats.m_connections <= static_cast<uint64_t>(LanguageToolClient::s_defaultMaxRunningRequests));
+        REQUIRE(stats.m_maxConcurrentRequests <= LanguageToolClient::s_defaultMaxRunningRequests);
+    }
+
+    SECTION("Batching doesn't change matches") {
+        server.setConfig(makeConfig(0, 0, 0, 0.3));
+        auto const paragraphs = makeParagraphs(20);
+        auto describe = [](std::vector<InspectionBlockResult> const& results) {
+            std::vector<std::vector<std::tuple<int, int, QString, QString>>> blocks;
+            for (auto const& result : results) {
+                blocks.emplace_back();
+                for (auto const& insight : result) {
+                    auto const description = insight.m_factory->describe();
+                    blocks.back().emplace_back(insight.m_left, insight.m_right, description.m_type,
+                            description.m_message);
+                }
+            }
+            return blocks;
+        };
+
+        auto const batched = describe(inspector.inspectBatch(paragraphs, Language::en_US));
+        REQUIRE(server.stats().m_requests == 1u);
+        settings.setValue("languagetool/max_payload", 1);
+        auto const unbatched = describe(inspector.inspectBatch(paragraphs, Language::en_US));
+        REQUIRE(server.stats().m_requests == 1u + paragraphs.size());
+        REQUIRE(batched == unbatched);
+        REQUIRE(std::any_of(batched.begin(), batched.end(), [](auto const& b) { return !b.empty(); }));
+    }
+
+    SECTION("Texts without a cancellation token") {
+        settings.setValue("languagetool/max_payload", 5);
+        std::promise<std::vector<std::optional<InspectionBlockResult>>> promise;
+        auto pending = promise.get_future();
+        inspector.inspectAsync({"Hello world", "Foo"}, Language::en_US, {std::make_shared<std::atomic_bool>(true)},
+                [&promise](std::vector<std::optional<InspectionBlockResult>> r) { promise.set_value(std::move(r)); });
+        auto const results = pending.get();
+        REQUIRE(results.size() == 2);
+        REQUIRE(!results[0]);
+        REQUIRE(results[1]);
+        REQUIRE(results[1]->size() == 1);
+        REQUIRE(server.stats().m_requests == 1u);
+    }
+
+    SECTION("Failed requests") {
+        server.setConfig(makeConfig(0, 0, 1, 1));
+        auto const cacheKey = inspector.cacheKey();
+        auto const errors = InspectionMetrics::instance().inspector(inspector.name()).snapshot().m_errors;
+
+        auto results = inspector.inspectBatch({"Hello world"}, Language::en_US);
+        REQUIRE(results.size() == 1);
+        REQUIRE(results.front().empty());
+        REQUIRE(inspector.cacheKey() == cacheKey);
+        REQUIRE(InspectionMetrics::instance().inspector(inspector.name()).snapshot().m_errors == errors + 1);
+
+        // Failed blocks come back without a result and aren't cached
+        std::promise<std::vector<std::optional<InspectionBlockResult>>> promise;
+        auto pending = promise.get_future();
+        inspector.inspectAsync({"Hello world", "Foo"}, Language::en_US,
+                {std::make_shared<std::atomic_bool>(false), std::make_shared<std::atomic_bool>(false)},
+                [&promise](std::vector<std::optional<InspectionBlockResult>> r) { promise.set_value(std::move(r)); });
+        auto const asyncResults = pending.get();
+        REQUIRE(asyncResults.size() == 2);
+        REQUIRE(!asyncResults[0]);
+        REQUIRE(!asyncResults[1]);
+
+        std::vector<std::unique_ptr<Inspector>> inspectors;
+        inspectors.push_back(std::make_unique<LanguageToolInspector>());
+        QReadWriteLock lock;
+        QObject receiver;
+        auto cache = std::make_shared<InspectionCache>();
+        auto inspect = [&](uint64_t batch) {
+            internal::InspectionRequest request{{"Hello world"}, {std::make_shared<std::atomic_bool>(false)},
+                                                Language::en_US, cache, &receiver, batch, 0};
+            internal::runInspection(std::move(request), &inspectors, &lock);
+            QCoreApplication::removePostedEvents(&receiver);
+        };
+        inspect(1);
+        REQUIRE(cache->size() == 0);
+
+        server.setConfig(makeConfig(0, 0, 0, 1));
+        inspect(2);
+        REQUIRE(cache->size() == 1);
+    }
+}
+
+TEST_CASE("LanguageTool benchmark", "[.][benchmark][LanguageTool]")
+{
+    struct Scenario {
+        char const* m_name;
+        LanguageToolStubConfig m_config;
+    };
+    std::vector<Scenario> const scenarios{
+            {"Instant", makeConfig(0, 0, 0, 0.05)},
+            {"Typical", makeConfig(20, 20, 0, 0.05)},
+            {"Slow", makeConfig(200, 100, 0, 0.05)},
+            {"Dense", makeConfig(20, 20, 0, 0.5)},
+            {"Flaky", makeConfig(20, 20, 0.1, 0.05)},
+    };
+    auto const paragraphs = makeParagraphs(300);
+
+    for (auto const& scenario : scenarios) {
+        LanguageToolStubServer server(scenario.m_config);
+        QSettings settings;
+        settings.setValue("languagetool/url", server.url());
+        auto restoreSettings = gsl::finally([] { QSettings().remove("languagetool"); });
+
+        std::vector<std::unique_ptr<Inspector>> inspectors;
+        inspectors.push_back(std::make_unique<LanguageToolInspector>());
+        QReadWriteLock lock;
+        QObject receiver;
+        auto cache = std::make_shared<InspectionCache>();
+        auto run = [&] {
+            internal::InspectionRequest request{paragraphs, {}, Language::en_US, cache, &receiver, 1, 0};
+            for (size_t i = 0; i < paragraphs.size(); ++i)
+                request.m_cancelled.push_back(std::make_shared<std::atomic_bool>(false));
+            QElapsedTimer timer;
+            timer.start();
+            internal::runInspection(std::move(request), &inspectors, &lock);
+            QCoreApplication::removePostedEvents(&receiver);
+            return timer.elapsed();
+        };
+
+        auto const cold = run();
+        auto const stats = server.stats();
+        auto const warm = run();
+
+        WARN(QString("%1: %2 blocks, cold %3 ms, warm %4 ms, %5 requests, %6 connections, %7 concurrent, "
+                     "%8 matches, %9 KiB sent, %10 errors")
+                .arg(scenario.m_name).arg(paragraphs.size()).arg(cold).arg(warm).arg(stats.m_requests)
+                .arg(stats.m_connections).arg(stats.m_maxConcurrentRequests).arg(stats.m_matches)
+                .arg(stats.m_bytesReceived / 1024).arg(stats.m_errors).toStdString());
+    }
+    WARN(InspectionMetrics::instance().report().toStdString());
+}
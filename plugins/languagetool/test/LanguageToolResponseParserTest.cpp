@@ -0,0 +1,159 @@
+/**********************************************************
+ * @file   LanguageToolResponseParserTest.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+
+#include <vector>
+#include <catch.hpp>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <LanguageToolResponseParser.h>
+#include "LanguageToolStubServer.h"
+
+using namespace novelist;
+
+namespace {
+    std::vector<LanguageToolMatch> parse(QByteArray const& response, int chunkSize, bool* complete = nullptr)
+    {
+        std::vector<LanguageToolMatch> matches;
+        LanguageToolResponseParser parser([&matches](LanguageToolMatch m) { matches.push_back(std::move(m)); });
+        for (int i = 0; i < response.size(); i += chunkSize)
+            parser.feed(response.mid(i, chunkSize));
+        if (complete != nullptr)
+            *complete = parser.finish();
+        return matches;
+    }
+}
+
+TEST_CASE("LanguageToolResponseParser matches DOM", "[LanguageTool]")
+{
+    QString const text = QStringLiteral("Der Drache schläft unter einem Berg aus Gold, während die Ritter streiten.");
+    QByteArray const response = LanguageToolStubServer::makeCheckResponse(text, "de-DE", 0.5, 7);
+    auto const expected = QJsonDocument::fromJson(response).object().value("matches").toArray();
+    REQUIRE(!expected.isEmpty());
+
+    for (int chunkSize : {1, 7, 64, response.size()}) {
+        bool complete = false;
+        auto matches = parse(response, chunkSize, &complete);
+        REQUIRE(complete);
+        REQUIRE(matches.size() == static_cast<size_t>(expected.size()));
+        for (int i = 0; i < expected.size(); ++i) {
+            auto const obj = expected[i].toObject();
+            auto const& match = matches[static_cast<size_t>(i)];
+            REQUIRE(match.m_offset == obj.value("offset").toInt());
+            REQUIRE(match.m_length == obj.value("length").toInt());
+            REQUIRE(match.m_message == obj.value("message").toString());
+            REQUIRE(match.m_shortMessage == obj.value("shortMessage").toString());
+            REQUIRE(match.m_context == obj.value("context").toObject().value("text").toString());
+            REQUIRE(match.m_replacements.size() == obj.value("replacements").toArray().size());
+            REQUIRE(match.m_replacements.front()
+                    == obj.value("replacements").toArray().first().toObject().value("value").toString());
+        }
+    }
+}
+
+TEST_CASE("LanguageToolResponseParser escapes and unknown fields", "[LanguageTool]")
+{
+    QByteArray const response = R"({"software": {"name": "LanguageTool", "premium": false, "status": ""},
+        "warnings": {"incompleteResults": false}, "note": "matches [{",
+        "matches": [
+            {"message": "Use \"quotes\" \u00e4\ud83d\ude00\n", "shortMessage": null, "offset": 3, "length": 2.0,
+             "replacements": [], "context": {"text": "a\/b\\c", "offset": 0, "length": 5},
+             "type": {"typeName": "Other"}, "ignoreForIncompleteSentence": true, "contextForSureMatch": -1,
+             "rule": {"id": "X", "subId": "1", "issueType": "whitespace",
+                      "urls": [{"value": "http://example.com"}],
+                      "category": {"id": "TYPOGRAPHY", "name": "Typography"}}}
+        ],
+        "sentenceRanges": [[0, 10]]})";
+
+    bool complete = false;
+    auto matches = parse(response, 5, &complete);
+    REQUIRE(complete);
+    REQUIRE(matches.size() == 1);
+    auto const& match = matches.front();
+    REQUIRE(match.m_message == QString::fromUtf8("Use \"quotes\" \xc3\xa4\xf0\x9f\x98\x80\n"));
+    REQUIRE(match.m_shortMessage.isEmpty());
+    REQUIRE(match.m_offset == 3);
+    REQUIRE(match.m_length == 2);
+    REQUIRE(match.m_replacements.isEmpty());
+    REQUIRE(match.m_context == "a/b\\c");
+    REQUIRE(match.m_category == LanguageToolCategory::Typography);
+}
+
+TEST_CASE("LanguageToolResponseParser keys and values", "[LanguageTool]")
+{
+    SECTION("Value named like the matches key") {
+        QByteArray const response = R"({"note": "matches", "sentenceRanges": [{"offset": 1, "length": 2}],
+            "matches": []})";
+        bool complete = false;
+        REQUIRE(parse(response, 3, &complete).empty());
+        REQUIRE(complete);
+    }
+
+    SECTION("Value in front of an array") {
+        QByteArray const response = R"({"note": "matches" [{"offset": 1, "length": 2}]})";
+        REQUIRE(parse(response, 3).empty());
+    }
+
+    SECTION("Matches after other arrays") {
+        QByteArray const response = R"({"sentenceRanges": [[0, 10]], "note": "sentenceRanges",
+            "matches": [{"offset": 1, "length": 2}]})";
+        bool complete = false;
+        auto matches = parse(response, 3, &complete);
+        REQUIRE(complete);
+        REQUIRE(matches.size() == 1);
+        REQUIRE(matches.front().m_offset == 1);
+    }
+}
+
+TEST_CASE("LanguageToolResponseParser malformed responses", "[LanguageTool]")
+{
+    QByteArray const valid = LanguageToolStubServer::makeCheckResponse("Hello world", "en-US", 1, 0);
+    bool complete = true;
+
+    SECTION("Truncated") {
+        parse(valid.left(valid.size() - 1), 3, &complete);
+        REQUIRE(!complete);
+    }
+
+    SECTION("Trailing garbage") {
+        parse(valid + "x", 3, &complete);
+        REQUIRE(!complete);
+    }
+
+    SECTION("Mismatched brackets") {
+        parse(R"({"matches": [{"offset": 1]]})", 3, &complete);
+        REQUIRE(!complete);
+    }
+
+    SECTION("Invalid match") {
+        auto matches = parse(R"({"matches": [{"offset" 1}]})", 3, &complete);
+        REQUIRE(matches.empty());
+        REQUIRE(!complete);
+    }
+
+    SECTION("Not an object") {
+        parse("[]", 3, &complete);
+        REQUIRE(!complete);
+    }
+}
+
+TEST_CASE("LanguageToolResponseParser categories", "[LanguageTool]")
+{
+    REQUIRE(LanguageToolResponseParser::classify("grammar", "") == LanguageToolCategory::Grammar);
+    REQUIRE(LanguageToolResponseParser::classify("", "GRAMMAR") == LanguageToolCategory::Grammar);
+    REQUIRE(LanguageToolResponseParser::classify("", "GRAMMATICAL") == LanguageToolCategory::Grammar);
+    REQUIRE(LanguageToolResponseParser::classify("typographical", "PUNCTUATION") == LanguageToolCategory::Typography);
+    REQUIRE(LanguageToolResponseParser::classify("whitespace", "TYPOGRAPHY") == LanguageToolCategory::Typography);
+    REQUIRE(LanguageToolResponseParser::classify("misspelling", "TYPOS") == LanguageToolCategory::Spelling);
+    REQUIRE(LanguageToolResponseParser::classify("", "") == LanguageToolCategory::Spelling);
+
+    // Matches don't span both fields
+    REQUIRE(LanguageToolResponseParser::classify("gram", "MAR") == LanguageToolCategory::Spelling);
+    REQUIRE(LanguageToolResponseParser::classify("typo", "GRAPHY") == LanguageToolCategory::Spelling);
+}
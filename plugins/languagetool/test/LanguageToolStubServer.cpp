@@ -0,0 +1,340 @@
+/**********************************************************
+ * @file   LanguageToolStubServer.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#include <algorithm>
+#include <array>
+#include <QtCore/QDebug>
+#include <QtCore/QHash>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QPointer>
+#include <QtCore/QTimer>
+#include <QtCore/QUrlQuery>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+#include "LanguageToolStubServer.h"
+
+namespace novelist {
+    namespace {
+        QByteArray makeHttpResponse(int status, QByteArray const& reason, QByteArray const& contentType,
+                QByteArray const& body)
+        {
+            return "HTTP/1.1 " + QByteArray::number(status) + " " + reason + "\r\n"
+                    + "Content-Type: " + contentType + "\r\n"
+                    + "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+                    + "Connection: keep-alive\r\n\r\n"
+                    + body;
+        }
+
+        /**
+         * Scrambles the bits of a hash, so similar inputs give unrelated results
+         */
+        uint32_t mixBits(uint32_t h) noexcept
+        {
+            h ^= h >> 16;
+            h *= 0x85ebca6bu;
+            h ^= h >> 13;
+            h *= 0xc2b2ae35u;
+            h ^= h >> 16;
+            return h;
+        }
+    }
+
+    namespace internal {
+        LanguageToolStubWorker::LanguageToolStubWorker(LanguageToolStubConfig config) noexcept
+                :m_config(config),
+                 m_rng(config.m_seed)
+        {
+        }
+
+        LanguageToolStubWorker::~LanguageToolStubWorker() noexcept
+        {
+            // Sockets are deleted along with the server, they must not call back into the already destroyed worker
+            for (auto& entry : m_connections)
+                entry.first->disconnect(this);
+        }
+
+        void LanguageToolStubWorker::setConfig(LanguageToolStubConfig config)
+        {
+            QMutexLocker lock(&m_configMutex);
+            m_config = config;
+        }
+
+        LanguageToolStubStats LanguageToolStubWorker::stats() const noexcept
+        {
+            LanguageToolStubStats stats;
+            stats.m_connections = m_connectionCount.load();
+            stats.m_requests = m_requests.load();
+            stats.m_errors = m_errors.load();
+            stats.m_matches = m_matches.load();
+            stats.m_bytesReceived = m_bytesReceived.load();
+            stats.m_maxConcurrentRequests = m_maxConcurrentRequests.load();
+            return stats;
+        }
+
+        void LanguageToolStubWorker::resetStats() noexcept
+        {
+            m_connectionCount = 0;
+            m_requests = 0;
+            m_errors = 0;
+            m_matches = 0;
+            m_bytesReceived = 0;
+            m_maxConcurrentRequests = 0;
+        }
+
+        uint16_t LanguageToolStubWorker::port() const noexcept
+        {
+            return m_port.load();
+        }
+
+        void LanguageToolStubWorker::listen()
+        {
+            // Created here, so it belongs to the server thread
+            m_server = new QTcpServer(this);
+            connect(m_server, &QTcpServer::newConnection, this, &LanguageToolStubWorker::onNewConnection);
+            if (m_server->listen(QHostAddress::LocalHost))
+                m_port = m_server->serverPort();
+            else
+                qWarning() << "LanguageTool stub server failed to listen." << m_server->errorString();
+        }
+
+        void LanguageToolStubWorker::onNewConnection()
+        {
+            while (m_server->hasPendingConnections()) {
+                QTcpSocket* socket = m_server->nextPendingConnection();
+                ++m_connectionCount;
+                m_connections.emplace(socket, Connection{});
+                connect(socket, &QTcpSocket::readyRead, this, [this, socket] { processConnection(socket); });
+                connect(socket, &QTcpSocket::disconnected, this, [this, socket] {
+                    m_connections.erase(socket);
+                    socket->deleteLater();
+                });
+            }
+        }
+
+        void LanguageToolStubWorker::processConnection(QTcpSocket* socket)
+        {
+            auto iter = m_connections.find(socket);
+            if (iter == m_connections.end())
+                return;
+
+            // Like the real server, requests on the same connection are answered one after another
+            auto& connection = iter->second;
+            if (connection.m_busy)
+                return;
+            connection.m_buffer += socket->readAll();
+
+            int const headerEnd = connection.m_buffer.indexOf("\r\n\r\n");
+            if (headerEnd < 0)
+                return;
+            QList<QByteArray> lines = connection.m_buffer.left(headerEnd).split('\n');
+            QList<QByteArray> requestLine = lines.front().trimmed().split(' ');
+            if (requestLine.size() < 2) {
+                socket->disconnectFromHost();
+                return;
+            }
+            int contentLength = 0;
+            bool close = false;
+            for (auto line = lines.begin() + 1; line != lines.end(); ++line) {
+                int const colon = line->indexOf(':');
+                QByteArray const name = line->left(colon).trimmed().toLower();
+                QByteArray const value = line->mid(colon + 1).trimmed().toLower();
+                if (name == "content-length")
+                    contentLength = value.toInt();
+                else if (name == "connection")
+                    close = (value == "close");
+            }
+            int const requestSize = headerEnd + 4 + contentLength;
+            if (connection.m_buffer.size() < requestSize)
+                return;
+            QByteArray const body = connection.m_buffer.mid(headerEnd + 4, contentLength);
+            connection.m_buffer.remove(0, requestSize);
+            connection.m_busy = true;
+
+            LanguageToolStubConfig config;
+            {
+                QMutexLocker lock(&m_configMutex);
+                config = m_config;
+            }
+            QByteArray const path = requestLine[1].left(requestLine[1].indexOf('?'));
+            QByteArray response = respond(requestLine[0], path, body, config);
+            int delay = config.m_latency;
+            if (config.m_latencyJitter > 0)
+                delay += std::uniform_int_distribution<int>(0, config.m_latencyJitter)(m_rng);
+
+            int const concurrent = ++m_concurrentRequests;
+            int maxConcurrent = m_maxConcurrentRequests.load();
+            while (concurrent > maxConcurrent && !m_maxConcurrentRequests.compare_exchange_weak(maxConcurrent,
+                    concurrent)) {
+            }
+
+            // Waiting in a timer instead of sleeping lets other connections go on in the meantime
+            QPointer<QTcpSocket> guard(socket);
+            QTimer::singleShot(delay, this, [this, guard, response = std::move(response), close] {
+                --m_concurrentRequests;
+                if (!guard)
+                    return;
+                guard->write(response);
+                auto iter = m_connections.find(guard.data());
+                if (iter != m_connections.end())
+                    iter->second.m_busy = false;
+                if (close)
+                    guard->disconnectFromHost();
+                else
+                    processConnection(guard.data()); // Pipelined requests might already be waiting
+            });
+        }
+
+        QByteArray LanguageToolStubWorker::respond(QByteArray const& method, QByteArray const& path,
+                QByteArray const& body, LanguageToolStubConfig const& config)
+        {
+            ++m_requests;
+            m_bytesReceived += static_cast<uint64_t>(body.size());
+
+            if (method != "POST" || path != "/v2/check") {
+                ++m_errors;
+                return makeHttpResponse(404, "Not Found", "text/plain", "Not found: " + path);
+            }
+            if (std::uniform_real_distribution<double>(0, 1)(m_rng) < config.m_errorRate) {
+                ++m_errors;
+                return makeHttpResponse(500, "Internal Server Error", "text/plain", "Error: Stub server failure");
+            }
+
+            // Spaces might be encoded as '+', literal plus signs never are
+            QUrlQuery query(QString::fromUtf8(body).replace('+', "%20"));
+            if (!query.hasQueryItem("text") || !query.hasQueryItem("language")) {
+                ++m_errors;
+                return makeHttpResponse(400, "Bad Request", "text/plain",
+                        "Error: Missing 'text' or 'language' parameter");
+            }
+
+            int matchCount = 0;
+            QByteArray json = LanguageToolStubServer::makeCheckResponse(
+                    query.queryItemValue("text", QUrl::FullyDecoded),
+                    query.queryItemValue("language", QUrl::FullyDecoded), config.m_matchDensity, config.m_seed,
+                    &matchCount);
+            m_matches += static_cast<uint64_t>(matchCount);
+            return makeHttpResponse(200, "OK", "application/json", json);
+        }
+    }
+
+    LanguageToolStubServer::LanguageToolStubServer(LanguageToolStubConfig config)
+            :m_worker(new internal::LanguageToolStubWorker(config))
+    {
+        m_worker->moveToThread(&m_thread);
+        QObject::connect(&m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+        m_thread.setObjectName("LanguageTool stub server");
+        m_thread.start();
+        QMetaObject::invokeMethod(m_worker, "listen", Qt::BlockingQueuedConnection);
+    }
+
+    LanguageToolStubServer::~LanguageToolStubServer() noexcept
+    {
+        m_thread.quit();
+        m_thread.wait();
+    }
+
+    QString LanguageToolStubServer::url() const
+    {
+        return "http://127.0.0.1:" + QString::number(m_worker->port());
+    }
+
+    void LanguageToolStubServer::setConfig(LanguageToolStubConfig config)
+    {
+        m_worker->setConfig(config);
+    }
+
+    LanguageToolStubStats LanguageToolStubServer::stats() const noexcept
+    {
+        return m_worker->stats();
+    }
+
+    void LanguageToolStubServer::resetStats() noexcept
+    {
+        m_worker->resetStats();
+    }
+
+    QByteArray LanguageToolStubServer::makeCheckResponse(QString const& text, QString const& language,
+            double matchDensity, unsigned int seed, int* matchCount)
+    {
+        struct Category {
+            char const* m_issueType;
+            char const* m_id;
+            char const* m_name;
+        };
+        // Every kind of insight the plugin knows shows up
+        static std::array<Category, 3> const categories{{
+                {"misspelling", "TYPOS", "Possible Typo"},
+                {"grammar", "GRAMMAR", "Grammar"},
+                {"typographical", "TYPOGRAPHY", "Typography"}
+        }};
+
+        // Decisions only depend on a word's paragraph and its offset within it, so batching paragraphs into one
+        // request doesn't change their matches
+        QJsonArray matches;
+        int paragraphStart = 0;
+        while (paragraphStart <= text.size()) {
+            int paragraphEnd = text.indexOf(QStringLiteral("\n\n"), paragraphStart);
+            if (paragraphEnd < 0)
+                paragraphEnd = text.size();
+            auto const paragraphHash = static_cast<uint32_t>(
+                    qHash(text.midRef(paragraphStart, paragraphEnd - paragraphStart), seed));
+
+            for (int i = paragraphStart; i < paragraphEnd;) {
+                if (!text[i].isLetterOrNumber()) {
+                    ++i;
+                    continue;
+                }
+                int const start = i;
+                while (i < paragraphEnd && text[i].isLetterOrNumber())
+                    ++i;
+                auto const offset = static_cast<uint32_t>(start - paragraphStart);
+                uint32_t const hash = mixBits(paragraphHash + offset * 0x9e3779b9u);
+                if (hash / 4294967296.0 >= matchDensity)
+                    continue;
+
+                QString const word = text.mid(start, i - start);
+                int const contextStart = std::max(paragraphStart, start - 20);
+                int const contextEnd = std::min(paragraphEnd, i + 20);
+                auto const& category = categories[mixBits(hash) % categories.size()];
+                QJsonObject rule{
+                        {"id", QString("STUB_%1_RULE").arg(category.m_id)},
+                        {"description", "Stub rule"},
+                        {"issueType", category.m_issueType},
+                        {"category", QJsonObject{{"id", category.m_id}, {"name", category.m_name}}}
+                };
+                QJsonObject context{
+                        {"text", text.mid(contextStart, contextEnd - contextStart)},
+                        {"offset", start - contextStart},
+                        {"length", i - start}
+                };
+                matches.append(QJsonObject{
+                        {"message", QString("Possible problem with \"%1\".").arg(word)},
+                        {"shortMessage", category.m_name},
+                        {"offset", start},
+                        {"length", i - start},
+                        {"replacements", QJsonArray{QJsonObject{{"value", word.toUpper()}}}},
+                        {"context", context},
+                        {"rule", rule}
+                });
+            }
+            paragraphStart = paragraphEnd + 2;
+        }
+
+        if (matchCount != nullptr)
+            *matchCount = matches.size();
+
+        QJsonObject root{
+                {"software", QJsonObject{{"name", "LanguageTool stub"}, {"version", "0.0"}, {"apiVersion", 1}}},
+                {"language", QJsonObject{{"name", language}, {"code", language}}},
+                {"matches", matches}
+        };
+        return QJsonDocument(root).toJson(QJsonDocument::Compact);
+    }
+}
@@ -0,0 +1,183 @@
+/**********************************************************
+ * @file   LanguageToolStubServer.h
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#ifndef NOVELIST_LANGUAGETOOLSTUBSERVER_H
+#define NOVELIST_LANGUAGETOOLSTUBSERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <QtCore/QByteArray>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QThread>
+
+class QTcpServer;
+class QTcpSocket;
+
+namespace novelist {
+    /**
+     * Behavior of a LanguageToolStubServer
+     */
+    struct LanguageToolStubConfig {
+        int m_latency = 0; //!< Time in milliseconds before each response is sent
+        int m_latencyJitter = 0; //!< Maximum additional random time in milliseconds before each response is sent
+        double m_errorRate = 0; //!< Fraction of requests that are answered with an internal server error
+        double m_matchDensity = 0.1; //!< Fraction of words that are reported as match
+        unsigned int m_seed = 0; //!< Seed of all random decisions
+    };
+
+    /**
+     * Counters of a LanguageToolStubServer
+     */
+    struct LanguageToolStubStats {
+        uint64_t m_connections = 0; //!< Accepted connections
+        uint64_t m_requests = 0; //!< Received requests, including failed ones
+        uint64_t m_errors = 0; //!< Requests that were answered with an error
+        uint64_t m_matches = 0; //!< Matches that were sent
+        uint64_t m_bytesReceived = 0; //!< Size of all request bodies
+        int m_maxConcurrentRequests = 0; //!< Highest amount of requests that waited for their response at once
+    };
+
+    namespace internal {
+        /**
+         * Lives on the server thread and owns the listening socket and all connections
+         */
+        class LanguageToolStubWorker : public QObject {
+        Q_OBJECT
+
+        public:
+            explicit LanguageToolStubWorker(LanguageToolStubConfig config) noexcept;
+
+            ~LanguageToolStubWorker() noexcept override;
+
+            /**
+             * Thread-safe.
+             * @param config New behavior, used for all requests that arrive from now on
+             */
+            void setConfig(LanguageToolStubConfig config);
+
+            /**
+             * Thread-safe.
+             * @return Current counters
+             */
+            LanguageToolStubStats stats() const noexcept;
+
+            /**
+             * Resets all counters. Thread-safe.
+             */
+            void resetStats() noexcept;
+
+            /**
+             * Thread-safe.
+             * @return Port the server listens on, or 0 if it isn't listening yet
+             */
+            uint16_t port() const noexcept;
+
+        public slots:
+
+            void listen();
+
+        private:
+            struct Connection {
+                QByteArray m_buffer;
+                bool m_busy = false;
+            };
+
+            mutable QMutex m_configMutex;
+            LanguageToolStubConfig m_config;
+            std::mt19937 m_rng;
+            QTcpServer* m_server = nullptr;
+            std::map<QTcpSocket*, Connection> m_connections;
+            std::atomic<uint16_t> m_port{0};
+            std::atomic<uint64_t> m_connectionCount{0};
+            std::atomic<uint64_t> m_requests{0};
+            std::atomic<uint64_t> m_errors{0};
+            std::atomic<uint64_t> m_matches{0};
+            std::atomic<uint64_t> m_bytesReceived{0};
+            std::atomic<int> m_concurrentRequests{0};
+            std::atomic<int> m_maxConcurrentRequests{0};
+
+            void onNewConnection();
+
+            void processConnection(QTcpSocket* socket);
+
+            QByteArray respond(QByteArray const& method, QByteArray const& path, QByteArray const& body,
+                    LanguageToolStubConfig const& config);
+        };
+    }
+
+    /**
+     * In-process stand-in for a LanguageTool server. It implements the JSON contract of /v2/check, but reports
+     * random words as matches instead of actually checking the text. Latency, error rate and match density are
+     * configurable, so the LanguageTool plugin can be tested and benchmarked reproducibly without network access.
+     *
+     * The server runs on its own thread and keeps connections alive, just like the real one. Matches only depend on
+     * the seed and the paragraph they are in, so a paragraph always yields the same matches, no matter in which order
+     * or batch it is sent.
+     */
+    class LanguageToolStubServer {
+    public:
+        /**
+         * Starts listening on a random local port
+         * @param config Behavior of the server
+         */
+        explicit LanguageToolStubServer(LanguageToolStubConfig config = {});
+
+        /**
+         * Stops the server. Open connections are closed.
+         */
+        ~LanguageToolStubServer() noexcept;
+
+        LanguageToolStubServer(LanguageToolStubServer const&) = delete;
+
+        LanguageToolStubServer& operator=(LanguageToolStubServer const&) = delete;
+
+        /**
+         * @return Base url of the server, as expected by the "languagetool/url" setting
+         */
+        QString url() const;
+
+        /**
+         * Thread-safe.
+         * @param config New behavior, used for all requests that arrive from now on
+         */
+        void setConfig(LanguageToolStubConfig config);
+
+        /**
+         * Thread-safe.
+         * @return Current counters
+         */
+        LanguageToolStubStats stats() const noexcept;
+
+        /**
+         * Resets all counters. Thread-safe.
+         */
+        void resetStats() noexcept;
+
+        /**
+         * Creates the body of a /v2/check response
+         * @param text Checked text. Paragraphs separated by an empty line are checked independently of each other.
+         * @param language Language code of the text, as sent by the client
+         * @param matchDensity Fraction of words that are reported as match
+         * @param seed Seed of the random decisions
+         * @param matchCount If not nullptr, receives the amount of matches
+         * @return JSON document as described by the LanguageTool HTTP API
+         */
+        static QByteArray makeCheckResponse(QString const& text, QString const& language, double matchDensity,
+                unsigned int seed, int* matchCount = nullptr);
+
+    private:
+        QThread m_thread;
+        internal::LanguageToolStubWorker* m_worker;
+    };
+}
+
+#endif //NOVELIST_LANGUAGETOOLSTUBSERVER_H
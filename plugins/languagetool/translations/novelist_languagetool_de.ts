@@ -4,7 +4,7 @@
 <context>
     <name>QObject</name>
     <message>
-        <location filename="../src/novelist/LanguageToolInspector.cpp" line="86"/>
+        <location filename="../src/novelist/LanguageToolInspector.cpp" line="220"/>
         <source>No suggestions available.
 </source>
         <comment>LanguageToolInspector</comment>
@@ -12,13 +12,13 @@
 </translation>
     </message>
     <message>
-        <location filename="../src/novelist/LanguageToolInspector.cpp" line="88"/>
+        <location filename="../src/novelist/LanguageToolInspector.cpp" line="222"/>
         <source>Suggestions: </source>
         <comment>LanguageToolInspector</comment>
         <translation>Vorschläge: </translation>
     </message>
     <message>
-        <location filename="../src/novelist/LanguageToolInspector.cpp" line="95"/>
+        <location filename="../src/novelist/LanguageToolInspector.cpp" line="226"/>
         <source>In this context: </source>
         <comment>LanguageToolInspector</comment>
         <translation>In diesem Zusammenhang: </translation>
@@ -51,6 +51,16 @@
         <source>Ignore rules</source>
         <translation>Regeln ignorieren</translation>
     </message>
+    <message>
+        <location filename="../src/novelist/SettingsPage_LanguageTool.ui" line="56"/>
+        <source>Several paragraphs are checked with a single request up to this many characters. 0 checks every paragraph on its own.</source>
+        <translation>Mehrere Absätze werden mit einer einzigen Anfrage bis zu so vielen Zeichen geprüft. 0 prüft jeden Absatz einzeln.</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/SettingsPage_LanguageTool.ui" line="59"/>
+        <source>Characters per request</source>
+        <translation>Zeichen pro Anfrage</translation>
+    </message>
     <message>
         <location filename="../src/novelist/SettingsPage_LanguageTool.ui" line="59"/>
         <source>Start LT automatically</source>
@@ -4,20 +4,20 @@
 <context>
     <name>QObject</name>
     <message>
-        <location filename="../src/novelist/LanguageToolInspector.cpp" line="86"/>
+        <location filename="../src/novelist/LanguageToolInspector.cpp" line="220"/>
         <source>No suggestions available.
 </source>
         <comment>LanguageToolInspector</comment>
         <translation></translation>
     </message>
     <message>
-        <location filename="../src/novelist/LanguageToolInspector.cpp" line="88"/>
+        <location filename="../src/novelist/LanguageToolInspector.cpp" line="222"/>
         <source>Suggestions: </source>
         <comment>LanguageToolInspector</comment>
         <translation></translation>
     </message>
     <message>
-        <location filename="../src/novelist/LanguageToolInspector.cpp" line="95"/>
+        <location filename="../src/novelist/LanguageToolInspector.cpp" line="226"/>
         <source>In this context: </source>
         <comment>LanguageToolInspector</comment>
         <translation></translation>
@@ -50,6 +50,16 @@
         <source>Ignore rules</source>
         <translation></translation>
     </message>
+    <message>
+        <location filename="../src/novelist/SettingsPage_LanguageTool.ui" line="56"/>
+        <source>Several paragraphs are checked with a single request up to this many characters. 0 checks every paragraph on its own.</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/SettingsPage_LanguageTool.ui" line="59"/>
+        <source>Characters per request</source>
+        <translation></translation>
+    </message>
     <message>
         <location filename="../src/novelist/SettingsPage_LanguageTool.ui" line="59"/>
         <source>Start LT automatically</source>
@@ -9,6 +9,7 @@
 
 #include <settings/SettingsPage_General.h>
 #include <settings/SettingsPage_Editor.h>
+#include <settings/SettingsPage_Diagnostics.h>
 #include <util/TranslationManager.h>
 #include <QtCore/QLibraryInfo>
 #include <QtWidgets/QMenuBar>
@@ -26,6 +27,7 @@ namespace novelist {
 
         settings->registerPage(std::make_unique<SettingsPage_General_Creator>());
         settings->registerPage(std::make_unique<SettingsPage_Editor_Creator>());
+        settings->registerPage(std::make_unique<SettingsPage_Diagnostics_Creator>());
 
         m_mainWindow = std::make_unique<MainWindow>();
 
@@ -0,0 +1,56 @@
+/**********************************************************
+ * @file   SpellCheckDictionary.h
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#ifndef NOVELIST_SPELLCHECKDICTIONARY_H
+#define NOVELIST_SPELLCHECKDICTIONARY_H
+
+#include <memory>
+#include <optional>
+#include <vector>
+#include <QtCore/QFile>
+#include <datastructures/Dawg.h>
+
+namespace novelist {
+    /**
+     * A word list loaded from a Hunspell-style .dic file. The list is compiled into a Dawg once and stored in the cache
+     * directory, later loads memory-map the compiled file instead of parsing the list again.
+     */
+    class SpellCheckDictionary {
+    public:
+        /**
+         * Loads a dictionary. Affix flags of the entries are ignored, so the list needs to contain all word forms.
+         * @param path Path to the .dic file
+         * @return The dictionary, or nullptr if it couldn't be read
+         */
+        static std::unique_ptr<SpellCheckDictionary> load(QString const& path) noexcept;
+
+        /**
+         * @details Dictionaries are usually installed to read-only locations, so compiled graphs are kept in the
+         *          cache. The path depends on the source's location and modification time, so an updated list is
+         *          compiled again.
+         * @param path Path to the .dic file
+         * @return Path of the compiled graph of a dictionary
+         */
+        static QString compiledPath(QString const& path);
+
+        /**
+         * @return All known words
+         */
+        Dawg const& words() const noexcept;
+
+    private:
+        std::unique_ptr<QFile> m_mapped; // Declared first, so the mapping outlives the graph
+        Dawg m_words;
+
+        SpellCheckDictionary(std::unique_ptr<QFile> mapped, Dawg words) noexcept;
+
+        static std::optional<std::vector<QString>> readWordList(QString const& path);
+    };
+}
+
+#endif //NOVELIST_SPELLCHECKDICTIONARY_H
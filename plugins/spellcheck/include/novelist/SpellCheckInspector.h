@@ -0,0 +1,67 @@
+/**********************************************************
+ * @file   SpellCheckInspector.h
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#ifndef NOVELIST_SPELLCHECKINSPECTOR_H
+#define NOVELIST_SPELLCHECKINSPECTOR_H
+
+#include <map>
+#include <memory>
+#include <QtCore/QMutex>
+#include <QtCore/QStringList>
+#include <widgets/texteditor/Inspector.h>
+#include "SpellCheckDictionary.h"
+
+namespace novelist {
+    /**
+     * Checks spelling against local word lists, one per language. Dictionaries are loaded on first use.
+     */
+    class SpellCheckInspector : public Inspector {
+    public:
+        /**
+         * Maximum amount of suggestions per unknown word
+         */
+        static constexpr size_t s_maxSuggestions = 5;
+
+        /**
+         * @param directories Directories that are searched for dictionaries, in order of preference
+         */
+        explicit SpellCheckInspector(QStringList directories = dictionaryDirectories());
+
+        InspectionBlockResult inspect(QString const& text, Language lang) const noexcept override;
+
+        QByteArray cacheKey() const noexcept override;
+
+        QString name() const noexcept override;
+
+        /**
+         * @return Directories that are searched for dictionaries, in order of preference
+         */
+        static QStringList dictionaryDirectories();
+
+        /**
+         * @param lang Language
+         * @return File names that are tried for a language, in order of preference
+         */
+        static QStringList dictionaryNames(Language lang);
+
+    private:
+        QStringList m_directories;
+        mutable QMutex m_mutex; // Guards the loaded dictionaries
+        mutable QMutex m_loadMutex; // Held while a dictionary is loaded, so every dictionary is only loaded once
+        mutable std::map<Language, std::shared_ptr<SpellCheckDictionary const>> m_dictionaries;
+        QByteArray m_cacheKey;
+
+        std::shared_ptr<SpellCheckDictionary const> dictionary(Language lang) const noexcept;
+
+        static bool isKnown(Dawg const& words, QString const& word) noexcept;
+
+        static QStringList suggest(Dawg const& words, QString const& word);
+    };
+}
+
+#endif //NOVELIST_SPELLCHECKINSPECTOR_H
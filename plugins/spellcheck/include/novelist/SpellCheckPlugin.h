@@ -0,0 +1,35 @@
+/**********************************************************
+ * @file   SpellCheckPlugin.h
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#ifndef NOVELIST_SPELLCHECKPLUGIN_H
+#define NOVELIST_SPELLCHECKPLUGIN_H
+
+#include <memory>
+#include <QtCore/QObject>
+#include <plugin/InspectionPlugin.h>
+
+namespace novelist
+{
+    /**
+     * Plugin that provides offline spell checking. Unlike LanguageTool integration, it doesn't need an external
+     * server, only a word list for each language.
+     */
+    class SpellCheckPlugin : public InspectionPlugin
+    {
+        Q_OBJECT
+        Q_PLUGIN_METADATA(IID "novelist.SpellCheckPlugin" FILE "SpellCheckPlugin.json")
+
+    public:
+        bool load(gsl::not_null<Settings*> settings) override;
+
+    protected:
+        std::unique_ptr<Inspector> createInspector() const noexcept override;
+    };
+}
+
+#endif //NOVELIST_SPELLCHECKPLUGIN_H
@@ -0,0 +1,126 @@
+/**********************************************************
+ * @file   SpellCheckDictionary.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QTextCodec>
+#include <QtCore/QTextStream>
+#include "SpellCheckDictionary.h"
+
+namespace novelist {
+    std::unique_ptr<SpellCheckDictionary> SpellCheckDictionary::load(QString const& path) noexcept
+    {
+        QString const compiled = compiledPath(path);
+        if (QFileInfo::exists(compiled)) {
+            auto file = std::make_unique<QFile>(compiled);
+            if (file->open(QIODevice::ReadOnly)) {
+                if (uchar* mem = file->map(0, file->size())) {
+                    auto data = QByteArray::fromRawData(reinterpret_cast<char const*>(mem),
+                            static_cast<int>(file->size()));
+                    if (auto words = Dawg::fromData(data))
+                        return std::unique_ptr<SpellCheckDictionary>(
+                                new SpellCheckDictionary(std::move(file), std::move(*words)));
+                }
+            }
+            qInfo() << "Compiled dictionary" << compiled << "is invalid and will be rebuilt.";
+        }
+
+        auto wordList = readWordList(path);
+        if (!wordList)
+            return nullptr;
+        auto words = Dawg::build(std::move(*wordList));
+
+        // If the cache can't be written, the list is simply compiled again next time
+        QSaveFile out(compiled);
+        if (!QDir().mkpath(QFileInfo(compiled).absolutePath()) || !out.open(QIODevice::WriteOnly)
+                || out.write(words.data()) != words.data().size() || !out.commit())
+            qInfo() << "Could not store compiled dictionary" << compiled;
+
+        return std::unique_ptr<SpellCheckDictionary>(new SpellCheckDictionary(nullptr, std::move(words)));
+    }
+
+    QString SpellCheckDictionary::compiledPath(QString const& path)
+    {
+        QFileInfo source(path);
+        QByteArray const key = source.absoluteFilePath().toUtf8() + ":"
+                + QByteArray::number(source.lastModified().toMSecsSinceEpoch());
+        return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/dictionaries/"
+                + source.completeBaseName() + "-" + QCryptographicHash::hash(key, QCryptographicHash::Md5).toHex()
+                + ".dawg";
+    }
+
+    Dawg const& SpellCheckDictionary::words() const noexcept
+    {
+        return m_words;
+    }
+
+    SpellCheckDictionary::SpellCheckDictionary(std::unique_ptr<QFile> mapped, Dawg words) noexcept
+            :m_mapped(std::move(mapped)),
+             m_words(std::move(words))
+    {
+    }
+
+    std::optional<std::vector<QString>> SpellCheckDictionary::readWordList(QString const& path)
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            qWarning() << "Could not open dictionary" << path;
+            return std::nullopt;
+        }
+
+        // The encoding is declared in the affix file next to the list, UTF-8 is assumed if there is none
+        QTextCodec* codec = QTextCodec::codecForName("UTF-8");
+        QFileInfo info(path);
+        QFile affixes(info.absolutePath() + "/" + info.completeBaseName() + ".aff");
+        if (affixes.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            while (!affixes.atEnd()) {
+                auto line = affixes.readLine().trimmed();
+                if (line.startsWith("SET ")) {
+                    if (auto* declared = QTextCodec::codecForName(line.mid(4).trimmed()))
+                        codec = declared;
+                    break;
+                }
+            }
+        }
+
+        QTextStream stream(&file);
+        stream.setCodec(codec);
+        std::vector<QString> words;
+        bool firstLine = true;
+        QString line;
+        while (stream.readLineInto(&line)) {
+            // Hunspell lists start with the amount of entries
+            bool isCount = false;
+            if (firstLine)
+                line.trimmed().toInt(&isCount);
+            firstLine = false;
+            if (isCount)
+                continue;
+
+            // Entries are "word/flags morphology", where slashes within the word are escaped
+            QString word;
+            for (int i = 0; i < line.size(); ++i) {
+                QChar const c = line[i];
+                if (c == '\\' && i + 1 < line.size() && line[i + 1] == '/')
+                    word += line[++i];
+                else if (c == '/' || c.isSpace())
+                    break;
+                else
+                    word += c;
+            }
+            if (!word.isEmpty() && !word.startsWith('#'))
+                words.push_back(std::move(word));
+        }
+        return words;
+    }
+}
@@ -0,0 +1,205 @@
+/**********************************************************
+ * @file   SpellCheckInspector.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#include <algorithm>
+#include <optional>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QStandardPaths>
+#include <QtWidgets/QApplication>
+#include <document/SpellingInsight.h>
+#include "SpellCheckInspector.h"
+
+namespace novelist {
+    namespace {
+        constexpr QChar s_apostrophe = QLatin1Char('\'');
+        constexpr QChar s_typographicApostrophe = QChar(0x2019);
+
+        bool isApostrophe(QChar c) noexcept
+        {
+            return c == s_apostrophe || c == s_typographicApostrophe;
+        }
+
+        bool isAllUpper(QString const& word) noexcept
+        {
+            return std::none_of(word.begin(), word.end(), [](QChar c) { return c.isLower(); });
+        }
+
+        QString capitalize(QString word)
+        {
+            if (!word.isEmpty())
+                word[0] = word[0].toUpper();
+            return word;
+        }
+    }
+
+    SpellCheckInspector::SpellCheckInspector(QStringList directories)
+            :m_directories(std::move(directories))
+    {
+        // Installing or updating a dictionary must invalidate cached results
+        m_cacheKey = "spellcheck/1";
+        for (auto const& dir : m_directories) {
+            for (auto const& entry : QDir(dir).entryInfoList({"*.dic"}, QDir::Files, QDir::Name))
+                m_cacheKey += "|" + entry.fileName().toUtf8() + ":" + QByteArray::number(entry.size()) + ":"
+                        + QByteArray::number(entry.lastModified().toMSecsSinceEpoch());
+        }
+    }
+
+    InspectionBlockResult SpellCheckInspector::inspect(QString const& text, Language lang) const noexcept
+    {
+        InspectionBlockResult result;
+        auto dict = dictionary(lang);
+        if (!dict)
+            return result;
+
+        // Words are runs of letters, possibly with apostrophes in between, e.g. "don't". Hyphenated words are
+        // checked part by part.
+        int const size = text.size();
+        int i = 0;
+        while (i < size) {
+            if (!text[i].isLetter()) {
+                ++i;
+                continue;
+            }
+
+            int const left = i;
+            bool hasDigits = left > 0 && text[left - 1].isDigit();
+            while (i < size && (text[i].isLetterOrNumber() || text[i].isMark()
+                    || (isApostrophe(text[i]) && i + 1 < size && text[i + 1].isLetter()))) {
+                hasDigits |= text[i].isDigit();
+                ++i;
+            }
+            int const right = i;
+
+            // Numbers like "3rd", single letters and mixed case words like "iPhone" are no regular words
+            QString word = text.mid(left, right - left);
+            if (hasDigits || word.size() < 2 || (!isAllUpper(word.mid(1)) && std::any_of(word.begin() + 1,
+                    word.end(), [](QChar c) { return c.isUpper(); })))
+                continue;
+
+            word.replace(s_typographicApostrophe, s_apostrophe);
+            if (isKnown(dict->words(), word))
+                continue;
+
+            auto suggestions = suggest(dict->words(), word);
+            if (text.midRef(left, right - left).contains(s_typographicApostrophe))
+                suggestions.replaceInStrings(QString(s_apostrophe), QString(s_typographicApostrophe));
+
+            QString msg = QObject::tr("Possible spelling mistake found.\n", "SpellCheckInspector");
+            if (suggestions.isEmpty())
+                msg += QObject::tr("No suggestions available.\n", "SpellCheckInspector");
+            else
+                msg += QObject::tr("Suggestions: ", "SpellCheckInspector") + suggestions.join(", ") + "\n";
+
+            InspectionInsight insight;
+            insight.m_factory = std::make_shared<AutoInsightFactory<SpellingInsight>>(msg, suggestions);
+            insight.m_left = left;
+            insight.m_right = right;
+            result.push_back(std::move(insight));
+        }
+        return result;
+    }
+
+    QByteArray SpellCheckInspector::cacheKey() const noexcept
+    {
+        return m_cacheKey;
+    }
+
+    QString SpellCheckInspector::name() const noexcept
+    {
+        return "Spell check";
+    }
+
+    QStringList SpellCheckInspector::dictionaryDirectories()
+    {
+        return {
+                QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/dictionaries",
+                QApplication::applicationDirPath() + "/plugins/spellcheck/dictionaries",
+        };
+    }
+
+    QStringList SpellCheckInspector::dictionaryNames(Language lang)
+    {
+        QString const langCode = lang::languageCode(lang);
+        QString const countryCode = lang::countryCode(lang);
+        QStringList names{langCode + "_" + countryCode + ".dic"};
+        // Hunspell dictionaries use the ISO country code
+        if (lang == Language::en_UK)
+            names << langCode + "_GB.dic";
+        names << langCode + ".dic";
+        return names;
+    }
+
+    std::shared_ptr<SpellCheckDictionary const> SpellCheckInspector::dictionary(Language lang) const noexcept
+    {
+        auto lookup = [this, lang]() -> std::optional<std::shared_ptr<SpellCheckDictionary const>> {
+            QMutexLocker lock(&m_mutex);
+            if (auto iter = m_dictionaries.find(lang); iter != m_dictionaries.end())
+                return iter->second;
+            return std::nullopt;
+        };
+        if (auto dict = lookup())
+            return *dict;
+
+        // Compiling a word list takes a while, lookups of dictionaries that are already loaded shouldn't wait for it
+        QMutexLocker loadLock(&m_loadMutex);
+        if (auto dict = lookup())
+            return *dict;
+
+        auto load = [this, lang]() -> std::shared_ptr<SpellCheckDictionary const> {
+            for (auto const& dir : m_directories) {
+                for (auto const& name : dictionaryNames(lang)) {
+                    QFileInfo info(dir + "/" + name);
+                    if (info.exists()) {
+                        if (auto dict = SpellCheckDictionary::load(info.absoluteFilePath()))
+                            return dict;
+                    }
+                }
+            }
+            return nullptr;
+        };
+
+        // Missing dictionaries are remembered as well, so they aren't searched for again and again
+        auto dict = load();
+        QMutexLocker lock(&m_mutex);
+        m_dictionaries[lang] = dict;
+        return dict;
+    }
+
+    bool SpellCheckInspector::isKnown(Dawg const& words, QString const& word) noexcept
+    {
+        if (words.contains(word))
+            return true;
+
+        // Words at the start of a sentence are capitalized, headings are sometimes all caps
+        if (word[0].isUpper() && words.contains(word.toLower()))
+            return true;
+        return isAllUpper(word) && words.contains(capitalize(word.toLower()));
+    }
+
+    QStringList SpellCheckInspector::suggest(Dawg const& words, QString const& word)
+    {
+        // Short words have so many neighbours that larger distances only produce noise
+        int const maxDistance = word.size() <= 4 ? 1 : 2;
+
+        QStringList suggestions;
+        for (auto const& [s, distance] : words.suggest(word, maxDistance, s_maxSuggestions))
+            suggestions << s;
+
+        // A capitalized word might be a regular word at the start of a sentence
+        if (word[0].isUpper() && static_cast<size_t>(suggestions.size()) < s_maxSuggestions) {
+            auto const lower = word.toLower();
+            for (auto const& [s, distance] : words.suggest(lower, maxDistance, s_maxSuggestions)) {
+                auto const capitalized = isAllUpper(word) ? s.toUpper() : capitalize(s);
+                if (!suggestions.contains(capitalized) && static_cast<size_t>(suggestions.size()) < s_maxSuggestions)
+                    suggestions << capitalized;
+            }
+        }
+        return suggestions;
+    }
+}
@@ -0,0 +1,31 @@
+/**********************************************************
+ * @file   SpellCheckPlugin.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+
+#include <util/TranslationManager.h>
+#include "SpellCheckInspector.h"
+#include "SpellCheckPlugin.h"
+
+namespace novelist
+{
+    bool SpellCheckPlugin::load(gsl::not_null<Settings*> settings)
+    {
+        if (!BasePlugin::load(settings))
+            return false;
+
+        auto langDir = QDir(QApplication::applicationDirPath() + "/plugins/spellcheck");
+        TranslationManager::instance().registerInDirectory(langDir, "novelist_spellcheck");
+
+        return InspectionPlugin::load(settings);
+    }
+
+    std::unique_ptr<Inspector> SpellCheckPlugin::createInspector() const noexcept
+    {
+        return std::make_unique<SpellCheckInspector>();
+    }
+}
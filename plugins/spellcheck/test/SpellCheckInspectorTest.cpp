@@ -0,0 +1,119 @@
+/**********************************************************
+ * @file   SpellCheckInspectorTest.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+
+#include <vector>
+#include <catch.hpp>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <SpellCheckInspector.h>
+
+using namespace novelist;
+
+namespace {
+    QString const dictionaryDir = NOVELIST_TEST_DICTIONARIES;
+
+    struct Finding {
+        int m_left;
+        int m_right;
+        QStringList m_suggestions;
+
+        bool operator==(Finding const& other) const noexcept
+        {
+            return m_left == other.m_left && m_right == other.m_right && m_suggestions == other.m_suggestions;
+        }
+    };
+
+    std::vector<Finding> inspect(QString const& text, Language lang = Language::en_UK)
+    {
+        static SpellCheckInspector const inspector(QStringList{dictionaryDir});
+        std::vector<Finding> findings;
+        for (auto const& insight : inspector.inspect(text, lang))
+            findings.push_back({insight.m_left, insight.m_right, insight.m_factory->describe().m_suggestions});
+        return findings;
+    }
+}
+
+TEST_CASE("SpellCheckInspector words", "[SpellCheck]")
+{
+    SECTION("Apostrophes") {
+        REQUIRE(inspect("don't worry").empty());
+        REQUIRE(inspect("don’t worry").empty());
+        REQUIRE(inspect("'well'").empty());
+        REQUIRE(inspect("Dont worry") == std::vector<Finding>{{0, 4, {"Don't"}}});
+        REQUIRE(inspect("don’tt") == std::vector<Finding>{{0, 6, {"don’t"}}});
+    }
+
+    SECTION("Digits") {
+        REQUIRE(inspect("3rd house, 2nd house").empty());
+        REQUIRE(inspect("4x4, B52").empty());
+    }
+
+    SECTION("Mixed case") {
+        REQUIRE(inspect("iPhone, McDonald").empty());
+    }
+
+    SECTION("Hyphens") {
+        REQUIRE(inspect("well-known").empty());
+        REQUIRE(inspect("well-knwon") == std::vector<Finding>{{5, 10, {"known"}}});
+    }
+
+    SECTION("Single letters") {
+        REQUIRE(inspect("a house").empty());
+    }
+
+    SECTION("Encoding declared by the affix file") {
+        REQUIRE(inspect("naïve").empty());
+        REQUIRE(inspect("naive") == std::vector<Finding>{{0, 5, {"naïve"}}});
+    }
+}
+
+TEST_CASE("SpellCheckInspector capitalization", "[SpellCheck]")
+{
+    SECTION("Known words") {
+        REQUIRE(inspect("house houses").empty());
+        REQUIRE(inspect("House").empty());
+        REQUIRE(inspect("HOUSE").empty());
+        REQUIRE(inspect("Paris").empty());
+        REQUIRE(inspect("PARIS").empty());
+        REQUIRE(inspect("NAÏVE COLOUR").empty());
+        REQUIRE(inspect("paris") == std::vector<Finding>{{0, 5, {"Paris"}}});
+    }
+
+    SECTION("Suggestions") {
+        REQUIRE(inspect("hose") == std::vector<Finding>{{0, 4, {"house"}}});
+        REQUIRE(inspect("Hose") == std::vector<Finding>{{0, 4, {"House"}}});
+        REQUIRE(inspect("HOSE") == std::vector<Finding>{{0, 4, {"HOUSE"}}});
+    }
+}
+
+TEST_CASE("SpellCheckInspector dictionaries", "[SpellCheck]")
+{
+    SECTION("Names") {
+        REQUIRE(SpellCheckInspector::dictionaryNames(Language::en_UK)
+                == QStringList{"en_UK.dic", "en_GB.dic", "en.dic"});
+        REQUIRE(SpellCheckInspector::dictionaryNames(Language::en_US) == QStringList{"en_US.dic", "en.dic"});
+        REQUIRE(SpellCheckInspector::dictionaryNames(Language::de_DE) == QStringList{"de_DE.dic", "de.dic"});
+    }
+
+    SECTION("British English falls back to en_GB") {
+        REQUIRE(inspect("hose", Language::en_UK).size() == 1u);
+        REQUIRE(inspect("hose", Language::en_US).empty());
+    }
+
+    SECTION("Compiled graphs are stored in the cache") {
+        REQUIRE(!inspect("hose").empty());
+        REQUIRE(QFileInfo::exists(SpellCheckDictionary::compiledPath(dictionaryDir + "/en_GB.dic")));
+        REQUIRE(QDir(dictionaryDir).entryList({"*.dawg"}).isEmpty());
+
+        auto dict = SpellCheckDictionary::load(dictionaryDir + "/en_GB.dic");
+        REQUIRE(dict);
+        REQUIRE(dict->words().wordCount() == 9u);
+        REQUIRE(dict->words().contains("naïve"));
+    }
+}
@@ -0,0 +1,26 @@
+/**********************************************************
+ * @file   main.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+#include <QtCore/QStandardPaths>
+#include <test/TestApplication.h>
+
+using namespace novelist;
+
+int main(int argc, char** argv)
+{
+    TestApplication app(argc, argv);
+    // Compiled dictionaries must not end up in the user's cache
+    QStandardPaths::setTestModeEnabled(true);
+
+    int result = Catch::Session().run( argc, argv );
+
+    return ( result < 0xff ? result : 0xff );
+}
\ No newline at end of file
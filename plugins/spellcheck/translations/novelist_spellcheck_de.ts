@@ -0,0 +1,29 @@
+<?xml version="1.0" encoding="utf-8"?>
+<!DOCTYPE TS>
+<TS version="2.1" language="de_DE">
+<context>
+    <name>QObject</name>
+    <message>
+        <location filename="../src/novelist/SpellCheckInspector.cpp" line="93"/>
+        <source>Possible spelling mistake found.
+</source>
+        <comment>SpellCheckInspector</comment>
+        <translation>Möglicher Rechtschreibfehler gefunden.
+</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/SpellCheckInspector.cpp" line="95"/>
+        <source>No suggestions available.
+</source>
+        <comment>SpellCheckInspector</comment>
+        <translation>Keine Vorschläge verfügbar.
+</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/SpellCheckInspector.cpp" line="97"/>
+        <source>Suggestions: </source>
+        <comment>SpellCheckInspector</comment>
+        <translation>Vorschläge: </translation>
+    </message>
+</context>
+</TS>
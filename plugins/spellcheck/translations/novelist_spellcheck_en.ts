@@ -0,0 +1,27 @@
+<?xml version="1.0" encoding="utf-8"?>
+<!DOCTYPE TS>
+<TS version="2.1" language="en_US">
+<context>
+    <name>QObject</name>
+    <message>
+        <location filename="../src/novelist/SpellCheckInspector.cpp" line="93"/>
+        <source>Possible spelling mistake found.
+</source>
+        <comment>SpellCheckInspector</comment>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/SpellCheckInspector.cpp" line="95"/>
+        <source>No suggestions available.
+</source>
+        <comment>SpellCheckInspector</comment>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/SpellCheckInspector.cpp" line="97"/>
+        <source>Suggestions: </source>
+        <comment>SpellCheckInspector</comment>
+        <translation></translation>
+    </message>
+</context>
+</TS>
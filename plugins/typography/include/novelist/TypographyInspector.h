@@ -0,0 +1,62 @@
+/**********************************************************
+ * @file   TypographyInspector.h
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#ifndef NOVELIST_TYPOGRAPHYINSPECTOR_H
+#define NOVELIST_TYPOGRAPHYINSPECTOR_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+#include <QtCore/QMutex>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QStringList>
+#include <widgets/texteditor/Inspector.h>
+
+namespace novelist {
+    /**
+     * Finds typographic issues like straight quotation marks, hyphens used as dashes or missing spaces after
+     * punctuation. All rules of a language are combined into a single regular expression, so every block is scanned
+     * only once.
+     */
+    class TypographyInspector : public Inspector {
+    public:
+        InspectionBlockResult inspect(QString const& text, Language lang) const noexcept override;
+
+        QByteArray cacheKey() const noexcept override;
+
+        QString name() const noexcept override;
+
+    private:
+        /**
+         * A single typography rule
+         */
+        struct Rule {
+            char const* m_message; // Untranslated message, translated in the context "TypographyInspector"
+            QString m_pattern; // Regular expression without capturing groups
+            std::function<QStringList(QString const& text, int left, int right)> m_suggest;
+        };
+
+        /**
+         * All rules of a language, combined into one expression with one capturing group per rule
+         */
+        struct RuleSet {
+            std::vector<Rule> m_rules;
+            QRegularExpression m_expression;
+        };
+
+        mutable QMutex m_mutex;
+        mutable std::map<Language, std::shared_ptr<RuleSet const>> m_ruleSets;
+
+        std::shared_ptr<RuleSet const> ruleSet(Language lang) const noexcept;
+
+        static std::vector<Rule> makeRules(Language lang);
+    };
+}
+
+#endif //NOVELIST_TYPOGRAPHYINSPECTOR_H
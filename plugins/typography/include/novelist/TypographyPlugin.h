@@ -0,0 +1,35 @@
+/**********************************************************
+ * @file   TypographyPlugin.h
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#ifndef NOVELIST_TYPOGRAPHYPLUGIN_H
+#define NOVELIST_TYPOGRAPHYPLUGIN_H
+
+#include <memory>
+#include <QtCore/QObject>
+#include <plugin/InspectionPlugin.h>
+
+namespace novelist
+{
+    /**
+     * Plugin that provides typography checks, e.g. for straight quotation marks, dashes and spacing around
+     * punctuation.
+     */
+    class TypographyPlugin : public InspectionPlugin
+    {
+        Q_OBJECT
+        Q_PLUGIN_METADATA(IID "novelist.TypographyPlugin" FILE "TypographyPlugin.json")
+
+    public:
+        bool load(gsl::not_null<Settings*> settings) override;
+
+    protected:
+        std::unique_ptr<Inspector> createInspector() const noexcept override;
+    };
+}
+
+#endif //NOVELIST_TYPOGRAPHYPLUGIN_H
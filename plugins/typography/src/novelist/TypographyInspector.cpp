@@ -0,0 +1,188 @@
+/**********************************************************
+ * @file   TypographyInspector.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+#include <string>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+#include <document/TypographyInsight.h>
+#include "TypographyInspector.h"
+
+namespace novelist {
+    namespace {
+        /**
+         * Quotation marks used by a language
+         */
+        struct QuoteStyle {
+            QString m_primaryOpen;
+            QString m_primaryClose;
+            QString m_secondaryOpen;
+            QString m_secondaryClose;
+            QString m_foreign; // Quotation marks that don't belong into texts of this language
+            QString m_foreignOpening; // Quotation marks that don't belong into texts of this language as opening marks
+        };
+
+        QuoteStyle quoteStyle(Language lang)
+        {
+            switch (lang) {
+                case Language::de_DE:
+                case Language::de_AT:
+                    // »Guillemets« pointing inwards are common in German books as well, only «Swiss style» is wrong
+                    return {"„", "“", "‚", "‘", "”", "«"};
+                case Language::de_CH:
+                    return {"«", "»", "‹", "›", "„“”", ""};
+                case Language::en_UK:
+                case Language::en_US:
+                case Language::en_AU:
+                    return {"“", "”", "‘", "’", "„«»", ""};
+            }
+            throw language_error("Unknown language " + std::to_string(static_cast<int>(lang)));
+        }
+
+        /**
+         * @return true if a quotation mark at [left, right) opens a quote, otherwise false
+         */
+        bool isOpening(QString const& text, int left, int right) noexcept
+        {
+            static QString const openers = "([{„‚—–-/";
+            bool const spaceBefore = left == 0 || text[left - 1].isSpace() || openers.contains(text[left - 1]);
+            bool const spaceAfter = right >= text.size() || text[right].isSpace();
+            return spaceBefore && !spaceAfter;
+        }
+
+        auto fixed(QStringList suggestions)
+        {
+            return [suggestions = std::move(suggestions)](QString const&, int, int) { return suggestions; };
+        }
+    }
+
+    InspectionBlockResult TypographyInspector::inspect(QString const& text, Language lang) const noexcept
+    {
+        InspectionBlockResult result;
+        auto rules = ruleSet(lang);
+        if (!rules)
+            return result;
+
+        auto iter = rules->m_expression.globalMatch(text);
+        while (iter.hasNext()) {
+            auto match = iter.next();
+            // Rules don't have capturing groups of their own, so the only captured group identifies the rule
+            int const group = match.lastCapturedIndex();
+            if (group < 1 || group > static_cast<int>(rules->m_rules.size()))
+                continue;
+
+            auto const& rule = rules->m_rules[group - 1];
+            int const left = match.capturedStart(group);
+            int const right = match.capturedEnd(group);
+            InspectionInsight insight;
+            insight.m_factory = std::make_shared<AutoInsightFactory<TypographyInsight>>(
+                    QCoreApplication::translate("TypographyInspector", rule.m_message),
+                    rule.m_suggest(text, left, right));
+            insight.m_left = left;
+            insight.m_right = right;
+            result.push_back(std::move(insight));
+        }
+        return result;
+    }
+
+    QByteArray TypographyInspector::cacheKey() const noexcept
+    {
+        // Must be bumped whenever rules change
+        return "typography/2";
+    }
+
+    QString TypographyInspector::name() const noexcept
+    {
+        return "Typography";
+    }
+
+    std::shared_ptr<TypographyInspector::RuleSet const> TypographyInspector::ruleSet(Language lang) const noexcept
+    {
+        QMutexLocker lock(&m_mutex);
+        if (auto iter = m_ruleSets.find(lang); iter != m_ruleSets.end())
+            return iter->second;
+
+        auto ruleSet = std::make_shared<RuleSet>();
+        ruleSet->m_rules = makeRules(lang);
+        QStringList alternatives;
+        for (auto const& rule : ruleSet->m_rules)
+            alternatives << "(" + rule.m_pattern + ")";
+        ruleSet->m_expression = QRegularExpression(alternatives.join('|'),
+                QRegularExpression::UseUnicodePropertiesOption);
+        if (!ruleSet->m_expression.isValid()) {
+            qWarning() << "Invalid typography rules:" << ruleSet->m_expression.errorString();
+            ruleSet = nullptr;
+        }
+        else
+            ruleSet->m_expression.optimize();
+
+        m_ruleSets[lang] = ruleSet;
+        return ruleSet;
+    }
+
+    std::vector<TypographyInspector::Rule> TypographyInspector::makeRules(Language lang)
+    {
+        QuoteStyle const quotes = quoteStyle(lang);
+        auto quote = [quotes](QString const& text, int left, int right) {
+            if (isOpening(text, left, right))
+                return QStringList{quotes.m_primaryOpen};
+            return QStringList{quotes.m_primaryClose};
+        };
+        auto singleQuote = [quotes](QString const& text, int left, int right) {
+            // Within a word and in front of numbers like '90s it's an apostrophe. At the end of a word it might also
+            // close a quote.
+            bool const letterBefore = left > 0 && text[left - 1].isLetter();
+            bool const letterAfter = right < text.size() && text[right].isLetter();
+            if ((letterBefore && letterAfter) || (right < text.size() && text[right].isDigit()))
+                return QStringList{"’"};
+            if (letterBefore && quotes.m_secondaryClose != "’")
+                return QStringList{quotes.m_secondaryClose, "’"};
+            if (letterBefore)
+                return QStringList{"’"};
+            if (isOpening(text, left, right))
+                return QStringList{quotes.m_secondaryOpen};
+            return QStringList{quotes.m_secondaryClose};
+        };
+        QStringList const dashes = lang == Language::en_US ? QStringList{"—", " – "} : QStringList{" – "};
+        QStringList foreignQuotes;
+        if (!quotes.m_foreign.isEmpty())
+            foreignQuotes << "[" + QRegularExpression::escape(quotes.m_foreign) + "]";
+        if (!quotes.m_foreignOpening.isEmpty())
+            foreignQuotes << R"((?<![^\s(\[{„‚—–/-])[)" + QRegularExpression::escape(quotes.m_foreignOpening)
+                    + R"(](?=\S))";
+
+        // Earlier rules take precedence if several rules match at the same position
+        return {
+                {QT_TRANSLATE_NOOP("TypographyInspector", "Whitespace at the end of the paragraph."),
+                        R"([ \t\x{00A0}]+$)", fixed({""})},
+                {QT_TRANSLATE_NOOP("TypographyInspector", "Multiple consecutive spaces."),
+                        R"([ \x{00A0}]{2,})", fixed({" "})},
+                {QT_TRANSLATE_NOOP("TypographyInspector", "Space before punctuation."),
+                        R"((?<=\S) +(?=[,;:!?]|\.(?!\.)))", fixed({""})},
+                {QT_TRANSLATE_NOOP("TypographyInspector", "Missing space after punctuation."),
+                        R"([,;](?=\p{L}))", [](QString const& text, int left, int right) {
+                    return QStringList{text.mid(left, right - left) + " "};
+                }},
+                {QT_TRANSLATE_NOOP("TypographyInspector", "Use an ellipsis character instead of three dots."),
+                        R"((?<!\.)\.{3}(?!\.))", fixed({"…"})},
+                {QT_TRANSLATE_NOOP("TypographyInspector", "Use a dash instead of a hyphen."),
+                        R"( -{1,2} |(?<=\p{L})--(?=\p{L}))", fixed(dashes)},
+                {QT_TRANSLATE_NOOP("TypographyInspector", "Use typographic quotation marks."),
+                        R"(")", quote},
+                {QT_TRANSLATE_NOOP("TypographyInspector", "Use typographic quotation marks or apostrophes."),
+                        R"(')", singleQuote},
+                {QT_TRANSLATE_NOOP("TypographyInspector", "Use an apostrophe instead of an accent."),
+                        R"((?<=\p{L})[´`](?=\p{L}))", fixed({"’"})},
+                {QT_TRANSLATE_NOOP("TypographyInspector", "Quotation marks don't match the text language."),
+                        foreignQuotes.join('|'), quote},
+                {QT_TRANSLATE_NOOP("TypographyInspector", "Repeated punctuation."),
+                        R"(!{2,}|\?{2,})", [](QString const& text, int left, int) {
+                    return QStringList{text.mid(left, 1)};
+                }},
+        };
+    }
+}
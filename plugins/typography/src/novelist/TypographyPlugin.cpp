@@ -0,0 +1,31 @@
+/**********************************************************
+ * @file   TypographyPlugin.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+
+#include <util/TranslationManager.h>
+#include "TypographyInspector.h"
+#include "TypographyPlugin.h"
+
+namespace novelist
+{
+    bool TypographyPlugin::load(gsl::not_null<Settings*> settings)
+    {
+        if (!BasePlugin::load(settings))
+            return false;
+
+        auto langDir = QDir(QApplication::applicationDirPath() + "/plugins/typography");
+        TranslationManager::instance().registerInDirectory(langDir, "novelist_typography");
+
+        return InspectionPlugin::load(settings);
+    }
+
+    std::unique_ptr<Inspector> TypographyPlugin::createInspector() const noexcept
+    {
+        return std::make_unique<TypographyInspector>();
+    }
+}
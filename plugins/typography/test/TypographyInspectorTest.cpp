@@ -0,0 +1,193 @@
+/**********************************************************
+ * @file   TypographyInspectorTest.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+
+#include <vector>
+#include <catch.hpp>
+#include <TypographyInspector.h>
+
+using namespace novelist;
+
+namespace {
+    struct Finding {
+        int m_left;
+        int m_right;
+        QStringList m_suggestions;
+
+        bool operator==(Finding const& other) const noexcept
+        {
+            return m_left == other.m_left && m_right == other.m_right && m_suggestions == other.m_suggestions;
+        }
+    };
+
+    std::vector<Finding> inspect(QString const& text, Language lang)
+    {
+        TypographyInspector inspector;
+        std::vector<Finding> findings;
+        for (auto const& insight : inspector.inspect(text, lang))
+            findings.push_back({insight.m_left, insight.m_right, insight.m_factory->describe().m_suggestions});
+        return findings;
+    }
+
+    std::vector<Language> const languages{Language::de_DE, Language::de_AT, Language::de_CH, Language::en_UK,
+                                          Language::en_US, Language::en_AU};
+
+    bool isGerman(Language lang)
+    {
+        return lang == Language::de_DE || lang == Language::de_AT;
+    }
+}
+
+TEST_CASE("TypographyInspector spaces", "[Typography]")
+{
+    SECTION("Whitespace at the end of the paragraph") {
+        for (Language lang : languages) {
+            INFO(lang::identifier(lang).toStdString());
+            REQUIRE(inspect("The end. \t", lang) == std::vector<Finding>{{8, 10, {""}}});
+            REQUIRE(inspect("The end.", lang).empty());
+        }
+    }
+
+    SECTION("Multiple consecutive spaces") {
+        for (Language lang : languages) {
+            INFO(lang::identifier(lang).toStdString());
+            REQUIRE(inspect("Two  spaces", lang) == std::vector<Finding>{{3, 5, {" "}}});
+            REQUIRE(inspect("No\u00A0 break", lang) == std::vector<Finding>{{2, 4, {" "}}});
+        }
+    }
+
+    SECTION("Space before punctuation") {
+        for (Language lang : languages) {
+            INFO(lang::identifier(lang).toStdString());
+            REQUIRE(inspect("Well , then !", lang) == std::vector<Finding>{{4, 5, {""}}, {11, 12, {""}}});
+            REQUIRE(inspect("Stop .", lang) == std::vector<Finding>{{4, 5, {""}}});
+        }
+    }
+
+    SECTION("Missing space after punctuation") {
+        for (Language lang : languages) {
+            INFO(lang::identifier(lang).toStdString());
+            REQUIRE(inspect("One,two;three", lang) == std::vector<Finding>{{3, 4, {", "}}, {7, 8, {"; "}}});
+            REQUIRE(inspect("1,5 and 2;3", lang).empty());
+        }
+    }
+}
+
+TEST_CASE("TypographyInspector punctuation", "[Typography]")
+{
+    SECTION("Ellipsis") {
+        for (Language lang : languages) {
+            INFO(lang::identifier(lang).toStdString());
+            REQUIRE(inspect("Wait... what", lang) == std::vector<Finding>{{4, 7, {"…"}}});
+            REQUIRE(inspect("Wait .... what", lang).empty());
+            REQUIRE(inspect("Wait… what", lang).empty());
+        }
+    }
+
+    SECTION("Dashes") {
+        for (Language lang : languages) {
+            INFO(lang::identifier(lang).toStdString());
+            QStringList const dashes = lang == Language::en_US ? QStringList{"—", " – "} : QStringList{" – "};
+            REQUIRE(inspect("This - that", lang) == std::vector<Finding>{{4, 7, dashes}});
+            REQUIRE(inspect("This -- that", lang) == std::vector<Finding>{{4, 8, dashes}});
+            REQUIRE(inspect("This--that", lang) == std::vector<Finding>{{4, 6, dashes}});
+            REQUIRE(inspect("A well-known fact", lang).empty());
+        }
+    }
+
+    SECTION("Repeated punctuation") {
+        for (Language lang : languages) {
+            INFO(lang::identifier(lang).toStdString());
+            REQUIRE(inspect("What?? No!!!", lang) == std::vector<Finding>{{4, 6, {"?"}}, {9, 12, {"!"}}});
+            REQUIRE(inspect("What?! No!", lang).empty());
+        }
+    }
+}
+
+TEST_CASE("TypographyInspector quotation marks", "[Typography]")
+{
+    SECTION("Double quotes") {
+        for (Language lang : languages) {
+            INFO(lang::identifier(lang).toStdString());
+            QString open = "“";
+            QString close = "”";
+            if (isGerman(lang)) {
+                open = "„";
+                close = "“";
+            }
+            else if (lang == Language::de_CH) {
+                open = "«";
+                close = "»";
+            }
+            REQUIRE(inspect("He said \"yes\" and left.", lang)
+                    == std::vector<Finding>{{8, 9, {open}}, {12, 13, {close}}});
+            REQUIRE(inspect("(\"Yes.\")", lang) == std::vector<Finding>{{1, 2, {open}}, {6, 7, {close}}});
+        }
+    }
+
+    SECTION("Single quotes") {
+        for (Language lang : languages) {
+            INFO(lang::identifier(lang).toStdString());
+            QString open = "‘";
+            QString close = "’";
+            if (isGerman(lang)) {
+                open = "‚";
+                close = "‘";
+            }
+            else if (lang == Language::de_CH) {
+                open = "‹";
+                close = "›";
+            }
+            REQUIRE(inspect("'Yes!'", lang) == std::vector<Finding>{{0, 1, {open}}, {5, 6, {close}}});
+            QStringList const afterWord = close == "’" ? QStringList{"’"} : QStringList{close, "’"};
+            REQUIRE(inspect("'Yes'", lang) == std::vector<Finding>{{0, 1, {open}}, {4, 5, afterWord}});
+        }
+    }
+
+    SECTION("Apostrophes") {
+        for (Language lang : languages) {
+            INFO(lang::identifier(lang).toStdString());
+            REQUIRE(inspect("It's", lang) == std::vector<Finding>{{2, 3, {"’"}}});
+            REQUIRE(inspect("The '90s", lang) == std::vector<Finding>{{4, 5, {"’"}}});
+            REQUIRE(inspect("It´s", lang) == std::vector<Finding>{{2, 3, {"’"}}});
+            REQUIRE(inspect("It`s", lang) == std::vector<Finding>{{2, 3, {"’"}}});
+            REQUIRE(inspect("It’s", lang).empty());
+        }
+    }
+}
+
+TEST_CASE("TypographyInspector foreign quotation marks", "[Typography]")
+{
+    SECTION("German") {
+        for (Language lang : {Language::de_DE, Language::de_AT}) {
+            INFO(lang::identifier(lang).toStdString());
+            REQUIRE(inspect("Er sagte „ja“.", lang).empty());
+            REQUIRE(inspect("Er sagte »ja«, dann »nein«.", lang).empty());
+            REQUIRE(inspect("Er sagte ”ja”.", lang) == std::vector<Finding>{{9, 10, {"„"}}, {12, 13, {"“"}}});
+            REQUIRE(inspect("Er sagte «ja».", lang) == std::vector<Finding>{{9, 10, {"„"}}});
+        }
+    }
+
+    SECTION("Swiss German") {
+        REQUIRE(inspect("Er sagte «ja».", Language::de_CH).empty());
+        REQUIRE(inspect("Er sagte „ja“.", Language::de_CH)
+                == std::vector<Finding>{{9, 10, {"«"}}, {12, 13, {"»"}}});
+        REQUIRE(inspect("Er sagte ”ja”.", Language::de_CH)
+                == std::vector<Finding>{{9, 10, {"«"}}, {12, 13, {"»"}}});
+    }
+
+    SECTION("English") {
+        for (Language lang : {Language::en_UK, Language::en_US, Language::en_AU}) {
+            INFO(lang::identifier(lang).toStdString());
+            REQUIRE(inspect("He said “yes”.", lang).empty());
+            REQUIRE(inspect("He said „yes“.", lang) == std::vector<Finding>{{8, 9, {"“"}}});
+            REQUIRE(inspect("He said «yes».", lang) == std::vector<Finding>{{8, 9, {"“"}}, {12, 13, {"”"}}});
+            REQUIRE(inspect("He said »yes«.", lang) == std::vector<Finding>{{8, 9, {"“"}}, {12, 13, {"”"}}});
+        }
+    }
+}
@@ -0,0 +1,23 @@
+/**********************************************************
+ * @file   main.cpp
+ * @author jan
+ * @date   10/19/26
+ * ********************************************************
+ * @brief
+ * @details
+ **********************************************************/
+
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+#include <test/TestApplication.h>
+
+using namespace novelist;
+
+int main(int argc, char** argv)
+{
+    TestApplication app(argc, argv);
+
+    int result = Catch::Session().run( argc, argv );
+
+    return ( result < 0xff ? result : 0xff );
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+<?xml version="1.0" encoding="utf-8"?>
+<!DOCTYPE TS>
+<TS version="2.1" language="de_DE">
+<context>
+    <name>TypographyInspector</name>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="160"/>
+        <source>Whitespace at the end of the paragraph.</source>
+        <translation>Leerraum am Ende des Absatzes.</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="162"/>
+        <source>Multiple consecutive spaces.</source>
+        <translation>Mehrere aufeinanderfolgende Leerzeichen.</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="164"/>
+        <source>Space before punctuation.</source>
+        <translation>Leerzeichen vor Satzzeichen.</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="166"/>
+        <source>Missing space after punctuation.</source>
+        <translation>Fehlendes Leerzeichen nach Satzzeichen.</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="170"/>
+        <source>Use an ellipsis character instead of three dots.</source>
+        <translation>Auslassungszeichen statt drei Punkten verwenden.</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="172"/>
+        <source>Use a dash instead of a hyphen.</source>
+        <translation>Gedankenstrich statt Bindestrich verwenden.</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="174"/>
+        <source>Use typographic quotation marks.</source>
+        <translation>Typografische Anführungszeichen verwenden.</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="176"/>
+        <source>Use typographic quotation marks or apostrophes.</source>
+        <translation>Typografische Anführungszeichen oder Apostrophe verwenden.</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="178"/>
+        <source>Use an apostrophe instead of an accent.</source>
+        <translation>Apostroph statt Akzent verwenden.</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="180"/>
+        <source>Quotation marks don&apos;t match the text language.</source>
+        <translation>Anführungszeichen passen nicht zur Sprache des Textes.</translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="182"/>
+        <source>Repeated punctuation.</source>
+        <translation>Wiederholte Satzzeichen.</translation>
+    </message>
+</context>
+</TS>
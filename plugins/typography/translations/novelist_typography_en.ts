@@ -0,0 +1,62 @@
+<?xml version="1.0" encoding="utf-8"?>
+<!DOCTYPE TS>
+<TS version="2.1" language="en_US">
+<context>
+    <name>TypographyInspector</name>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="160"/>
+        <source>Whitespace at the end of the paragraph.</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="162"/>
+        <source>Multiple consecutive spaces.</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="164"/>
+        <source>Space before punctuation.</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="166"/>
+        <source>Missing space after punctuation.</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="170"/>
+        <source>Use an ellipsis character instead of three dots.</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="172"/>
+        <source>Use a dash instead of a hyphen.</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="174"/>
+        <source>Use typographic quotation marks.</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="176"/>
+        <source>Use typographic quotation marks or apostrophes.</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="178"/>
+        <source>Use an apostrophe instead of an accent.</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="180"/>
+        <source>Quotation marks don&apos;t match the text language.</source>
+        <translation></translation>
+    </message>
+    <message>
+        <location filename="../src/novelist/TypographyInspector.cpp" line="182"/>
+        <source>Repeated punctuation.</source>
+        <translation></translation>
+    </message>
+</context>
+</TS>